@@ -0,0 +1,131 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(ALLOCATION_TRACKER_H)
+#define ALLOCATION_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FRAMEWORK_NO_ALLOCATION_SCOPE_CONCAT_IMPL(a, b) a##b
+#define FRAMEWORK_NO_ALLOCATION_SCOPE_CONCAT(a, b)      FRAMEWORK_NO_ALLOCATION_SCOPE_CONCAT_IMPL(a, b)
+
+/* Marks the rest of the enclosing scope as one which must not allocate on the calling thread. */
+#define FRAMEWORK_NO_ALLOCATION_SCOPE() Framework::NoAllocationScope FRAMEWORK_NO_ALLOCATION_SCOPE_CONCAT(no_allocation_scope_, __LINE__)
+
+namespace Framework
+{
+    struct AllocationStats
+    {
+        uint64_t n_allocated_bytes; /* As requested by callers. */
+        uint64_t n_allocations;
+        uint64_t n_no_allocation_scope_violations;
+
+        AllocationStats()
+            :n_allocated_bytes               (0),
+             n_allocations                   (0),
+             n_no_allocation_scope_violations(0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Heap allocation tracking, enabled by building with FRAMEWORK_ALLOCATION_TRACKING defined (see the
+     * FRAMEWORK_ENABLE_ALLOCATION_TRACKING CMake option).
+     *
+     * Global operator new & delete are replaced with versions which count allocations, and the framework routes
+     * ImGui's allocations through them as well. Allocations are accounted for:
+     *
+     * - per frame, via FrameCounter::ALLOCATED_BYTES and FrameCounter::N_ALLOCATIONS (see trace.h).
+     * - per trace zone, by comparing the recording thread's counts at the start & end of the zone.
+     *
+     * Direct malloc() calls and over-aligned allocations are not tracked.
+     *
+     * Regions of steady-state code (eg. parts of render_frame()) which are not expected to allocate can be marked
+     * with FRAMEWORK_NO_ALLOCATION_SCOPE(). Any allocation made by the marking thread within such a region is
+     * reported to stderr and trips an assertion. Scopes can be nested.
+     *
+     * When tracking is compiled out, all of the below are no-ops.
+     */
+    #if defined(FRAMEWORK_ALLOCATION_TRACKING)
+        void begin_no_allocation_scope();
+        void end_no_allocation_scope  ();
+
+        /* Returns totals accumulated over all threads since startup. */
+        AllocationStats get_allocation_stats();
+
+        /* Return totals accumulated by the calling thread since it was started. */
+        uint64_t get_thread_n_allocated_bytes();
+        uint64_t get_thread_n_allocations    ();
+
+        /* Used by the framework. Allocator functions compatible with ImGui::SetAllocatorFunctions(). */
+        void* tracked_malloc(size_t in_size,
+                             void*  in_user_data);
+        void  tracked_free  (void*  in_ptr,
+                             void*  in_user_data);
+    #else
+        inline void begin_no_allocation_scope()
+        {
+            /* Stub */
+        }
+
+        inline void end_no_allocation_scope()
+        {
+            /* Stub */
+        }
+
+        inline AllocationStats get_allocation_stats()
+        {
+            return AllocationStats();
+        }
+
+        inline uint64_t get_thread_n_allocated_bytes()
+        {
+            return 0;
+        }
+
+        inline uint64_t get_thread_n_allocations()
+        {
+            return 0;
+        }
+    #endif
+
+    class NoAllocationScope
+    {
+    public:
+        /* Public functions */
+        NoAllocationScope()
+        {
+            begin_no_allocation_scope();
+        }
+
+        ~NoAllocationScope()
+        {
+            end_no_allocation_scope();
+        }
+    };
+}
+
+#endif /* ALLOCATION_TRACKER_H */
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(COMMAND_BUFFER_H)
+#define COMMAND_BUFFER_H
+
+#include "framework.h"
+
+namespace Framework
+{
+    /* Forward decls */
+    class CommandBuffer;
+
+    /* Type defs */
+    typedef std::unique_ptr<CommandBuffer> CommandBufferUniquePtr;
+
+    enum class CommandType : uint16_t
+    {
+        BIND_PROGRAM,
+        BIND_SAMPLER,
+        BIND_TEXTURE,
+        BIND_VAO,
+        DRAW_ARRAYS,
+        DRAW_ELEMENTS,
+        SET_UNIFORM,
+
+        UNKNOWN
+    };
+
+    enum class UniformType : uint8_t
+    {
+        FLOAT,
+        FLOAT_VEC2,
+        FLOAT_VEC3,
+        FLOAT_VEC4,
+        FLOAT_MAT3,
+        FLOAT_MAT4,
+        INT,
+        INT_VEC2,
+        INT_VEC3,
+        INT_VEC4,
+        UINT,
+
+        UNKNOWN
+    };
+
+    /* Linear buffer of GL commands which can be recorded on any thread and played back on the thread which owns
+     * the GL context.
+     *
+     * Storage is allocated once at creation time. Each command is encoded as a 4-byte header followed by an inline,
+     * 4-byte aligned payload - including uniform values - so recording never allocates and never touches GL.
+     * Recording into a full buffer fails and flags the buffer as overflowed, in which case only commands recorded
+     * prior to the overflow are played back.
+     *
+     * A single CommandBuffer must only be recorded into by one thread at a time. To parallelize draw preparation,
+     * give each worker thread its own buffer and play them back in the desired order with execute().
+     */
+    class CommandBuffer
+    {
+    public:
+        /* Public functions */
+        static CommandBufferUniquePtr create(const uint32_t& in_capacity_bytes);
+
+        /* Plays back @param in_n_command_buffers command buffers in order. Must be called from the GL thread. */
+        static void execute(const CommandBuffer* const* in_command_buffer_ptrs,
+                            const uint32_t&             in_n_command_buffers);
+        void        execute() const;
+
+        uint32_t get_n_bytes_used() const
+        {
+            return m_n_bytes_used;
+        }
+
+        uint32_t get_n_commands() const
+        {
+            return m_n_commands;
+        }
+
+        bool has_overflowed() const
+        {
+            return m_has_overflowed;
+        }
+
+        bool record_bind_program(const GLuint&   in_program_id);
+        bool record_bind_sampler(const uint32_t& in_unit,
+                                 const GLuint&   in_sampler_id);
+        bool record_bind_texture(const uint32_t& in_unit,
+                                 const GLenum&   in_target,
+                                 const GLuint&   in_texture_id);
+        bool record_bind_vao    (const GLuint&   in_vao_id);
+
+        bool record_draw_arrays  (const GLenum&   in_mode,
+                                  const uint32_t& in_first,
+                                  const uint32_t& in_n_vertices,
+                                  const uint32_t& in_n_instances = 1);
+        bool record_draw_elements(const GLenum&   in_mode,
+                                  const GLenum&   in_index_type,
+                                  const uint32_t& in_first_index,
+                                  const uint32_t& in_n_indices,
+                                  const uint32_t& in_n_instances = 1);
+
+        /* Copies @param in_n_elements values of type @param in_type from @param in_data_ptr into the buffer. */
+        bool record_set_uniform(const GLint&       in_location,
+                                const UniformType& in_type,
+                                const uint32_t&    in_n_elements,
+                                const void*        in_data_ptr);
+
+        /* Discards all recorded commands. The buffer can be recorded into again afterward. */
+        void reset();
+
+        ~CommandBuffer();
+
+    private:
+        /* Private type defs */
+        struct CommandHeader
+        {
+            CommandType type;
+            uint16_t    n_payload_bytes;
+        };
+
+        /* Private functions */
+        CommandBuffer(const uint32_t& in_capacity_bytes);
+
+        bool record(const CommandType& in_type,
+                    const void*        in_payload_ptr,
+                    const uint32_t&    in_n_payload_bytes,
+                    const void*        in_opt_extra_payload_ptr     = nullptr,
+                    const uint32_t&    in_n_opt_extra_payload_bytes = 0);
+
+        static uint32_t get_uniform_type_size(const UniformType& in_type);
+
+        /* Private variables */
+        std::vector<uint8_t> m_data_u8_vec;
+        bool                 m_has_overflowed;
+        uint32_t             m_n_bytes_used;
+        uint32_t             m_n_commands;
+    };
+}
+
+#endif /* COMMAND_BUFFER_H */
\ No newline at end of file
@@ -0,0 +1,168 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(DRAW_BATCHER_H)
+#define DRAW_BATCHER_H
+
+#include "framework.h"
+#include "gpu_memory.h"
+#include "program.h"
+#include "texture.h"
+#include <array>
+
+namespace Framework
+{
+    /* Forward decls */
+    class DrawBatcher;
+
+    /* Type defs */
+    typedef std::unique_ptr<DrawBatcher> DrawBatcherUniquePtr;
+
+    /* Describes a single indexed draw submitted to a DrawBatcher. Draws which match on all fields
+     * (apart from per-instance data) are merged into a single glDrawElementsInstanced() call. */
+    struct BatchedDraw
+    {
+        static const uint32_t N_MAX_TEXTURES = 4;
+
+        uint32_t       first_index;
+        GLenum         index_type;
+        GLenum         mode;
+        uint32_t       n_indices;
+        const Program* program_ptr;
+        GLuint         vao_id;
+
+        /* Texture at index N is bound to texture unit N. Unused entries must be set to nullptr. */
+        std::array<const Texture*, N_MAX_TEXTURES> texture_ptrs;
+
+        BatchedDraw()
+            :first_index (0),
+             index_type  (GL_UNSIGNED_SHORT),
+             mode        (GL_TRIANGLES),
+             n_indices   (0),
+             program_ptr (nullptr),
+             vao_id      (0)
+        {
+            texture_ptrs.fill(nullptr);
+        }
+    };
+
+    struct DrawBatcherStats
+    {
+        uint32_t n_draw_calls_issued;
+        uint32_t n_draws_merged;
+        uint32_t n_draws_submitted;
+        uint32_t n_instance_bytes_uploaded;
+
+        DrawBatcherStats()
+            :n_draw_calls_issued      (0),
+             n_draws_merged           (0),
+             n_draws_submitted        (0),
+             n_instance_bytes_uploaded(0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Collects draws submitted over the course of a frame and emits them as instanced draw calls.
+     *
+     * Per-instance data of all draws is packed into a single streaming buffer which is uploaded with
+     * one glBufferSubData() call per flush(). It is exposed to shaders as consecutive vec4 attributes,
+     * starting at the location specified at creation time, with a divisor of 1. The batcher takes over
+     * these attribute locations in all VAOs used with it, so they must not be used for anything else.
+     * They are disabled, with their divisors reset to 0, before flush() releases a VAO.
+     *
+     * NOTE: Draws are reordered so that those sharing state end up next to each other. As such, the
+     *       batcher should not be used for geometry whose rendering results depend on submission
+     *       order (eg. blended geometry).
+     */
+    class DrawBatcher
+    {
+    public:
+        /* Public functions */
+        static DrawBatcherUniquePtr create(const uint32_t& in_instance_attribute_location,
+                                           const uint32_t& in_max_instance_data_bytes_per_frame);
+
+        ~DrawBatcher();
+
+        /* Issues all draws submitted since the last flush() call and resets the batcher. */
+        void flush();
+
+        /* Returns stats gathered by the most recent flush() call. */
+        const DrawBatcherStats& get_stats() const
+        {
+            return m_stats;
+        }
+
+        /* Queues a draw. Per-instance data is copied, so the caller may release it right after the call.
+         *
+         * @param in_instance_data_size must be a multiple of 16 (ie. size of a vec4) and must not be 0.
+         *
+         * Returns false if the per-frame instance data budget has been exceeded, in which case the draw is dropped.
+         */
+        bool submit(const BatchedDraw& in_draw,
+                    const void*        in_instance_data_ptr,
+                    const uint32_t&    in_instance_data_size);
+
+    private:
+        /* Private type defs */
+        struct SubmittedDraw
+        {
+            BatchedDraw draw;
+            uint32_t    instance_data_offset;
+            uint32_t    instance_data_size;
+        };
+
+        /* Private functions */
+        DrawBatcher(const uint32_t& in_instance_attribute_location,
+                    const uint32_t& in_max_instance_data_bytes_per_frame);
+
+        bool init();
+
+        static bool can_merge(const SubmittedDraw& in_draw1,
+                              const SubmittedDraw& in_draw2);
+        static bool is_less  (const SubmittedDraw& in_draw1,
+                              const SubmittedDraw& in_draw2);
+
+        /* Disables instanced attributes & resets their divisors to 0 in the currently bound VAO. */
+        void reset_instance_attributes(const uint32_t& in_n_first_attribute,
+                                       const uint32_t& in_n_attributes);
+
+        /* Private variables */
+        GPUMemoryAllocationID m_gpu_memory_id;
+        GLuint                m_instance_buffer_id;
+        DrawBatcherStats      m_stats;
+
+        std::vector<uint8_t>       m_instance_data_u8_vec;
+        uint32_t                   m_n_instance_data_bytes_used;
+        std::vector<SubmittedDraw> m_submitted_draw_vec;
+        std::vector<uint32_t>      m_submitted_draw_order_vec;
+        std::vector<uint8_t>       m_upload_data_u8_vec;
+
+        const uint32_t m_instance_attribute_location;
+        const uint32_t m_max_instance_data_bytes_per_frame;
+    };
+}
+
+#endif /* DRAW_BATCHER_H */
\ No newline at end of file
@@ -0,0 +1,121 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(FAKE_GL_H)
+#define FAKE_GL_H
+
+#include "framework.h"
+#include "gl_functions.h"
+#include <array>
+
+namespace Framework
+{
+    /* Type defs */
+    typedef std::array<uint32_t, static_cast<uint32_t>(GLFunctionID::COUNT)> GLCallCountArray; /* Indexed by GLFunctionID. */
+
+    struct FakeGLConfig
+    {
+        /* Number of uniforms reported for each program. Uniforms are named "uniform<index>" and are reported as vec4s. */
+        uint32_t n_active_uniforms_per_program;
+
+        /* If enabled, the ID of each call is also appended to the call log. See get_fake_gl_call_log(). */
+        bool record_call_log;
+
+        FakeGLConfig()
+            :n_active_uniforms_per_program(0),
+             record_call_log              (false)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Fake GL backend, which lets CPU-side framework & app code run without a GL context, eg. to measure its
+     * overhead or to exercise it in headless runs. Native builds only.
+     *
+     * install_fake_gl() points glad's entry-points for all functions listed in FRAMEWORK_GL_FUNCTIONS at fake
+     * implementations which count each call and otherwise do as little as possible:
+     *
+     * - glGen*() and glCreate*() return unique, non-zero IDs. glFenceSync() returns unique, non-null syncs.
+     * - Shaders always compile, programs always link, framebuffers are always complete, sync objects are always
+     *   signaled and query results are always available.
+     * - Active uniforms are reported as configured in FakeGLConfig. glGetUniformLocation() returns their indices.
+     * - All other queries return zeroes and glGetError() always returns GL_NO_ERROR.
+     *
+     * Functions which are not listed in FRAMEWORK_GL_FUNCTIONS are left untouched and must not be called unless
+     * a GL context exists. GL capture & instrumentation hooks installed on top of the fake backend keep on working.
+     *
+     * All functions, as well as the fake entry-points, must be called from a single thread.
+     */
+    #if !defined(__EMSCRIPTEN__)
+        /* Returns the number of calls made to each entry-point since the backend was installed or last reset. */
+        const GLCallCountArray& get_fake_gl_call_counts();
+
+        /* Returns IDs of all calls made since the backend was installed or last reset, in order. Only filled if
+         * FakeGLConfig::record_call_log is enabled. */
+        const std::vector<GLFunctionID>& get_fake_gl_call_log();
+
+        /* Saves current glad entry-points, so that they can be restored by uninstall_fake_gl(), then replaces them
+         * with the fake ones. @param in_config replaces the configuration used by any previous install, and call
+         * counts & the call log are reset, as by reset_fake_gl_calls(). */
+        void install_fake_gl(const FakeGLConfig& in_config = FakeGLConfig() );
+
+        /* Clears call counts & the call log. IDs of objects created so far stay reserved. */
+        void reset_fake_gl_calls();
+
+        /* Must be called after any hooks installed on top of the fake backend have been removed. */
+        void uninstall_fake_gl();
+    #else
+        inline const GLCallCountArray& get_fake_gl_call_counts()
+        {
+            static const GLCallCountArray empty_counts = {};
+
+            return empty_counts;
+        }
+
+        inline const std::vector<GLFunctionID>& get_fake_gl_call_log()
+        {
+            static const std::vector<GLFunctionID> empty_log;
+
+            return empty_log;
+        }
+
+        inline void install_fake_gl(const FakeGLConfig& in_config = FakeGLConfig() )
+        {
+            /* Stub */
+        }
+
+        inline void reset_fake_gl_calls()
+        {
+            /* Stub */
+        }
+
+        inline void uninstall_fake_gl()
+        {
+            /* Stub */
+        }
+    #endif
+}
+
+#endif /* FAKE_GL_H */
\ No newline at end of file
@@ -0,0 +1,135 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(FRAME_LATENCY_LIMITER_H)
+#define FRAME_LATENCY_LIMITER_H
+
+#include "framework.h"
+#include <chrono>
+
+namespace Framework
+{
+    /* Forward decls */
+    class FrameLatencyLimiter;
+
+    /* Type defs */
+    typedef std::unique_ptr<FrameLatencyLimiter> FrameLatencyLimiterUniquePtr;
+
+    struct FrameLatencyStats
+    {
+        /* Input-to-submit latency is measured from the moment the oldest input event consumed by a frame was
+         * received, to the moment the frame was handed over to the driver. Frames which consumed no input
+         * are not taken into account. */
+        double   average_input_to_submit_ms;
+        double   last_input_to_submit_ms;
+        double   max_input_to_submit_ms;
+        uint32_t n_frames_with_input;
+
+        /* Time spent waiting for the GPU to catch up before the most recent frame was started. */
+        double   last_fence_wait_ms;
+        uint32_t n_frames_skipped;
+        uint32_t n_frames_submitted;
+
+        FrameLatencyStats()
+            :average_input_to_submit_ms(0.0),
+             last_input_to_submit_ms   (0.0),
+             max_input_to_submit_ms    (0.0),
+             n_frames_with_input       (0),
+             last_fence_wait_ms        (0.0),
+             n_frames_skipped          (0),
+             n_frames_submitted        (0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Returns stats gathered by the framework's frame latency limiter since the app was started.
+     * Must only be called from the thread which invokes IFrameworkApp::render_frame(). */
+    FrameLatencyStats get_frame_latency_stats();
+
+    /* Limits the number of frames the CPU can queue ahead of the GPU.
+     *
+     * A fence is inserted after each submitted frame. Before a new frame is started, the limiter waits for
+     * the fence of the frame submitted FrameworkConfig::max_frames_in_flight frames earlier. Events are polled
+     * after the wait, so that input is sampled as late as possible.
+     *
+     * WebGL does not allow glClientWaitSync() to block, so if the wait cannot be satisfied right away,
+     * begin_frame() returns false instead and the caller is expected to skip the frame.
+     */
+    class FrameLatencyLimiter
+    {
+    public:
+        /* Public functions */
+
+        /* @param in_max_frames_in_flight 0 disables the limiter. Input-to-submit latency is measured regardless. */
+        static FrameLatencyLimiterUniquePtr create(const uint32_t& in_max_frames_in_flight);
+
+        ~FrameLatencyLimiter();
+
+        /* Waits until the number of frames in flight drops below the limit.
+         *
+         * If @param in_can_block is false, returns false instead of waiting, in which case end_frame()
+         * must not be called for the frame. */
+        bool begin_frame(const bool& in_can_block);
+
+        /* Should be called right after the frame has been handed over to the driver. */
+        void end_frame();
+
+        const FrameLatencyStats& get_stats() const
+        {
+            return m_stats;
+        }
+
+        /* Should be called for every input event consumed by the frame being built.
+         *
+         * @param in_event_time Time at which the event was received from the windowing system. */
+        void on_input_event(const std::chrono::steady_clock::time_point& in_event_time)
+        {
+            if (!m_has_pending_input                   ||
+                in_event_time < m_oldest_pending_input_time)
+            {
+                m_has_pending_input         = true;
+                m_oldest_pending_input_time = in_event_time;
+            }
+        }
+
+    private:
+        /* Private functions */
+        FrameLatencyLimiter(const uint32_t& in_max_frames_in_flight);
+
+        /* Private variables */
+        std::vector<GLsync> m_fence_vec;
+        uint32_t            m_n_current_frame;
+
+        bool                                  m_has_pending_input;
+        std::chrono::steady_clock::time_point m_oldest_pending_input_time;
+
+        FrameLatencyStats m_stats;
+
+        const uint32_t m_max_frames_in_flight;
+    };
+}
+
+#endif /* FRAME_LATENCY_LIMITER_H */
\ No newline at end of file
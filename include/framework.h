@@ -26,14 +26,17 @@
 #if !defined(FRAMEWORK_H)
 #define FRAMEWORK_H
 
+#include "log.h"
+#include <chrono>
 #include <memory>
 #include <string>
 #include <stdint.h>
 #include <vector>
 
-#ifdef __EMSCRIPTEN__
+#if defined(__EMSCRIPTEN__) && !defined(FRAMEWORK_GL_INSTRUMENTATION)
     #include <GLES3/gl3.h>
 #else
+    /* Instrumented builds use glad under Emscripten too, see gl_instrumentation.h. */
     #include <glad/glad.h>
 #endif
 
@@ -52,10 +55,191 @@ enum class MouseButton : uint8_t
     UNKNOWN
 };
 
+enum class InputEventType : uint8_t
+{
+    CHAR,
+    KEY,
+    MOUSE_BUTTON,
+    MOUSE_POS,
+    SCROLL,
+
+    UNKNOWN
+};
+
+struct InputEvent
+{
+    InputEventType type;
+
+    /* Time at which the event was received from the windowing system. */
+    std::chrono::steady_clock::time_point time;
+
+    /* MOUSE_BUTTON, MOUSE_POS: cursor position.
+     * SCROLL:                  scroll offsets. */
+    double x;
+    double y;
+
+    /* MOUSE_BUTTON only. */
+    bool        is_pressed;
+    MouseButton mouse_button;
+
+    /* CHAR only. Unicode code point of the character. */
+    uint32_t codepoint;
+
+    /* KEY only. GLFW_KEY_* code, GLFW_PRESS/GLFW_RELEASE/GLFW_REPEAT action & GLFW_MOD_* bits, as reported by GLFW. */
+    int key;
+    int key_action;
+    int key_mods;
+
+    InputEvent()
+        :type        (InputEventType::UNKNOWN),
+         x           (0.0),
+         y           (0.0),
+         is_pressed  (false),
+         mouse_button(MouseButton::UNKNOWN),
+         codepoint   (0),
+         key         (0),
+         key_action  (0),
+         key_mods    (0)
+    {
+        /* Stub */
+    }
+};
+
+/* Input events gathered since the previous frame, in the order they were received. */
+struct InputEventBatch
+{
+    /* Consecutive MOUSE_POS events are coalesced into one holding the most recent position, and consecutive
+     * SCROLL events are summed up. Coalesced events keep the time of the oldest event. */
+    const InputEvent* events_ptr;
+    uint32_t          n_events;
+
+    /* Every MOUSE_POS event received since the previous frame, before coalescing. Only provided if
+     * FrameworkConfig::keep_mouse_motion_history is enabled. */
+    const InputEvent* mouse_motion_history_ptr;
+    uint32_t          n_mouse_motion_history_events;
+    uint32_t          n_mouse_motion_history_events_dropped; /* Did not fit in the history. */
+
+    /* Number of events which did not fit in the queue and were dropped. */
+    uint32_t n_events_dropped;
+
+    InputEventBatch()
+        :events_ptr                           (nullptr),
+         n_events                             (0),
+         mouse_motion_history_ptr             (nullptr),
+         n_mouse_motion_history_events        (0),
+         n_mouse_motion_history_events_dropped(0),
+         n_events_dropped                     (0)
+    {
+        /* Stub */
+    }
+};
+
+/* Framework configuration, as requested by the app. */
+struct FrameworkConfig
+{
+    /* Native builds only. If enabled, a debug context is requested and performance warnings reported by the driver
+     * via KHR_debug are collected, along with the zones they were reported in. See gl_debug_output.h for details. */
+    bool capture_gl_debug_output;
+
+    /* Builds configured with FRAMEWORK_ENABLE_GL_ERROR_CHECKS only. Checked GL calls poll glGetError() every this many
+     * frames, since doing so forces a full sync under WebGL. 1 (default) checks every frame, 0 disables checks.
+     * See gl_check.h for details. */
+    uint32_t gl_error_check_frame_interval;
+
+    /* Golden image tests only (see golden_image.h). If larger than 0, the test fails if PSNR of the last frame,
+     * computed against the reference image, drops below this many dB. */
+    double golden_image_min_psnr_db;
+
+    /* Golden image tests only. Maximum difference allowed between a color channel of the last frame and that of
+     * the reference image. */
+    uint32_t golden_image_tolerance;
+
+    /* If larger than 0, a warning is logged whenever the estimated amount of GPU memory taken by live textures,
+     * buffers & render targets crosses this many bytes. See gpu_memory.h for details. */
+    uint64_t gpu_memory_budget_bytes;
+
+    /* If larger than 0, frames which take longer than this many milliseconds to build & present trigger a dump of
+     * their breakdown, as well as of n_hitch_history_frames preceding frames. See HitchDetector for details. */
+    double hitch_threshold_ms;
+
+    /* Maximum number of (coalesced) input events which can be queued per frame. Further events are dropped. */
+    uint32_t input_event_queue_capacity;
+
+    /* If enabled, InputEventBatch::mouse_motion_history_ptr holds all raw cursor motion events. Useful for
+     * apps which need the full cursor path, eg. for drawing. */
+    bool keep_mouse_motion_history;
+
+    /* Maximum number of frames the CPU may queue ahead of the GPU. Lower values reduce input latency at the cost
+     * of CPU/GPU parallelism. 0 (default) leaves frame queuing up to the driver.
+     *
+     * Under Emscripten, frames are skipped rather than waited for if the limit is reached. */
+    uint32_t max_frames_in_flight;
+
+    /* Native builds only. Capacity of each thread's trace buffer, used when the app is run with --trace <file>.
+     * Zones recorded by a thread once its buffer is full are dropped. */
+    uint32_t max_trace_zones_per_thread;
+
+    /* Number of frames preceding a hitch whose breakdowns are included in hitch dumps. */
+    uint32_t n_hitch_history_frames;
+
+    /* If enabled, frames are only rendered in response to input & window events or Framework::request_redraw()
+     * calls. The main loop sleeps otherwise, apart from occasional wake-ups which let time-based ImGui features
+     * (tooltips, text cursor blinking) update. Meant for apps which sit idle most of the time.
+     *
+     * Under Emscripten, animation frames are skipped instead. */
+    bool use_on_demand_rendering;
+
+    /* Native builds only. If enabled, ImGui UI construction (configure_imgui()) and update_frame() for frame N+1
+     * run on a worker thread while render_frame() and ImGui draw data submission for frame N run on the GL thread.
+     * ImGui draw data is snapshotted at the end of each UI pass, so the worker can start on the next frame right away.
+     * Both threads share the ImGui context, so ImGui draw data submission waits for an in-progress UI pass to finish.
+     *
+     * This adds one frame of input latency. Since render_frame() runs concurrently with configure_imgui() and
+     * update_frame(), apps must double-buffer any state shared between the two: update_frame() should publish
+     * everything render_frame() needs for the frame that follows. Input callbacks are only invoked while
+     * the worker is idle.
+     */
+    bool use_pipelined_frames;
+
+    /* Native builds only. If enabled, GL context ownership, ImGui and all IFrameworkApp callbacks are moved to
+     * a dedicated render thread, while the main thread only pumps GLFW events and forwards them to the render
+     * thread via a lock-free queue. As a result, slow event processing (eg. a window being dragged around) no
+     * longer stalls rendering and a blocking buffer swap no longer delays event processing.
+     *
+     * Unless use_pipelined_frames is also enabled, all IFrameworkApp callbacks are still invoked from a single
+     * thread, so apps need no extra synchronization. ImGui does not talk to GLFW directly in this mode, so mouse
+     * cursor shapes and clipboard access are not available.
+     *
+     * Emscripten builds configured with FRAMEWORK_USE_OFFSCREEN_CANVAS always behave as if this was enabled,
+     * with the render thread being a worker which owns the canvas.
+     */
+    bool use_render_thread;
+
+    FrameworkConfig()
+        :capture_gl_debug_output      (false),
+         gl_error_check_frame_interval(1),
+         golden_image_min_psnr_db     (0.0),
+         golden_image_tolerance       (2),
+         gpu_memory_budget_bytes      (0),
+         hitch_threshold_ms           (0.0),
+         input_event_queue_capacity   (256),
+         keep_mouse_motion_history    (false),
+         max_frames_in_flight         (0),
+         max_trace_zones_per_thread   (262144),
+         n_hitch_history_frames       (4),
+         use_on_demand_rendering      (false),
+         use_pipelined_frames         (false),
+         use_render_thread            (false)
+    {
+        /* Stub */
+    }
+};
+
 /* Global functions */
 namespace Framework
 {
-    void report_error(const std::string& in_error);
+    /* Requests a new frame to be rendered in on-demand rendering mode. Can be called from any thread. */
+    void request_redraw();
 }
 
 /* App interface */
@@ -67,11 +251,72 @@ public:
         /* Stub */
     }
 
+    /* Called once, before the window is created. */
+    virtual FrameworkConfig get_framework_config() const
+    {
+        return FrameworkConfig();
+    }
+
     virtual void configure_imgui(const int& in_width,
                                  const int& in_height) = 0;
     virtual void render_frame   (const int& in_width,
                                  const int& in_height) = 0;
 
+    /* Called right after configure_imgui(), on the same thread. Meant for CPU-side work (eg. simulation, culling,
+     * draw list construction) which prepares data for the following render_frame() call. Must not issue any GL calls,
+     * as it is invoked from a worker thread if FrameworkConfig::use_pipelined_frames is enabled. */
+    virtual void update_frame(const int& in_width,
+                              const int& in_height)
+    {
+        /* Stub */
+    }
+
+    /* Called once per frame, right before configure_imgui(), with all input events received since the previous
+     * frame. The default implementation forwards each event to the corresponding on_*_callback() function. */
+    virtual void on_input_events(const InputEventBatch& in_batch)
+    {
+        for (uint32_t n_event = 0;
+                      n_event < in_batch.n_events;
+                    ++n_event)
+        {
+            const auto& current_event = in_batch.events_ptr[n_event];
+
+            switch (current_event.type)
+            {
+                case InputEventType::MOUSE_BUTTON:
+                {
+                    on_mouse_button_callback(current_event.x,
+                                             current_event.y,
+                                             current_event.mouse_button,
+                                             current_event.is_pressed);
+
+                    break;
+                }
+
+                case InputEventType::MOUSE_POS:
+                {
+                    on_mouse_pos_callback(current_event.x,
+                                          current_event.y);
+
+                    break;
+                }
+
+                case InputEventType::SCROLL:
+                {
+                    on_scroll_callback(current_event.x,
+                                       current_event.y);
+
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+    }
+
     virtual void on_file_dropped_callback(const std::string&   in_filename,
                                           Uint8VectorUniquePtr in_data_u8_vec_ptr)
     {
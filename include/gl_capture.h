@@ -0,0 +1,194 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GL_CAPTURE_H)
+#define GL_CAPTURE_H
+
+#include "framework.h"
+#include "gl_functions.h"
+#include <stdio.h>
+#include <string.h>
+#include <type_traits>
+
+namespace Framework
+{
+    /* Forward decls */
+    class GLCapture;
+
+    template<GLFunctionID ID, typename... Args>
+    struct GLCaptureCall;
+
+    /* Type defs */
+    typedef std::unique_ptr<GLCapture> GLCaptureUniquePtr;
+
+    /* GL capture file format. All values are stored in native byte order.
+     *
+     * Header:  uint32 magic (GL_CAPTURE_MAGIC), uint32 version (GL_CAPTURE_VERSION), uint32 number of entries in
+     *          FRAMEWORK_GL_FUNCTIONS, int32 framebuffer width, int32 framebuffer height.
+     * Records: uint32 record ID, which is either a GLFunctionID or one of the GL_CAPTURE_RECORD_* values.
+     *
+     * A function call record holds one uint64 slot per argument, each holding the bytes of the argument. Every
+     * pointer argument is then described by a payload: uint8 type (GLCapturePayloadType), uint32 size in bytes,
+     * uint32 string count (STRING_ARRAY only) and, for INPUT & STRING_ARRAY payloads, the data itself, starting at
+     * an 8-byte aligned file offset. STRING_ARRAY data holds NUL-terminated strings stored back to back.
+     *
+     * For non-void functions, the call's result follows in an uint64 slot. Finally, contents of all OUTPUT
+     * payloads, as written by the function, are stored in argument order.
+     *
+     * GL_CAPTURE_RECORD_END_OF_FRAME marks a buffer swap. The file ends with GL_CAPTURE_RECORD_END_OF_STREAM.
+     */
+    static const uint32_t GL_CAPTURE_MAGIC                = 0x43475746; /* "FWGC" */
+    static const uint32_t GL_CAPTURE_RECORD_END_OF_FRAME  = 0xFFFFFFFE;
+    static const uint32_t GL_CAPTURE_RECORD_END_OF_STREAM = 0xFFFFFFFF;
+    static const uint32_t GL_CAPTURE_VERSION              = 1;
+
+    enum class GLCapturePayloadType : uint8_t
+    {
+        INPUT,        /* Data read by the function. */
+        NONE,         /* The pointer is passed as-is, eg. an offset into a bound buffer object. */
+        NULL_POINTER, /* The pointer is replaced with nullptr. */
+        OUTPUT,       /* Data written by the function. A zeroed buffer is passed on replay. */
+        STRING_ARRAY, /* An array of strings, eg. shader sources. */
+
+        UNKNOWN
+    };
+
+    /* Describes data referenced by a pointer argument of a captured call. */
+    struct GLCapturePayload
+    {
+        const void*          data_ptr;    /* STRING_ARRAY: array of string pointers. */
+        const GLint*         lengths_ptr; /* STRING_ARRAY only: optional array of string lengths. */
+        uint32_t             n_strings;   /* STRING_ARRAY only. */
+        uint32_t             size;        /* Ignored for STRING_ARRAY. */
+        GLCapturePayloadType type;
+
+        GLCapturePayload()
+            :data_ptr   (nullptr),
+             lengths_ptr(nullptr),
+             n_strings  (0),
+             size       (0),
+             type       (GLCapturePayloadType::NONE)
+        {
+            /* Stub */
+        }
+    };
+
+    /* GLsync is a pointer type, but it refers to an opaque object rather than to data. */
+    template<typename T>
+    struct IsGLCapturePayloadArg
+    {
+        static const bool value = std::is_pointer<T>::value && !std::is_same<T, GLsync>::value;
+    };
+
+    /* Argument & result values are stored in 64-bit slots. */
+    template<typename T>
+    uint64_t pack_gl_capture_slot(const T& in_value)
+    {
+        static_assert(sizeof(T) <= sizeof(uint64_t), "Value does not fit in a slot.");
+
+        uint64_t result = 0;
+
+        memcpy(&result,
+               &in_value,
+               sizeof(T) );
+
+        return result;
+    }
+
+    template<typename T>
+    T unpack_gl_capture_slot(const uint64_t& in_slot)
+    {
+        T result;
+
+        memcpy(&result,
+               &in_slot,
+               sizeof(T) );
+
+        return result;
+    }
+
+    /* Records GL calls made through glad, along with the data they read, to a file which can be replayed with
+     * GLReplayer (see the gl-replay tool).
+     *
+     * Calls are captured by swapping glad's function pointers for those listed in FRAMEWORK_GL_FUNCTIONS, for as
+     * long as the capture object is alive. Object contents are not captured retroactively, so the capture should
+     * be created before the app creates any GL objects. Only one capture can be active at a time, and all GL calls
+     * must be made from the thread which owns the context.
+     *
+     * NOTE: Client-side vertex & index arrays and mapped buffer writes are not captured.
+     */
+    class GLCapture
+    {
+    public:
+        /* Public functions */
+
+        /* Starts capturing right away. glad must have been loaded by the time of the call.
+         *
+         * @param in_n_frames is the number of buffer swaps to capture calls for. */
+        static GLCaptureUniquePtr create(const std::string& in_filename,
+                                         const uint32_t&    in_n_frames,
+                                         const int&         in_framebuffer_width,
+                                         const int&         in_framebuffer_height);
+
+        /* Restores glad's function pointers & finalizes the file. */
+        ~GLCapture();
+
+        /* Must be called right after each buffer swap. Returns false once all frames have been captured, at which
+         * point the capture should be released. */
+        bool on_frame_end();
+
+    private:
+        /* Private functions */
+        GLCapture(const std::string& in_filename,
+                  const uint32_t&    in_n_frames,
+                  const int&         in_framebuffer_width,
+                  const int&         in_framebuffer_height);
+
+        bool init();
+
+        void write                (const void*             in_data_ptr,
+                                   const size_t&           in_size);
+        void write_output_payloads(const GLCapturePayload* in_payloads_ptr,
+                                   const bool*             in_is_payload_arg_ptr,
+                                   const uint32_t&         in_n_args);
+        void write_payload        (const GLCapturePayload& in_payload);
+
+        template<GLFunctionID ID, typename... Args>
+        friend struct GLCaptureCall;
+
+        /* Private variables */
+        FILE*    m_file_ptr;
+        bool     m_has_write_failed;
+        uint64_t m_n_bytes_written;
+        uint32_t m_n_frames_captured;
+
+        const std::string m_filename;
+        const int         m_framebuffer_height;
+        const int         m_framebuffer_width;
+        const uint32_t    m_n_frames;
+    };
+}
+
+#endif /* GL_CAPTURE_H */
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GL_CHECK_H)
+#define GL_CHECK_H
+
+#include "framework.h"
+
+/* Checked GL calls, enabled by building with FRAMEWORK_GL_ERROR_CHECKS defined (see the
+ * FRAMEWORK_ENABLE_GL_ERROR_CHECKS CMake option).
+ *
+ * FRAMEWORK_GL_CHECK() wraps a single GL call and evaluates to its result, eg.
+ *
+ *     m_id = FRAMEWORK_GL_CHECK(glCreateProgram() );
+ *     FRAMEWORK_GL_CHECK(glLinkProgram(m_id) );
+ *
+ * In checked builds, glGetError() is polled right before and after the call. Errors raised by the call are logged
+ * along with the call's text, file & line. Errors left behind by preceding unchecked calls are logged separately,
+ * so that they are not mistaken for errors raised by the wrapped call.
+ *
+ * Since glGetError() forces a full sync under WebGL, checks can be restricted to every Nth frame with
+ * FrameworkConfig::gl_error_check_frame_interval. Calls made in frames which are not sampled only pay for
+ * a single branch.
+ *
+ * In other builds, the macro expands to the call itself and all functions below are no-ops.
+ *
+ * Checked calls must be made from the thread which owns the GL context.
+ */
+#if defined(FRAMEWORK_GL_ERROR_CHECKS)
+    #define FRAMEWORK_GL_CHECK(call) (Framework::GLErrorCheck(#call, __FILE__, __LINE__), call)
+#else
+    #define FRAMEWORK_GL_CHECK(call) call
+#endif
+
+namespace Framework
+{
+    #if defined(FRAMEWORK_GL_ERROR_CHECKS)
+        /* Checks for GL errors when constructed & destroyed. Only meant to be used via FRAMEWORK_GL_CHECK(), which
+         * relies on the temporary being destroyed at the end of the full-expression containing the call. */
+        class GLErrorCheck
+        {
+        public:
+            GLErrorCheck(const char* in_call_ptr,
+                         const char* in_file_ptr,
+                         const int&  in_line);
+            ~GLErrorCheck();
+
+        private:
+            const char* m_call_ptr; /* nullptr if the current frame is not sampled. */
+            const char* m_file_ptr;
+            const int   m_line;
+        };
+
+        /* Returns the number of GL errors reported by checked calls so far. */
+        uint32_t get_n_gl_errors();
+
+        /* Returns true if checked calls poll glGetError() in the current frame. */
+        bool is_gl_error_checking_active();
+
+        /* Used by the framework. */
+        void begin_gl_error_check_frame       ();
+        void set_gl_error_check_frame_interval(const uint32_t& in_n_frames);
+    #else
+        inline uint32_t get_n_gl_errors()
+        {
+            return 0;
+        }
+
+        inline bool is_gl_error_checking_active()
+        {
+            return false;
+        }
+
+        inline void begin_gl_error_check_frame()
+        {
+            /* Stub */
+        }
+
+        inline void set_gl_error_check_frame_interval(const uint32_t& in_n_frames)
+        {
+            /* Stub */
+        }
+    #endif
+}
+
+#endif /* GL_CHECK_H */
\ No newline at end of file
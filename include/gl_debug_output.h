@@ -0,0 +1,79 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GL_DEBUG_OUTPUT_H)
+#define GL_DEBUG_OUTPUT_H
+
+#include "framework.h"
+
+namespace Framework
+{
+    struct GLDebugMessage
+    {
+        GLuint      id;
+        std::string message;       /* Text of the first occurrence. */
+        uint32_t    n_occurrences;
+        GLenum      severity;      /* Of the first occurrence. */
+        GLenum      source;
+        const char* zone_name_ptr; /* Innermost CPU zone open when the message was emitted, or nullptr. See trace.h. */
+    };
+
+    /* Driver debug output capture, enabled by FrameworkConfig::capture_gl_debug_output. Native builds only, since
+     * WebGL does not expose KHR_debug.
+     *
+     * The framework requests a debug context and installs a KHR_debug callback which collects performance warnings
+     * (eg. shader recompiles, pipeline stalls or format conversions). Debug output is made synchronous, so that each
+     * message can be attributed to the zone in which the offending GL call was made. Messages are grouped by source,
+     * ID & zone, and a summary is printed to stdout at shutdown.
+     *
+     * All functions are thread-safe.
+     */
+    #if !defined(__EMSCRIPTEN__)
+        /* Returns all messages captured so far, most frequent first. */
+        std::vector<GLDebugMessage> get_gl_debug_messages();
+
+        /* Used by the framework. enable_gl_debug_output() must be called from the thread which owns the GL context,
+         * after GL entry-points have been loaded. Returns false if KHR_debug is not supported. */
+        bool enable_gl_debug_output      ();
+        void print_gl_debug_output_report();
+    #else
+        inline std::vector<GLDebugMessage> get_gl_debug_messages()
+        {
+            return std::vector<GLDebugMessage>();
+        }
+
+        inline bool enable_gl_debug_output()
+        {
+            return false;
+        }
+
+        inline void print_gl_debug_output_report()
+        {
+            /* Stub */
+        }
+    #endif
+}
+
+#endif /* GL_DEBUG_OUTPUT_H */
\ No newline at end of file
@@ -0,0 +1,209 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GL_FUNCTIONS_H)
+#define GL_FUNCTIONS_H
+
+#include "framework.h"
+
+/* Lists GL entry-points which the framework can intercept by swapping glad's function pointers. Each entry is
+ * X(name without the "gl" prefix, glad function pointer type). The pointer is accessible as glad_gl##name.
+ *
+ * Functions which are not listed here are never intercepted, so apps using them are not captured in full.
+ */
+#define FRAMEWORK_GL_FUNCTIONS(X) \
+    X(ActiveTexture,                  PFNGLACTIVETEXTUREPROC)                  \
+    X(AttachShader,                   PFNGLATTACHSHADERPROC)                   \
+    X(BeginQuery,                     PFNGLBEGINQUERYPROC)                     \
+    X(BeginTransformFeedback,         PFNGLBEGINTRANSFORMFEEDBACKPROC)         \
+    X(BindAttribLocation,             PFNGLBINDATTRIBLOCATIONPROC)             \
+    X(BindBuffer,                     PFNGLBINDBUFFERPROC)                     \
+    X(BindBufferBase,                 PFNGLBINDBUFFERBASEPROC)                 \
+    X(BindBufferRange,                PFNGLBINDBUFFERRANGEPROC)                \
+    X(BindFramebuffer,                PFNGLBINDFRAMEBUFFERPROC)                \
+    X(BindRenderbuffer,               PFNGLBINDRENDERBUFFERPROC)               \
+    X(BindSampler,                    PFNGLBINDSAMPLERPROC)                    \
+    X(BindTexture,                    PFNGLBINDTEXTUREPROC)                    \
+    X(BindTransformFeedback,          PFNGLBINDTRANSFORMFEEDBACKPROC)          \
+    X(BindVertexArray,                PFNGLBINDVERTEXARRAYPROC)                \
+    X(BlendColor,                     PFNGLBLENDCOLORPROC)                     \
+    X(BlendEquation,                  PFNGLBLENDEQUATIONPROC)                  \
+    X(BlendEquationSeparate,          PFNGLBLENDEQUATIONSEPARATEPROC)          \
+    X(BlendFunc,                      PFNGLBLENDFUNCPROC)                      \
+    X(BlendFuncSeparate,              PFNGLBLENDFUNCSEPARATEPROC)              \
+    X(BlitFramebuffer,                PFNGLBLITFRAMEBUFFERPROC)                \
+    X(BufferData,                     PFNGLBUFFERDATAPROC)                     \
+    X(BufferSubData,                  PFNGLBUFFERSUBDATAPROC)                  \
+    X(CheckFramebufferStatus,         PFNGLCHECKFRAMEBUFFERSTATUSPROC)         \
+    X(Clear,                          PFNGLCLEARPROC)                          \
+    X(ClearBufferfi,                  PFNGLCLEARBUFFERFIPROC)                  \
+    X(ClearBufferfv,                  PFNGLCLEARBUFFERFVPROC)                  \
+    X(ClearBufferiv,                  PFNGLCLEARBUFFERIVPROC)                  \
+    X(ClearBufferuiv,                 PFNGLCLEARBUFFERUIVPROC)                 \
+    X(ClearColor,                     PFNGLCLEARCOLORPROC)                     \
+    X(ClearDepthf,                    PFNGLCLEARDEPTHFPROC)                    \
+    X(ClearStencil,                   PFNGLCLEARSTENCILPROC)                   \
+    X(ClientWaitSync,                 PFNGLCLIENTWAITSYNCPROC)                 \
+    X(ColorMask,                      PFNGLCOLORMASKPROC)                      \
+    X(CompileShader,                  PFNGLCOMPILESHADERPROC)                  \
+    X(CompressedTexImage2D,           PFNGLCOMPRESSEDTEXIMAGE2DPROC)           \
+    X(CompressedTexSubImage2D,        PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)        \
+    X(CopyBufferSubData,              PFNGLCOPYBUFFERSUBDATAPROC)              \
+    X(CreateProgram,                  PFNGLCREATEPROGRAMPROC)                  \
+    X(CreateShader,                   PFNGLCREATESHADERPROC)                   \
+    X(CullFace,                       PFNGLCULLFACEPROC)                       \
+    X(DeleteBuffers,                  PFNGLDELETEBUFFERSPROC)                  \
+    X(DeleteFramebuffers,             PFNGLDELETEFRAMEBUFFERSPROC)             \
+    X(DeleteProgram,                  PFNGLDELETEPROGRAMPROC)                  \
+    X(DeleteQueries,                  PFNGLDELETEQUERIESPROC)                  \
+    X(DeleteRenderbuffers,            PFNGLDELETERENDERBUFFERSPROC)            \
+    X(DeleteSamplers,                 PFNGLDELETESAMPLERSPROC)                 \
+    X(DeleteShader,                   PFNGLDELETESHADERPROC)                   \
+    X(DeleteSync,                     PFNGLDELETESYNCPROC)                     \
+    X(DeleteTextures,                 PFNGLDELETETEXTURESPROC)                 \
+    X(DeleteTransformFeedbacks,       PFNGLDELETETRANSFORMFEEDBACKSPROC)       \
+    X(DeleteVertexArrays,             PFNGLDELETEVERTEXARRAYSPROC)             \
+    X(DepthFunc,                      PFNGLDEPTHFUNCPROC)                      \
+    X(DepthMask,                      PFNGLDEPTHMASKPROC)                      \
+    X(DetachShader,                   PFNGLDETACHSHADERPROC)                   \
+    X(Disable,                        PFNGLDISABLEPROC)                        \
+    X(DisableVertexAttribArray,       PFNGLDISABLEVERTEXATTRIBARRAYPROC)       \
+    X(DrawArrays,                     PFNGLDRAWARRAYSPROC)                     \
+    X(DrawArraysInstanced,            PFNGLDRAWARRAYSINSTANCEDPROC)            \
+    X(DrawBuffers,                    PFNGLDRAWBUFFERSPROC)                    \
+    X(DrawElements,                   PFNGLDRAWELEMENTSPROC)                   \
+    X(DrawElementsInstanced,          PFNGLDRAWELEMENTSINSTANCEDPROC)          \
+    X(DrawRangeElements,              PFNGLDRAWRANGEELEMENTSPROC)              \
+    X(Enable,                         PFNGLENABLEPROC)                         \
+    X(EnableVertexAttribArray,        PFNGLENABLEVERTEXATTRIBARRAYPROC)        \
+    X(EndQuery,                       PFNGLENDQUERYPROC)                       \
+    X(EndTransformFeedback,           PFNGLENDTRANSFORMFEEDBACKPROC)           \
+    X(FenceSync,                      PFNGLFENCESYNCPROC)                      \
+    X(Finish,                         PFNGLFINISHPROC)                         \
+    X(Flush,                          PFNGLFLUSHPROC)                          \
+    X(FramebufferRenderbuffer,        PFNGLFRAMEBUFFERRENDERBUFFERPROC)        \
+    X(FramebufferTexture2D,           PFNGLFRAMEBUFFERTEXTURE2DPROC)           \
+    X(FramebufferTextureLayer,        PFNGLFRAMEBUFFERTEXTURELAYERPROC)        \
+    X(FrontFace,                      PFNGLFRONTFACEPROC)                      \
+    X(GenBuffers,                     PFNGLGENBUFFERSPROC)                     \
+    X(GenFramebuffers,                PFNGLGENFRAMEBUFFERSPROC)                \
+    X(GenQueries,                     PFNGLGENQUERIESPROC)                     \
+    X(GenRenderbuffers,               PFNGLGENRENDERBUFFERSPROC)               \
+    X(GenSamplers,                    PFNGLGENSAMPLERSPROC)                    \
+    X(GenTextures,                    PFNGLGENTEXTURESPROC)                    \
+    X(GenTransformFeedbacks,          PFNGLGENTRANSFORMFEEDBACKSPROC)          \
+    X(GenVertexArrays,                PFNGLGENVERTEXARRAYSPROC)                \
+    X(GenerateMipmap,                 PFNGLGENERATEMIPMAPPROC)                 \
+    X(GetActiveUniform,               PFNGLGETACTIVEUNIFORMPROC)               \
+    X(GetAttribLocation,              PFNGLGETATTRIBLOCATIONPROC)              \
+    X(GetError,                       PFNGLGETERRORPROC)                       \
+    X(GetIntegerv,                    PFNGLGETINTEGERVPROC)                    \
+    X(GetProgramInfoLog,              PFNGLGETPROGRAMINFOLOGPROC)              \
+    X(GetProgramiv,                   PFNGLGETPROGRAMIVPROC)                   \
+    X(GetQueryObjectuiv,              PFNGLGETQUERYOBJECTUIVPROC)              \
+    X(GetShaderInfoLog,               PFNGLGETSHADERINFOLOGPROC)               \
+    X(GetShaderiv,                    PFNGLGETSHADERIVPROC)                    \
+    X(GetUniformBlockIndex,           PFNGLGETUNIFORMBLOCKINDEXPROC)           \
+    X(GetUniformLocation,             PFNGLGETUNIFORMLOCATIONPROC)             \
+    X(InvalidateFramebuffer,          PFNGLINVALIDATEFRAMEBUFFERPROC)          \
+    X(LinkProgram,                    PFNGLLINKPROGRAMPROC)                    \
+    X(PixelStorei,                    PFNGLPIXELSTOREIPROC)                    \
+    X(PolygonOffset,                  PFNGLPOLYGONOFFSETPROC)                  \
+    X(ReadBuffer,                     PFNGLREADBUFFERPROC)                     \
+    X(RenderbufferStorage,            PFNGLRENDERBUFFERSTORAGEPROC)            \
+    X(RenderbufferStorageMultisample, PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC) \
+    X(SamplerParameterf,              PFNGLSAMPLERPARAMETERFPROC)              \
+    X(SamplerParameteri,              PFNGLSAMPLERPARAMETERIPROC)              \
+    X(Scissor,                        PFNGLSCISSORPROC)                        \
+    X(ShaderSource,                   PFNGLSHADERSOURCEPROC)                   \
+    X(StencilFunc,                    PFNGLSTENCILFUNCPROC)                    \
+    X(StencilMask,                    PFNGLSTENCILMASKPROC)                    \
+    X(StencilOp,                      PFNGLSTENCILOPPROC)                      \
+    X(TexImage2D,                     PFNGLTEXIMAGE2DPROC)                     \
+    X(TexImage3D,                     PFNGLTEXIMAGE3DPROC)                     \
+    X(TexParameterf,                  PFNGLTEXPARAMETERFPROC)                  \
+    X(TexParameteri,                  PFNGLTEXPARAMETERIPROC)                  \
+    X(TexStorage2D,                   PFNGLTEXSTORAGE2DPROC)                   \
+    X(TexStorage3D,                   PFNGLTEXSTORAGE3DPROC)                   \
+    X(TexSubImage2D,                  PFNGLTEXSUBIMAGE2DPROC)                  \
+    X(TexSubImage3D,                  PFNGLTEXSUBIMAGE3DPROC)                  \
+    X(TransformFeedbackVaryings,      PFNGLTRANSFORMFEEDBACKVARYINGSPROC)      \
+    X(Uniform1f,                      PFNGLUNIFORM1FPROC)                      \
+    X(Uniform1fv,                     PFNGLUNIFORM1FVPROC)                     \
+    X(Uniform1i,                      PFNGLUNIFORM1IPROC)                      \
+    X(Uniform1iv,                     PFNGLUNIFORM1IVPROC)                     \
+    X(Uniform1ui,                     PFNGLUNIFORM1UIPROC)                     \
+    X(Uniform1uiv,                    PFNGLUNIFORM1UIVPROC)                    \
+    X(Uniform2f,                      PFNGLUNIFORM2FPROC)                      \
+    X(Uniform2fv,                     PFNGLUNIFORM2FVPROC)                     \
+    X(Uniform2i,                      PFNGLUNIFORM2IPROC)                      \
+    X(Uniform2iv,                     PFNGLUNIFORM2IVPROC)                     \
+    X(Uniform3f,                      PFNGLUNIFORM3FPROC)                      \
+    X(Uniform3fv,                     PFNGLUNIFORM3FVPROC)                     \
+    X(Uniform3i,                      PFNGLUNIFORM3IPROC)                      \
+    X(Uniform3iv,                     PFNGLUNIFORM3IVPROC)                     \
+    X(Uniform4f,                      PFNGLUNIFORM4FPROC)                      \
+    X(Uniform4fv,                     PFNGLUNIFORM4FVPROC)                     \
+    X(Uniform4i,                      PFNGLUNIFORM4IPROC)                      \
+    X(Uniform4iv,                     PFNGLUNIFORM4IVPROC)                     \
+    X(UniformBlockBinding,            PFNGLUNIFORMBLOCKBINDINGPROC)            \
+    X(UniformMatrix3fv,               PFNGLUNIFORMMATRIX3FVPROC)               \
+    X(UniformMatrix4fv,               PFNGLUNIFORMMATRIX4FVPROC)               \
+    X(UseProgram,                     PFNGLUSEPROGRAMPROC)                     \
+    X(VertexAttribDivisor,            PFNGLVERTEXATTRIBDIVISORPROC)            \
+    X(VertexAttribIPointer,           PFNGLVERTEXATTRIBIPOINTERPROC)           \
+    X(VertexAttribPointer,            PFNGLVERTEXATTRIBPOINTERPROC)            \
+    X(Viewport,                       PFNGLVIEWPORTPROC)                       \
+    X(WaitSync,                       PFNGLWAITSYNCPROC)
+
+namespace Framework
+{
+    /* Indices into FRAMEWORK_GL_FUNCTIONS. Stored in GL capture files, so GL_CAPTURE_VERSION must be bumped whenever
+     * the list changes. */
+    enum class GLFunctionID : uint32_t
+    {
+        #define FRAMEWORK_GL_FUNCTION_ID(name, pfn) name,
+            FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_GL_FUNCTION_ID)
+        #undef FRAMEWORK_GL_FUNCTION_ID
+
+        COUNT
+    };
+
+    /* Returns the name of the entry-point, eg. "glDrawArrays". */
+    inline const char* get_gl_function_name(const GLFunctionID& in_id)
+    {
+        static const char* names[] =
+        {
+            #define FRAMEWORK_GL_FUNCTION_NAME(name, pfn) "gl" #name,
+                FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_GL_FUNCTION_NAME)
+            #undef FRAMEWORK_GL_FUNCTION_NAME
+        };
+
+        return (in_id < GLFunctionID::COUNT) ? names[static_cast<uint32_t>(in_id)]
+                                             : "?";
+    }
+}
+
+#endif /* GL_FUNCTIONS_H */
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GL_INSTRUMENTATION_H)
+#define GL_INSTRUMENTATION_H
+
+#include "framework.h"
+#include "gl_functions.h"
+#include <array>
+
+namespace Framework
+{
+    struct GLCallStats
+    {
+        double   cpu_time_ms; /* Time spent inside the driver, excluding callbacks. */
+        uint32_t n_calls;
+    };
+
+    /* Type defs */
+    typedef std::array<GLCallStats, static_cast<uint32_t>(GLFunctionID::COUNT)> GLCallStatsArray; /* Indexed by GLFunctionID. */
+
+    /* Invoked right before / after each instrumented GL call. */
+    typedef void (*PFNGLCALLCALLBACKPROC)(const GLFunctionID& in_id,
+                                          void*               in_user_arg);
+
+    /* GL call instrumentation, enabled by building with FRAMEWORK_GL_INSTRUMENTATION defined (see the
+     * FRAMEWORK_ENABLE_GL_INSTRUMENTATION CMake option).
+     *
+     * Calls to functions listed in FRAMEWORK_GL_FUNCTIONS are counted and timed per entry-point by swapping glad's
+     * function pointers. Under Emscripten, the framework loads GL entry-points with glad in instrumented builds, so
+     * that each call into WebGL made by the framework & the app is accounted for.
+     *
+     * NOTE: ImGui's OpenGL3 renderer backend does not go through glad. Natively, it uses its own embedded loader;
+     *       under Emscripten, it calls WebGL directly. Its per-frame calls are therefore neither counted nor timed,
+     *       so stats & the end-of-run report under-count by that much. The CPU time spent by the backend shows up
+     *       in the trace, in the ImGui_ImplOpenGL3_RenderDrawData zone.
+     *
+     * All functions must be called from the thread which owns the GL context. When instrumentation is compiled out,
+     * they are no-ops and no hooks are installed.
+     */
+    #if defined(FRAMEWORK_GL_INSTRUMENTATION)
+        /* Returns stats of the most recently completed frame if @param in_last_frame_only is true, or stats
+         * accumulated over all frames otherwise. */
+        const GLCallStatsArray& get_gl_call_stats(const bool& in_last_frame_only);
+
+        /* Either callback can be nullptr. */
+        void set_gl_call_callbacks(PFNGLCALLCALLBACKPROC in_pre_call_func_ptr,
+                                   PFNGLCALLCALLBACKPROC in_post_call_func_ptr,
+                                   void*                 in_user_arg);
+
+        /* Used by the framework. */
+        void end_gl_instrumentation_frame  ();
+        void install_gl_instrumentation    ();
+        void print_gl_instrumentation_report();
+    #else
+        inline const GLCallStatsArray& get_gl_call_stats(const bool& in_last_frame_only)
+        {
+            static const GLCallStatsArray empty_stats = {};
+
+            return empty_stats;
+        }
+
+        inline void set_gl_call_callbacks(PFNGLCALLCALLBACKPROC in_pre_call_func_ptr,
+                                          PFNGLCALLCALLBACKPROC in_post_call_func_ptr,
+                                          void*                 in_user_arg)
+        {
+            /* Stub */
+        }
+
+        inline void end_gl_instrumentation_frame()
+        {
+            /* Stub */
+        }
+
+        inline void install_gl_instrumentation()
+        {
+            /* Stub */
+        }
+
+        inline void print_gl_instrumentation_report()
+        {
+            /* Stub */
+        }
+    #endif
+}
+
+#endif /* GL_INSTRUMENTATION_H */
\ No newline at end of file
@@ -0,0 +1,204 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GL_REPLAYER_H)
+#define GL_REPLAYER_H
+
+#include "framework.h"
+#include "gl_capture.h"
+#include "gl_functions.h"
+#include <array>
+#include <unordered_map>
+
+namespace Framework
+{
+    /* Forward decls */
+    class GLReplayer;
+
+    template<GLFunctionID ID, typename PFN>
+    struct GLReplayCall;
+
+    /* Type defs */
+    typedef std::unique_ptr<GLReplayer> GLReplayerUniquePtr;
+
+    struct GLReplayFrameStats
+    {
+        double   call_time_ms; /* Total CPU time spent in GL calls. */
+        uint32_t n_calls;
+
+        GLReplayFrameStats()
+            :call_time_ms(0.0),
+             n_calls     (0)
+        {
+            /* Stub */
+        }
+    };
+
+    struct GLReplayFunctionStats
+    {
+        double   max_call_time_ms;
+        uint32_t n_calls;
+        double   total_call_time_ms;
+
+        GLReplayFunctionStats()
+            :max_call_time_ms  (0.0),
+             n_calls           (0),
+             total_call_time_ms(0.0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Re-issues GL calls stored in a file written by GLCapture. The whole file is loaded at creation time.
+     *
+     * Object names, sync objects and uniform locations are remapped to those returned on replay, so objects created
+     * outside of the capture (eg. by ImGui) do not have to be allocated in the same order. Names which the capture
+     * uses without having created them are passed through as-is and counted, see get_n_unknown_object_names().
+     */
+    class GLReplayer
+    {
+    public:
+        /* Public functions */
+        static GLReplayerUniquePtr create(const std::string& in_filename);
+
+        int get_framebuffer_height() const
+        {
+            return m_framebuffer_height;
+        }
+
+        int get_framebuffer_width() const
+        {
+            return m_framebuffer_width;
+        }
+
+        /* Returns stats accumulated over all replayed frames, indexed by GLFunctionID. */
+        const std::array<GLReplayFunctionStats, static_cast<uint32_t>(GLFunctionID::COUNT)>& get_function_stats() const
+        {
+            return m_function_stats;
+        }
+
+        uint32_t get_n_unknown_object_names() const
+        {
+            return m_n_unknown_object_names;
+        }
+
+        /* Issues all calls up to the next end-of-frame marker. Buffers are not swapped.
+         *
+         * Must be called from a thread with a current GL context, after glad has been loaded.
+         *
+         * Returns false once the end of the capture has been reached, or if the capture is malformed.
+         */
+        bool replay_frame(GLReplayFrameStats* out_stats_ptr);
+
+    private:
+        /* Private type defs */
+        typedef void (APIENTRYP PFNGLGENERICPROC)(void);
+        typedef bool (*PFNREPLAYCALLPROC)        (GLReplayer* in_replayer_ptr);
+
+        /* Programs and shaders share a single namespace, as in GL. */
+        enum class ObjectNamespace
+        {
+            BUFFER,
+            FRAMEBUFFER,
+            PROGRAM,
+            QUERY,
+            RENDERBUFFER,
+            SAMPLER,
+            TEXTURE,
+            TRANSFORM_FEEDBACK,
+            VERTEX_ARRAY,
+
+            COUNT
+        };
+
+        /* Resolved payload of a pointer argument. */
+        struct Payload
+        {
+            void*                data_ptr;
+            uint32_t             size;
+            GLCapturePayloadType type;
+        };
+
+        /* Private functions */
+        GLReplayer(const std::string& in_filename);
+
+        static bool get_object_name_array_namespace(const GLFunctionID& in_id,
+                                                    ObjectNamespace*    out_namespace_ptr);
+
+        bool init();
+
+        void on_after_call (const GLFunctionID& in_id,
+                            const uint64_t*     in_arg_slots_ptr,
+                            const uint64_t&     in_captured_result_slot,
+                            const uint64_t&     in_result_slot);
+        void on_before_call(const GLFunctionID& in_id,
+                            uint64_t*           inout_arg_slots_ptr,
+                            Payload*            inout_payloads_ptr);
+        void on_call_timed (const GLFunctionID& in_id,
+                            const double&       in_call_time_ms);
+
+        bool read                (void*               out_data_ptr,
+                                  const size_t&       in_size);
+        bool read_output_payloads(const GLFunctionID& in_id,
+                                  const Payload*      in_payloads_ptr,
+                                  const bool*         in_is_payload_arg_ptr,
+                                  const uint32_t&     in_n_args);
+        bool read_payload        (const uint32_t&     in_n_arg,
+                                  Payload*            out_payload_ptr);
+
+        GLuint translate_object_name    (const ObjectNamespace& in_namespace,
+                                         const GLuint&          in_captured_name);
+        void   translate_object_name_arg(const ObjectNamespace& in_namespace,
+                                         uint64_t*              inout_arg_slot_ptr);
+
+        template<GLFunctionID ID, typename PFN>
+        friend struct GLReplayCall;
+
+        /* Private variables */
+        std::vector<uint8_t> m_data_u8_vec;
+        int                  m_framebuffer_height;
+        int                  m_framebuffer_width;
+        size_t               m_read_offset;
+
+        std::array<GLReplayFunctionStats, static_cast<uint32_t>(GLFunctionID::COUNT)> m_function_stats;
+        std::array<PFNGLGENERICPROC,      static_cast<uint32_t>(GLFunctionID::COUNT)> m_gl_function_ptrs;
+        std::array<PFNREPLAYCALLPROC,     static_cast<uint32_t>(GLFunctionID::COUNT)> m_replay_call_func_ptrs;
+
+        std::array<std::unordered_map<GLuint, GLuint>, static_cast<uint32_t>(ObjectNamespace::COUNT)> m_object_name_maps; /* Captured -> replayed name. */
+
+        GLuint                                 m_current_program;        /* Replayed name. */
+        GLReplayFrameStats*                    m_frame_stats_ptr;
+        uint32_t                               m_n_unknown_object_names;
+        std::vector<std::vector<uint8_t> >     m_output_payload_u8_vecs; /* Indexed by argument. */
+        std::vector<std::vector<const char*> > m_string_array_ptr_vecs;  /* Indexed by argument. */
+        std::unordered_map<uint64_t, GLsync>   m_sync_map;
+        std::vector<GLuint>                    m_translated_name_vec;    /* Holds translated names passed to glDelete*(). */
+        std::unordered_map<uint64_t, GLint>    m_uniform_location_map;   /* Key: replayed program << 32 | captured location. */
+
+        const std::string m_filename;
+    };
+}
+
+#endif /* GL_REPLAYER_H */
\ No newline at end of file
@@ -0,0 +1,153 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GOLDEN_IMAGE_H)
+#define GOLDEN_IMAGE_H
+
+#include "framework.h"
+
+namespace Framework
+{
+    /* Forward decls */
+    class GoldenImageTest;
+
+    /* Type defs */
+    typedef std::unique_ptr<GoldenImageTest> GoldenImageTestUniquePtr;
+
+    enum class GoldenImageMode
+    {
+        CHECK,  /* Compare the last frame against the reference image. */
+        UPDATE, /* Overwrite the reference image with the last frame. */
+    };
+
+    /* RGBA8 image, stored top row first. */
+    struct Image
+    {
+        uint32_t             height;
+        std::vector<uint8_t> rgba_u8_vec;
+        uint32_t             width;
+
+        Image()
+            :height(0),
+             width (0)
+        {
+            /* Stub */
+        }
+    };
+
+    struct ImageDiff
+    {
+        uint32_t max_channel_difference;
+        uint32_t n_differing_pixels; /* Pixels with a color channel differing by more than the tolerance. */
+        double   psnr_db;            /* Computed over color channels. Infinity if the images are identical. */
+
+        ImageDiff()
+            :max_channel_difference(0),
+             n_differing_pixels    (0),
+             psnr_db               (0.0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Compares color channels of two images of equal size. Alpha is ignored, since it is not meaningful for
+     * the default framebuffer. Uses SSE2 where available. */
+    ImageDiff diff_images(const Image&    in_image1,
+                          const Image&    in_image2,
+                          const uint32_t& in_tolerance);
+
+    /* Images are stored as binary PAM files (RGB_ALPHA tuples), which most image viewers & converters can open. */
+    bool load_image(const std::string& in_filename,
+                    Image*             out_image_ptr);
+    bool save_image(const std::string& in_filename,
+                    const Image&       in_image);
+
+    /* Golden image regression testing, enabled with --golden-image <file> <number of frames> and
+     * --update-golden-image <file> <number of frames> command line arguments. Native builds only.
+     *
+     * The app is run in a hidden window with vsync disabled. Once the requested number of frames has been rendered,
+     * the last one is read back right before it is presented. In CHECK mode, it is then compared against
+     * the reference image. The test fails if any color channel differs by more than
+     * FrameworkConfig::golden_image_tolerance, or if PSNR drops below FrameworkConfig::golden_image_min_psnr_db.
+     *
+     * On success, frame timings are printed. On failure, the frame is saved next to the reference image as
+     * <file>.actual.pam, along with <file>.diff.pam in which differing pixels are marked red, and the app exits with
+     * a non-zero code.
+     *
+     * Apps need to render deterministically for results to be meaningful, eg. by not depending on wall-clock time.
+     * Input can be made deterministic by combining this mode with --replay.
+     */
+    class GoldenImageTest
+    {
+    public:
+        /* Public functions */
+        static GoldenImageTestUniquePtr create(const std::string&     in_filename,
+                                               const uint32_t&        in_n_frames,
+                                               const GoldenImageMode& in_mode,
+                                               const uint32_t&        in_tolerance,
+                                               const double&          in_min_psnr_db);
+
+        ~GoldenImageTest();
+
+        /* Returns true if all frames have been rendered and the last one matched the reference image (CHECK mode)
+         * or was saved (UPDATE mode). */
+        bool has_passed() const
+        {
+            return (m_n_frames_rendered >= m_n_frames) && !m_has_failed;
+        }
+
+        /* Must be called right before each buffer swap by the thread which owns the GL context. Returns true once
+         * the last frame has been processed, after which the app should quit. */
+        bool on_frame_end(const int& in_framebuffer_width,
+                          const int& in_framebuffer_height);
+
+    private:
+        /* Private functions */
+        GoldenImageTest(const std::string&     in_filename,
+                        const uint32_t&        in_n_frames,
+                        const GoldenImageMode& in_mode,
+                        const uint32_t&        in_tolerance,
+                        const double&          in_min_psnr_db);
+
+        bool check_frame (const Image& in_frame);
+        void print_timings() const;
+
+        /* Private variables */
+        const std::string     m_filename;
+        const double          m_min_psnr_db;
+        const GoldenImageMode m_mode;
+        const uint32_t        m_n_frames;
+        const uint32_t        m_tolerance;
+
+        std::chrono::steady_clock::time_point m_last_frame_end_time;
+        double                                m_max_frame_time_ms;
+        double                                m_min_frame_time_ms;
+        bool                                  m_has_failed;
+        uint32_t                              m_n_frames_rendered;
+        double                                m_total_frame_time_ms;
+    };
+}
+
+#endif /* GOLDEN_IMAGE_H */
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(GPU_MEMORY_H)
+#define GPU_MEMORY_H
+
+#include <array>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Framework
+{
+    /* Enums */
+    enum class GPUMemoryType : uint8_t
+    {
+        BUFFER,
+        RENDER_TARGET,
+        TEXTURE,
+
+        COUNT
+    };
+
+    /* Type defs */
+    typedef uint64_t                                                          GPUMemoryAllocationID;  /* 0 is never assigned to a registered allocation. */
+    typedef std::array<uint64_t, static_cast<uint32_t>(GPUMemoryType::COUNT)> GPUMemoryTypeSizeArray; /* Indexed by GPUMemoryType. */
+
+    struct GPUMemoryTagStats
+    {
+        uint32_t      n_allocations;
+        uint64_t      n_bytes;
+        std::string   tag;
+        GPUMemoryType type;
+    };
+
+    struct GPUMemoryStats
+    {
+        uint64_t                       budget_n_bytes;    /* 0 if no budget has been set. */
+        uint32_t                       n_budget_overruns; /* Number of times the total has crossed the budget. */
+        GPUMemoryTypeSizeArray         n_bytes_per_type;
+        uint64_t                       peak_n_bytes;
+        std::vector<GPUMemoryTagStats> tag_stats_vec;     /* Sorted by size, largest first. */
+        uint64_t                       total_n_bytes;
+
+        GPUMemoryStats()
+            :budget_n_bytes   (0),
+             n_budget_overruns(0),
+             n_bytes_per_type {},
+             peak_n_bytes     (0),
+             total_n_bytes    (0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Registry of live GPU memory allocations. Since GL does not report how much memory the driver actually
+     * reserves, sizes are estimates computed by allocation owners from formats & extents (see Texture::get_n_bytes()).
+     * Texture, DrawBatcher & ParticleSystem register their storage automatically, as does the framework for the
+     * default framebuffer's attachments. Apps which allocate GL objects themselves can register them manually.
+     *
+     * If a budget is set (see FrameworkConfig::gpu_memory_budget_bytes), a warning listing the largest tags is
+     * logged whenever the total crosses it. Useful under Emscripten, where browsers tend to lose the
+     * context instead of failing an allocation once the GPU process runs out of memory.
+     *
+     * All functions are thread-safe.
+     */
+    const char* get_gpu_memory_type_name(const GPUMemoryType& in_type);
+
+    GPUMemoryStats get_gpu_memory_stats();
+
+    /* Tags are grouped by (type, tag) pairs in stats. */
+    GPUMemoryAllocationID register_gpu_memory  (const GPUMemoryType&         in_type,
+                                                const std::string&           in_tag,
+                                                const uint64_t&              in_n_bytes);
+    void                  retag_gpu_memory     (const GPUMemoryAllocationID& in_id,
+                                                const GPUMemoryType&         in_type,
+                                                const std::string&           in_tag);
+    void                  unregister_gpu_memory(const GPUMemoryAllocationID& in_id);
+
+    /* Pass 0 to disable the budget. */
+    void set_gpu_memory_budget(const uint64_t& in_n_bytes);
+
+    /* Draws an ImGui window with a breakdown of GPU memory usage. Should be called from configure_imgui().
+     *
+     * @param inout_opt_is_open_ptr As in ImGui::Begin(). */
+    void draw_gpu_memory_window(bool* inout_opt_is_open_ptr = nullptr);
+}
+
+#endif /* GPU_MEMORY_H */
\ No newline at end of file
@@ -0,0 +1,131 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(HITCH_DETECTOR_H)
+#define HITCH_DETECTOR_H
+
+#include "framework.h"
+#include "gl_instrumentation.h"
+#include "trace.h"
+#include <mutex>
+
+namespace Framework
+{
+    /* Forward decls */
+    class HitchDetector;
+
+    /* Type defs */
+    typedef std::unique_ptr<HitchDetector> HitchDetectorUniquePtr;
+
+    /* Keeps a rolling window of per-frame breakdowns and, whenever a frame takes longer than the configured threshold,
+     * writes breakdowns of that frame and the frames which preceded it to "hitch_<frame index>.txt" in the working
+     * directory. Under Emscripten, they are printed to the console instead.
+     *
+     * Each breakdown lists all zones recorded by all threads (see trace.h), frame counters and, in builds with GL
+     * instrumentation, per-function GL call counts & times. While a detector exists, zones are recorded even if
+     * tracing is disabled. A zone is attributed to the frame during which it ended.
+     *
+     * Once a breakdown has been written, hitches are only counted until the rolling window has been refilled, so that
+     * a single stall does not result in a burst of dumps covering the same frames.
+     */
+    class HitchDetector
+    {
+    public:
+        /* Public functions */
+        static HitchDetectorUniquePtr create(const double&   in_threshold_ms,
+                                             const uint32_t& in_n_history_frames);
+
+        ~HitchDetector();
+
+        /* Time spent before this call (eg. while waiting for events in on-demand rendering mode) does not count
+         * towards the frame. */
+        void begin_frame();
+
+        /* Should be called once the frame has been presented. If GL instrumentation is enabled, per-frame GL call stats
+         * must have been updated by then. */
+        void end_frame();
+
+        uint32_t get_n_hitches() const
+        {
+            return m_n_hitches;
+        }
+
+    private:
+        /* Private type defs */
+        struct Zone
+        {
+            uint64_t    end_ns;
+            uint64_t    n_allocated_bytes;
+            uint64_t    n_allocations;
+            const char* name_ptr;
+            uint64_t    start_ns;
+            uint32_t    thread_index;
+        };
+
+        struct FrameRecord
+        {
+            FrameCounterArray counters;
+            uint64_t          end_ns;
+            uint32_t          n_frame;
+            uint64_t          start_ns;
+            std::vector<Zone> zone_vec;
+
+            #if defined(FRAMEWORK_GL_INSTRUMENTATION)
+                GLCallStatsArray gl_call_stats;
+            #endif
+        };
+
+        /* Private functions */
+        HitchDetector(const double&   in_threshold_ms,
+                      const uint32_t& in_n_history_frames);
+
+        bool init();
+
+        static void on_zone_recorded(const char*     in_name_ptr,
+                                     const uint32_t& in_thread_index,
+                                     const uint64_t& in_start_ns,
+                                     const uint64_t& in_end_ns,
+                                     const uint64_t& in_n_allocations,
+                                     const uint64_t& in_n_allocated_bytes,
+                                     void*           in_user_arg);
+
+        void write_breakdowns(const FrameRecord& in_hitch_frame_record);
+
+        /* Private variables */
+        uint64_t                 m_frame_start_ns;
+        std::vector<FrameRecord> m_frame_record_vec;
+        uint32_t                 m_n_frames_recorded;
+        uint32_t                 m_n_frames_to_next_dump;
+        uint32_t                 m_n_hitches;
+        bool                     m_is_zone_callback_registered;
+        std::vector<Zone>        m_pending_zone_vec;
+        std::mutex               m_pending_zone_vec_mutex;
+
+        const uint32_t m_n_history_frames;
+        const double   m_threshold_ms;
+    };
+}
+
+#endif /* HITCH_DETECTOR_H */
\ No newline at end of file
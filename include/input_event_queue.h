@@ -0,0 +1,96 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(INPUT_EVENT_QUEUE_H)
+#define INPUT_EVENT_QUEUE_H
+
+#include "framework.h"
+
+namespace Framework
+{
+    /* Forward decls */
+    class InputEventQueue;
+
+    /* Type defs */
+    typedef std::unique_ptr<InputEventQueue> InputEventQueueUniquePtr;
+
+    /* Gathers input events over the course of a frame, so that they can be handed over to the app in one batch.
+     *
+     * Consecutive cursor motion events are coalesced into a single one holding the most recent position, and
+     * consecutive scroll events are summed up. Coalesced events keep the time of the oldest event. Events which
+     * change the meaning of subsequent ones (eg. button presses) are never reordered or merged. All storage is
+     * allocated at creation time.
+     *
+     * Once the queue is full, cursor motion & scroll events are dropped, but button, key & character events are
+     * not: room is made for them by merging the oldest cursor motion or scroll event into the next one of the same
+     * type, or by dropping it if there is none. Otherwise, a release lost after a long stall would leave a button
+     * or a key stuck.
+     *
+     * Not thread-safe: events must be pushed from the thread which later calls get_batch() & clear().
+     */
+    class InputEventQueue
+    {
+    public:
+        /* Public functions */
+        static InputEventQueueUniquePtr create(const uint32_t& in_capacity,
+                                               const bool&     in_keep_mouse_motion_history);
+
+        /* Drops all queued events. */
+        void clear()
+        {
+            m_n_events                              = 0;
+            m_n_events_dropped                      = 0;
+            m_n_mouse_motion_history_events         = 0;
+            m_n_mouse_motion_history_events_dropped = 0;
+        }
+
+        /* Returns a batch describing all events queued since the last clear() call. The batch stays valid
+         * until the next push() or clear() call. */
+        InputEventBatch get_batch() const;
+
+        void push(const InputEvent& in_event);
+
+    private:
+        /* Private functions */
+        InputEventQueue(const uint32_t& in_capacity,
+                        const bool&     in_keep_mouse_motion_history);
+
+        /* Removes the oldest MOUSE_POS or SCROLL event from a full queue, see the class description. Returns false
+         * if the queue holds no such event. */
+        bool make_room_for_event();
+
+        /* Private variables */
+        std::vector<InputEvent> m_event_vec;
+        std::vector<InputEvent> m_mouse_motion_history_vec;
+        uint32_t                m_n_events;
+        uint32_t                m_n_events_dropped;
+        uint32_t                m_n_mouse_motion_history_events;
+        uint32_t                m_n_mouse_motion_history_events_dropped;
+
+        const bool m_keep_mouse_motion_history;
+    };
+}
+
+#endif /* INPUT_EVENT_QUEUE_H */
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(INPUT_PLAYER_H)
+#define INPUT_PLAYER_H
+
+#include "framework.h"
+#include "input_event_queue.h"
+#include "input_recorder.h"
+
+namespace Framework
+{
+    /* Forward decls */
+    class InputPlayer;
+
+    /* Type defs */
+    typedef std::unique_ptr<InputPlayer> InputPlayerUniquePtr;
+
+    struct ReplayedFileDrop
+    {
+        std::string          filename;
+        Uint8VectorUniquePtr data_u8_vec_ptr;
+    };
+
+    /* Replays a file written by InputRecorder, one frame at a time. The whole file is loaded at creation time. */
+    class InputPlayer
+    {
+    public:
+        /* Public functions */
+        static InputPlayerUniquePtr create(const std::string& in_filename);
+
+        /* Returns the number of frames held by the recording. */
+        uint32_t get_n_frames() const
+        {
+            return m_n_frames;
+        }
+
+        /* Replays all records of the specified frame. Frames must be replayed in ascending order.
+         *
+         * Input events are pushed to @param in_input_event_queue_ptr. @param inout_framebuffer_width_ptr and
+         * @param inout_framebuffer_height_ptr are overwritten with the most recently recorded framebuffer size.
+         * Replayed file drops are appended to @param out_file_drop_vec_ptr.
+         *
+         * Returns false if the recording is malformed.
+         */
+        bool play_frame(const uint32_t&                in_n_frame,
+                        InputEventQueue*               in_input_event_queue_ptr,
+                        int*                           inout_framebuffer_width_ptr,
+                        int*                           inout_framebuffer_height_ptr,
+                        std::vector<ReplayedFileDrop>* out_file_drop_vec_ptr);
+
+    private:
+        /* Private functions */
+        InputPlayer(const std::string& in_filename);
+
+        bool init();
+        bool read(void*         out_data_ptr,
+                  const size_t& in_size);
+
+        /* Private variables */
+        std::vector<uint8_t> m_data_u8_vec;
+        int                  m_framebuffer_height;
+        int                  m_framebuffer_width;
+        uint32_t             m_n_frames;
+        size_t               m_read_offset;
+
+        const std::string m_filename;
+    };
+}
+
+#endif /* INPUT_PLAYER_H */
\ No newline at end of file
@@ -0,0 +1,116 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(INPUT_RECORDER_H)
+#define INPUT_RECORDER_H
+
+#include "framework.h"
+#include <stdio.h>
+
+namespace Framework
+{
+    /* Forward decls */
+    class InputRecorder;
+
+    /* Type defs */
+    typedef std::unique_ptr<InputRecorder> InputRecorderUniquePtr;
+
+    /* Input recording file format. All values are stored in native byte order.
+     *
+     * Header:  uint32 magic (INPUT_RECORDING_MAGIC), uint32 version (INPUT_RECORDING_VERSION).
+     * Records: uint8 type (InputRecordType), uint32 frame index, followed by a type-specific payload:
+     *
+     * CHAR:             uint32 code point.
+     * END_OF_STREAM:    none. Frame index is the number of frames recorded.
+     * FILE_DROP:        uint32 name length, name, uint32 data size, data.
+     * FRAMEBUFFER_SIZE: int32 width, int32 height.
+     * KEY:              int32 key, int32 action, int32 mods.
+     * MOUSE_BUTTON:     float64 x, float64 y, uint8 button (MouseButton), uint8 is_pressed.
+     * MOUSE_POS:        float64 x, float64 y.
+     * SCROLL:           float64 x offset, float64 y offset.
+     *
+     * Records are stored in ascending frame index order. Input events are stored as received, before coalescing, so
+     * that replays reproduce the mouse motion history as well.
+     */
+    static const uint32_t INPUT_RECORDING_MAGIC   = 0x52495746; /* "FWIR" */
+    static const uint32_t INPUT_RECORDING_VERSION = 2;
+
+    enum class InputRecordType : uint8_t
+    {
+        CHAR,
+        END_OF_STREAM,
+        FILE_DROP,
+        FRAMEBUFFER_SIZE,
+        KEY,
+        MOUSE_BUTTON,
+        MOUSE_POS,
+        SCROLL,
+
+        UNKNOWN
+    };
+
+    /* Writes input received by the app to a file, so that it can be replayed later with InputPlayer. */
+    class InputRecorder
+    {
+    public:
+        /* Public functions */
+        static InputRecorderUniquePtr create(const std::string& in_filename);
+
+        /* Writes the end-of-stream record & closes the file. */
+        ~InputRecorder();
+
+        void record_file_drop       (const uint32_t&             in_n_frame,
+                                     const std::string&          in_filename,
+                                     const std::vector<uint8_t>& in_data_u8_vec);
+        /* Must be called once per frame. Only writes a record if the size differs from the previously recorded one. */
+        void record_framebuffer_size(const uint32_t&             in_n_frame,
+                                     const int&                  in_width,
+                                     const int&                  in_height);
+        /* Must be called for each event as it is pushed to the input event queue. */
+        void record_input_event     (const uint32_t&             in_n_frame,
+                                     const InputEvent&           in_event);
+
+    private:
+        /* Private functions */
+        InputRecorder(const std::string& in_filename);
+
+        bool init();
+
+        void write       (const void*            in_data_ptr,
+                          const size_t&          in_size);
+        void write_header(const InputRecordType& in_type,
+                          const uint32_t&        in_n_frame);
+
+        /* Private variables */
+        FILE*    m_file_ptr;
+        int      m_last_framebuffer_height;
+        int      m_last_framebuffer_width;
+        uint32_t m_n_last_frame;
+
+        const std::string m_filename;
+    };
+}
+
+#endif /* INPUT_RECORDER_H */
\ No newline at end of file
@@ -0,0 +1,296 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(LOG_H)
+#define LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+
+namespace Framework
+{
+    /* Enums */
+    enum class LogArgumentType : uint8_t
+    {
+        DOUBLE,
+        HEAP_STRING,
+        INT,
+        STRING,
+        UINT
+    };
+
+    enum class LogSeverity : uint8_t
+    {
+        DEBUG,
+        INFO,
+        WARNING,
+        ERROR,
+
+        COUNT
+    };
+
+    struct LogArgument
+    {
+        LogArgumentType type;
+
+        union
+        {
+            double   double_value;
+            int64_t  int_value;
+            uint32_t string_offset; /* Into LogRecord::string_data, or into *LogRecord::heap_string_data_ptr for HEAP_STRING
+                                     * arguments. Either holds a zero-terminated copy of the string. */
+            uint64_t uint_value;
+        };
+    };
+
+    /* A message whose formatting has been deferred. Arguments are stored by value, strings are copied. */
+    struct LogRecord
+    {
+        static const uint32_t MAX_ARGUMENTS   = 8;
+        static const uint32_t MAX_STRING_DATA = 192; /* Longer string arguments are truncated, see heap_string_data_ptr. */
+
+        LogArgument  arguments[MAX_ARGUMENTS];
+        const char*  format_ptr;           /* String literal, see log_message(). */
+        std::string* heap_string_data_ptr; /* Only set for the latched error, whose string arguments are never truncated. */
+        uint8_t      n_arguments;
+        uint32_t     n_string_data_bytes_used;
+        LogSeverity  severity;
+        const char*  source_ptr;   /* Must be a string literal. */
+        char         string_data[MAX_STRING_DATA];
+        uint32_t     thread_index; /* See get_trace_thread_index(). */
+        uint64_t     time_ns;      /* See get_trace_time_ns(). */
+    };
+
+    /* Diagnostics log.
+     *
+     * Messages are printf-style format strings, but are only formatted when read, so logging a message never
+     * allocates and costs little more than copying its arguments. Integer, floating-point & string arguments are
+     * supported. Since arguments are formatted according to their actual types, length modifiers in format strings
+     * are ignored.
+     *
+     * Any thread can log. Records are pushed into a fixed-size, lock-free ring, which the framework drains once per
+     * frame into a history of most recent records. Records logged while the ring is full are dropped & counted.
+     * Warnings & errors are echoed to stderr as they are drained.
+     *
+     * The history can be viewed in-app with draw_log_window() or written to disk with save_log().
+     *
+     * Since formatting is deferred, only a pointer to the format string is stored, so format strings must be string
+     * literals. They are taken by const array reference, so passing a pointer (eg. std::string::c_str()) or
+     * a non-const char array along with arguments does not compile. Messages without arguments are copied like
+     * string arguments instead, so they may come from any source & are never interpreted as format strings.
+     */
+    template<size_t N, typename... Args>
+    void log_message(const LogSeverity& in_severity,
+                     const char*        in_source_ptr,
+                     const char         (&in_format)[N],
+                     const Args&...     in_args);
+
+    template<size_t N, typename T, typename... Args>
+    void log_message(const LogSeverity& in_severity,
+                     const char*        in_source_ptr,
+                     char               (&in_format)[N],
+                     const T&           in_arg,
+                     const Args&...     in_args) = delete;
+
+    /* Not a format string. */
+    void log_message(const LogSeverity& in_severity,
+                     const char*        in_source_ptr,
+                     const char*        in_message_ptr);
+
+    /* Logs an error & latches it as the app's fatal error, if none has been reported yet. Once an error is latched,
+     * the framework stops calling into the app and displays the error instead.
+     *
+     * String arguments of the latched error are copied to the heap if they do not fit in the record, so that eg. long
+     * shader info logs are displayed in full. Format strings follow the same rules as for log_message(). */
+    template<size_t N, typename... Args>
+    void report_error(const char     (&in_format)[N],
+                      const Args&... in_args);
+
+    template<size_t N, typename T, typename... Args>
+    void report_error(char           (&in_format)[N],
+                      const T&       in_arg,
+                      const Args&... in_args) = delete;
+
+    /* Not format strings. */
+    void report_error(const char*        in_error_ptr);
+    void report_error(const std::string& in_error);
+
+    /* Draws an ImGui window with the log history. Should be called from configure_imgui().
+     *
+     * @param inout_opt_is_open_ptr As in ImGui::Begin(). */
+    void draw_log_window(bool* inout_opt_is_open_ptr = nullptr);
+
+    /* Returns the number of characters the formatted message would take, excluding the terminator. Output is
+     * truncated to fit @param in_n_max_chars, including the terminator. */
+    size_t format_log_record(const LogRecord& in_record,
+                             const size_t&    in_n_max_chars,
+                             char*            out_text_ptr);
+
+    const char* get_log_severity_name(const LogSeverity& in_severity);
+
+    /* Returns the formatted message of the latched error, or an empty string if no error has been reported. */
+    std::string get_reported_error       ();
+    uint32_t    get_n_dropped_log_records();
+    bool        has_reported_error       ();
+
+    /* Writes the history as text. Returns false if the file could not be written. */
+    bool save_log(const std::string& in_filename);
+
+    /* Used by the framework. Moves records from the ring to the history. */
+    void drain_log();
+
+    /* Used by log_message() & report_error(). */
+    void add_log_argument(LogRecord*         inout_record_ptr,
+                          const char*        in_value_ptr);
+    void add_log_argument(LogRecord*         inout_record_ptr,
+                          const std::string& in_value);
+    void add_log_argument(LogRecord*         inout_record_ptr,
+                          const double&      in_value);
+    void begin_log_record(LogRecord*         out_record_ptr,
+                          const LogSeverity& in_severity,
+                          const char*        in_source_ptr,
+                          const char*        in_format_ptr);
+    bool latch_log_record(LogRecord*         inout_record_ptr);
+    void push_log_record (const LogRecord&   in_record,
+                          const bool&        in_is_latched_error);
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type add_log_argument(LogRecord* inout_record_ptr,
+                                                                                                        const T&   in_value)
+    {
+        if (inout_record_ptr->n_arguments < LogRecord::MAX_ARGUMENTS)
+        {
+            auto& argument = inout_record_ptr->arguments[inout_record_ptr->n_arguments++];
+
+            argument.int_value = static_cast<int64_t>(in_value);
+            argument.type      = LogArgumentType::INT;
+        }
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type add_log_argument(LogRecord* inout_record_ptr,
+                                                                                                         const T&   in_value)
+    {
+        if (inout_record_ptr->n_arguments < LogRecord::MAX_ARGUMENTS)
+        {
+            auto& argument = inout_record_ptr->arguments[inout_record_ptr->n_arguments++];
+
+            argument.type       = LogArgumentType::UINT;
+            argument.uint_value = static_cast<uint64_t>(in_value);
+        }
+    }
+
+    inline void add_log_arguments(LogRecord* inout_record_ptr)
+    {
+        /* Stub */
+    }
+
+    template<typename T, typename... Args>
+    void add_log_arguments(LogRecord*     inout_record_ptr,
+                           const T&       in_arg,
+                           const Args&... in_args)
+    {
+        add_log_argument (inout_record_ptr,
+                          in_arg);
+        add_log_arguments(inout_record_ptr,
+                          in_args...);
+    }
+
+    /* Used by log_message() & report_error(). Messages without arguments are copied into the record as a string
+     * argument of a "%s" format, see log_message(). */
+    template<size_t N, typename... Args>
+    const char* get_log_format(const char     (&in_format)[N],
+                               const Args&... in_args)
+    {
+        return (sizeof...(Args) > 0) ? in_format
+                                     : "%s";
+    }
+
+    template<size_t N>
+    void add_log_message_arguments(LogRecord* inout_record_ptr,
+                                   const char (&in_format)[N])
+    {
+        add_log_argument(inout_record_ptr,
+                         static_cast<const char*>(in_format) );
+    }
+
+    template<size_t N, typename T, typename... Args>
+    void add_log_message_arguments(LogRecord*     inout_record_ptr,
+                                   const char     (&in_format)[N],
+                                   const T&       in_arg,
+                                   const Args&... in_args)
+    {
+        add_log_arguments(inout_record_ptr,
+                          in_arg,
+                          in_args...);
+    }
+
+    template<size_t N, typename... Args>
+    void log_message(const LogSeverity& in_severity,
+                     const char*        in_source_ptr,
+                     const char         (&in_format)[N],
+                     const Args&...     in_args)
+    {
+        LogRecord record;
+
+        begin_log_record         (&record,
+                                  in_severity,
+                                  in_source_ptr,
+                                  get_log_format(in_format,
+                                                 in_args...) );
+        add_log_message_arguments(&record,
+                                  in_format,
+                                  in_args...);
+        push_log_record          (record,
+                                  false); /* in_is_latched_error */
+    }
+
+    template<size_t N, typename... Args>
+    void report_error(const char     (&in_format)[N],
+                      const Args&... in_args)
+    {
+        LogRecord record;
+        bool      is_latched_error = false;
+
+        begin_log_record(&record,
+                         LogSeverity::ERROR,
+                         "report_error",
+                         get_log_format(in_format,
+                                        in_args...) );
+
+        /* Must be called before arguments are added, so that string arguments of the latched error can spill to the heap. */
+        is_latched_error = latch_log_record(&record);
+
+        add_log_message_arguments(&record,
+                                  in_format,
+                                  in_args...);
+        push_log_record          (record,
+                                  is_latched_error);
+    }
+}
+
+#endif /* LOG_H */
\ No newline at end of file
@@ -0,0 +1,121 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(OCCLUSION_QUERY_POOL_H)
+#define OCCLUSION_QUERY_POOL_H
+
+#include "framework.h"
+
+namespace Framework
+{
+    /* Forward decls */
+    class OcclusionQueryPool;
+
+    /* Type defs */
+    typedef std::unique_ptr<OcclusionQueryPool> OcclusionQueryPoolUniquePtr;
+
+    /* Manages GL_ANY_SAMPLES_PASSED_CONSERVATIVE queries for a fixed number of objects.
+     *
+     * Each object owns a small ring of query objects. A new query can be issued for an object every frame,
+     * while results of earlier queries are only harvested once GL reports them as available. This means
+     * visibility information is typically one or two frames late, but glGetQueryObjectuiv(GL_QUERY_RESULT)
+     * is never called for a query whose result is not ready yet, so the CPU never waits for the GPU.
+     *
+     * Typical usage per frame:
+     *
+     * 1. Call poll_results().
+     * 2. For each object, call begin_query(), draw either the object (if is_visible() returns true)
+     *    or a cheap proxy (eg. bounding box with color & depth writes disabled), then call end_query().
+     */
+    class OcclusionQueryPool
+    {
+    public:
+        /* Public functions */
+        static OcclusionQueryPoolUniquePtr create(const uint32_t& in_n_objects,
+                                                  const uint32_t& in_n_queries_per_object = 3);
+
+        ~OcclusionQueryPool();
+
+        /* Starts an occlusion query for the specified object.
+         *
+         * Returns false if all queries in the object's ring are still in flight. No query is started
+         * in such case, and end_query() must not be called.
+         */
+        bool begin_query(const uint32_t& in_n_object);
+        void end_query  ();
+
+        /* Returns the number of frames which passed since the most recent result for the specified object
+         * was issued, or UINT32_MAX if no result has been harvested for the object yet. */
+        uint32_t get_result_age(const uint32_t& in_n_object) const;
+
+        /* Returns the most recent visibility information harvested for the specified object.
+         *
+         * Objects are considered visible until the first result becomes available.
+         */
+        bool is_visible(const uint32_t& in_n_object) const;
+
+        /* Harvests results of all queries which have completed on the GPU without blocking on those
+         * which have not. Should be called once per frame, before any begin_query() call is made. */
+        void poll_results();
+
+    private:
+        /* Private type defs */
+        struct ObjectRing
+        {
+            uint32_t n_frame_last_result_issued;
+            uint32_t n_oldest_query;
+            uint32_t n_pending_queries;
+            bool     visible;
+
+            ObjectRing()
+                :n_frame_last_result_issued(UINT32_MAX),
+                 n_oldest_query            (0),
+                 n_pending_queries         (0),
+                 visible                   (true)
+            {
+                /* Stub */
+            }
+        };
+
+        /* Private functions */
+        OcclusionQueryPool(const uint32_t& in_n_objects,
+                           const uint32_t& in_n_queries_per_object);
+
+        bool init();
+
+        /* Private variables */
+        uint32_t m_n_active_object;
+        uint32_t m_n_current_frame;
+
+        std::vector<ObjectRing> m_object_ring_vec;
+        std::vector<uint32_t>   m_query_frame_vec;
+        std::vector<GLuint>     m_query_id_vec;
+
+        const uint32_t m_n_objects;
+        const uint32_t m_n_queries_per_object;
+    };
+}
+
+#endif /* OCCLUSION_QUERY_POOL_H */
\ No newline at end of file
@@ -0,0 +1,179 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(PARTICLE_SYSTEM_H)
+#define PARTICLE_SYSTEM_H
+
+#include "framework.h"
+#include "gpu_memory.h"
+#include "program.h"
+#include "shader.h"
+#include <array>
+
+namespace Framework
+{
+    /* Forward decls */
+    class ParticleSystem;
+
+    /* Type defs */
+    typedef std::unique_ptr<ParticleSystem> ParticleSystemUniquePtr;
+
+    /* GPU-resident particle system which relies on transform feedback, so that it also runs under WebGL2
+     * which lacks compute shaders.
+     *
+     * Particle state lives in two buffers which are ping-ponged every update. Each particle takes 32 bytes:
+     *
+     * - location 0: vec4 (position.xyz, age)
+     * - location 1: vec4 (velocity.xyz, lifetime)
+     *
+     * A particle is considered dead if its age is larger than or equal to its lifetime.
+     *
+     * Emission is folded into the update pass: particles are (re)spawned in ring order, so requesting N
+     * particles to be emitted replaces the N particles which were spawned the longest time ago.
+     *
+     * A custom render program can be provided at creation time. It needs to consume the attributes listed
+     * above. u_view_projection (mat4) and u_point_size (float) uniforms are set, if present.
+     */
+    class ParticleSystem
+    {
+    public:
+        /* Public functions */
+        static ParticleSystemUniquePtr create(const uint32_t& in_n_max_particles,
+                                              const Program*  in_opt_render_program_ptr = nullptr);
+
+        ~ParticleSystem();
+
+        /* Returns ID of a VAO which sources particle data updated by the most recent update() call. */
+        GLuint get_current_vao_id() const
+        {
+            return m_vao_ids.at(m_n_current_buffer);
+        }
+
+        uint32_t get_n_max_particles() const
+        {
+            return m_n_max_particles;
+        }
+
+        /* Draws all particles as point sprites. Blending state is left for the caller to configure. */
+        void render(const std::array<float, 16>& in_view_projection_matrix,
+                    const float&                 in_point_size);
+
+        void set_emitter(const std::array<float, 3>& in_position,
+                         const std::array<float, 3>& in_velocity,
+                         const float&                in_velocity_spread,
+                         const float&                in_lifetime);
+        void set_gravity(const std::array<float, 3>& in_gravity);
+
+        /* Advances the simulation by @param in_delta_time seconds and emits up to @param in_n_particles_to_emit
+         * new particles using the current emitter settings. Runs entirely on the GPU. */
+        void update(const float&    in_delta_time,
+                    const uint32_t& in_n_particles_to_emit);
+
+    private:
+        /* Private type defs */
+
+        /* Uniform locations are looked up once the programs are linked, so that no string lookups are made
+         * per frame. Uniforms which are not active are left at -1, which glUniform*() calls silently ignore. */
+        struct RenderUniformLocations
+        {
+            GLint point_size;
+            GLint view_projection;
+
+            RenderUniformLocations()
+                :point_size     (-1),
+                 view_projection(-1)
+            {
+                /* Stub */
+            }
+        };
+
+        struct UpdateUniformLocations
+        {
+            GLint delta_time;
+            GLint emit_count;
+            GLint emit_start;
+            GLint emitter_lifetime;
+            GLint emitter_position;
+            GLint emitter_velocity;
+            GLint emitter_velocity_spread;
+            GLint gravity;
+            GLint n_max_particles;
+            GLint seed;
+
+            UpdateUniformLocations()
+                :delta_time             (-1),
+                 emit_count             (-1),
+                 emit_start             (-1),
+                 emitter_lifetime       (-1),
+                 emitter_position       (-1),
+                 emitter_velocity       (-1),
+                 emitter_velocity_spread(-1),
+                 gravity                (-1),
+                 n_max_particles        (-1),
+                 seed                   (-1)
+            {
+                /* Stub */
+            }
+        };
+
+        /* Private functions */
+        ParticleSystem(const uint32_t& in_n_max_particles,
+                       const Program*  in_opt_render_program_ptr);
+
+        bool init();
+
+        /* Private variables */
+        std::array<GLuint, 2> m_buffer_ids;
+        std::array<GLuint, 2> m_tf_ids;
+        std::array<GLuint, 2> m_vao_ids;
+
+        std::array<float, 3> m_emitter_position;
+        std::array<float, 3> m_emitter_velocity;
+        float                m_emitter_lifetime;
+        float                m_emitter_velocity_spread;
+        std::array<float, 3> m_gravity;
+
+        GPUMemoryAllocationID m_gpu_memory_id;
+
+        uint32_t m_n_current_buffer;
+        uint32_t m_n_emit_cursor;
+        uint32_t m_n_updates;
+
+        RenderUniformLocations m_render_uniform_locations;
+        UpdateUniformLocations m_update_uniform_locations;
+
+        ProgramUniquePtr m_default_render_program_ptr;
+        ShaderUniquePtr  m_default_render_fs_ptr;
+        ShaderUniquePtr  m_default_render_vs_ptr;
+        ProgramUniquePtr m_update_program_ptr;
+        ShaderUniquePtr  m_update_fs_ptr;
+        ShaderUniquePtr  m_update_vs_ptr;
+
+        const uint32_t m_n_max_particles;
+        const Program* m_render_program_ptr;
+    };
+}
+
+#endif /* PARTICLE_SYSTEM_H */
\ No newline at end of file
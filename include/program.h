@@ -28,7 +28,6 @@
 
 #include "framework.h"
 #include "shader.h"
-#include <unordered_map>
 
 namespace Framework
 {
@@ -43,11 +42,20 @@ namespace Framework
         static ProgramUniquePtr create(const Shader* in_vs_ptr,
                                        const Shader* in_fs_ptr);
 
+        /* Creates a program whose vertex shader outputs listed in @param in_tf_varyings are captured
+         * with transform feedback. @param in_tf_buffer_mode should be either GL_INTERLEAVED_ATTRIBS or
+         * GL_SEPARATE_ATTRIBS. */
+        static ProgramUniquePtr create(const Shader*                   in_vs_ptr,
+                                       const Shader*                   in_fs_ptr,
+                                       const std::vector<std::string>& in_tf_varyings,
+                                       const GLenum&                   in_tf_buffer_mode = GL_INTERLEAVED_ATTRIBS);
+
         GLuint get_id() const
         {
             return m_id;
         }
 
+        /* Does not allocate, so it is safe to call from no-allocation scopes. */
         GLint get_uniform_location(const char*        in_uniform_name_ptr) const;
         GLint get_uniform_location(const std::string& in_uniform_name)     const
         {
@@ -57,18 +65,33 @@ namespace Framework
         ~Program();
 
     private:
+        /* Private type defs */
+        struct Uniform
+        {
+            GLint       location;
+            std::string name;
+        };
+
         /* Private functions */
-        Program(const Shader* in_vs_ptr,
-                const Shader* in_fs_ptr);
+        Program(const Shader*                   in_vs_ptr,
+                const Shader*                   in_fs_ptr,
+                const std::vector<std::string>& in_tf_varyings,
+                const GLenum&                   in_tf_buffer_mode);
 
         bool init();
 
+        static bool is_less(const Uniform& in_uniform,
+                            const char*    in_name_ptr);
+
         /* Private Variables */
-        GLuint                                 m_id;
-        std::unordered_map<std::string, GLint> m_uniform_name_to_id_map;
+        GLuint               m_id;
+        std::vector<Uniform> m_uniform_vec; /* Sorted by name, so that lookups need not construct a std::string. */
 
         const Shader* m_fs_ptr;
         const Shader* m_vs_ptr;
+
+        const GLenum                   m_tf_buffer_mode;
+        const std::vector<std::string> m_tf_varyings;
     };
 }
 
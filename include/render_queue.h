@@ -0,0 +1,179 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(RENDER_QUEUE_H)
+#define RENDER_QUEUE_H
+
+#include "framework.h"
+#include "program.h"
+#include "texture.h"
+#include <array>
+
+namespace Framework
+{
+    /* Forward decls */
+    class RenderQueue;
+
+    /* Type defs */
+    typedef std::unique_ptr<RenderQueue> RenderQueueUniquePtr;
+
+    /* Called right before a queued draw is issued, after its program has been bound. Can be used to update
+     * per-draw uniforms. */
+    typedef void (*PFNQUEUEDDRAWUNIFORMSETTERPROC)(const Program* in_program_ptr,
+                                                   const void*    in_user_arg);
+
+    struct QueuedDraw
+    {
+        static const uint32_t N_MAX_TEXTURES = 4;
+
+        /* Packed sort key, as returned by RenderQueue::make_sort_key(). Draws are executed in ascending key order. */
+        uint64_t sort_key;
+
+        uint32_t       first;
+        GLenum         index_type; /* GL_NONE for non-indexed draws */
+        GLenum         mode;
+        uint32_t       n_elements;
+        const Program* program_ptr;
+        GLuint         vao_id;
+
+        /* Texture at index N is bound to texture unit N. Unused entries must be set to nullptr. */
+        std::array<const Texture*, N_MAX_TEXTURES> texture_ptrs;
+
+        PFNQUEUEDDRAWUNIFORMSETTERPROC uniform_setter_func_ptr;
+        const void*                    uniform_setter_user_arg;
+
+        QueuedDraw()
+            :sort_key               (0),
+             first                  (0),
+             index_type             (GL_NONE),
+             mode                   (GL_TRIANGLES),
+             n_elements             (0),
+             program_ptr            (nullptr),
+             vao_id                 (0),
+             uniform_setter_func_ptr(nullptr),
+             uniform_setter_user_arg(nullptr)
+        {
+            texture_ptrs.fill(nullptr);
+        }
+    };
+
+    struct RenderQueueStats
+    {
+        uint32_t n_draws;
+        uint32_t n_program_changes;
+        uint32_t n_radix_passes;
+        double   sort_time_ms;
+        uint32_t n_texture_changes;
+        uint32_t n_vao_changes;
+
+        RenderQueueStats()
+            :n_draws          (0),
+             n_program_changes(0),
+             n_radix_passes   (0),
+             sort_time_ms     (0.0),
+             n_texture_changes(0),
+             n_vao_changes    (0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Collects draws over the course of a frame, sorts them by a packed 64-bit key and executes them in that order,
+     * skipping glUseProgram(), glBindVertexArray() and glBindTexture() calls which would not change any state.
+     *
+     * Keys are sorted with an 8-bit LSD radix sort. Histograms for all digits are built in a single pass over
+     * the keys, and passes for digits which are the same for all keys are skipped. All storage is retained
+     * between frames, so the queue does not allocate in steady state.
+     */
+    class RenderQueue
+    {
+    public:
+        /* Public functions */
+        static RenderQueueUniquePtr create(const uint32_t& in_n_draws_to_preallocate);
+
+        /* Packs draw properties into a sort key. Bit layout, from the most significant bit:
+         *
+         * [63:56] layer    (8 bits)  - eg. opaque, transparent, UI.
+         * [55:44] program  (12 bits) - small app-assigned program index.
+         * [43:24] material (20 bits) - app-assigned material (texture set) index.
+         * [23:0]  depth    (24 bits) - @param in_normalized_depth quantized to 24 bits. If @param in_back_to_front
+         *                              is true, the depth is inverted so that farther draws are executed first.
+         *
+         * Values exceeding their bit ranges are masked.
+         */
+        static uint64_t make_sort_key(const uint8_t&  in_layer,
+                                      const uint32_t& in_program_index,
+                                      const uint32_t& in_material_index,
+                                      const float&    in_normalized_depth,
+                                      const bool&     in_back_to_front = false);
+
+        /* Drops all enqueued draws without executing them. */
+        void clear()
+        {
+            m_draw_vec.clear     ();
+            m_sort_item_vec.clear();
+        }
+
+        void enqueue(const QueuedDraw& in_draw)
+        {
+            /* Keys are also stored in a compact array, so that sorting does not need to touch draw descriptors. */
+            m_sort_item_vec.push_back(SortItem{in_draw.sort_key, static_cast<uint32_t>(m_draw_vec.size() )});
+            m_draw_vec.push_back     (in_draw);
+        }
+
+        /* Sorts & issues all draws enqueued since the last call, then empties the queue. */
+        void execute();
+
+        /* Returns stats gathered by the most recent execute() call. */
+        const RenderQueueStats& get_stats() const
+        {
+            return m_stats;
+        }
+
+        /* Sorts enqueued draws without executing them. Exposed so that CPU cost of sorting can be measured separately
+         * from GL submission. Returns draw indices in execution order. */
+        const std::vector<uint32_t>& sort();
+
+    private:
+        /* Private type defs */
+        struct SortItem
+        {
+            uint64_t key;
+            uint32_t n_draw;
+        };
+
+        /* Private functions */
+        RenderQueue(const uint32_t& in_n_draws_to_preallocate);
+
+        /* Private variables */
+        std::vector<QueuedDraw> m_draw_vec;
+        std::vector<uint32_t>   m_sorted_draw_index_vec;
+        std::vector<SortItem>   m_sort_item_vec;
+        std::vector<SortItem>   m_sort_item_temp_vec;
+        RenderQueueStats        m_stats;
+    };
+}
+
+#endif /* RENDER_QUEUE_H */
\ No newline at end of file
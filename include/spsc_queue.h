@@ -0,0 +1,100 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(SPSC_QUEUE_H)
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+
+namespace Framework
+{
+    /* Fixed-capacity, lock-free queue for passing items from exactly one producer thread to exactly one
+     * consumer thread. @param N_CAPACITY must be a power of two. No allocations are made after construction. */
+    template<typename T, uint32_t N_CAPACITY>
+    class SPSCQueue
+    {
+        static_assert((N_CAPACITY & (N_CAPACITY - 1)) == 0, "SPSCQueue capacity must be a power of two.");
+
+    public:
+        /* Public functions */
+        SPSCQueue()
+            :m_n_read (0),
+             m_n_write(0)
+        {
+            /* Stub */
+        }
+
+        /* Consumer thread only. Returns false if the queue is empty. */
+        bool pop(T* out_item_ptr)
+        {
+            const uint32_t n_read = m_n_read.load(std::memory_order_relaxed);
+            bool           result = false;
+
+            if (n_read != m_n_write.load(std::memory_order_acquire) )
+            {
+                *out_item_ptr = m_items[n_read & (N_CAPACITY - 1)];
+
+                m_n_read.store(n_read + 1,
+                               std::memory_order_release);
+
+                result = true;
+            }
+
+            return result;
+        }
+
+        /* Producer thread only. Returns false if the queue is full, in which case the item is not enqueued. */
+        bool push(const T& in_item)
+        {
+            const uint32_t n_write = m_n_write.load(std::memory_order_relaxed);
+            bool           result  = false;
+
+            if (n_write - m_n_read.load(std::memory_order_acquire) < N_CAPACITY)
+            {
+                m_items[n_write & (N_CAPACITY - 1)] = in_item;
+
+                m_n_write.store(n_write + 1,
+                                std::memory_order_release);
+
+                result = true;
+            }
+
+            return result;
+        }
+
+    private:
+        /* Private variables */
+        std::array<T, N_CAPACITY> m_items;
+
+        /* Read & write counters are kept on separate cache lines so that producer and consumer do not
+         * keep invalidating each other's caches. */
+        alignas(64) std::atomic<uint32_t> m_n_read;
+        alignas(64) std::atomic<uint32_t> m_n_write;
+    };
+}
+
+#endif /* SPSC_QUEUE_H */
\ No newline at end of file
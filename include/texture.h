@@ -27,6 +27,7 @@
 #define TEXTURE_H
 
 #include "framework.h"
+#include "gpu_memory.h"
 #include <array>
 
 namespace Framework
@@ -129,6 +130,18 @@ namespace Framework
         UNKNOWN
     };
 
+    /* Describes how texels of a given format are laid out in memory. Uncompressed formats use 1x1 blocks. */
+    struct TextureFormatInfo
+    {
+        uint32_t block_height;
+        uint32_t block_width;
+        uint32_t n_bytes_per_block;
+    };
+
+    /* Returns a zeroed out structure for TextureFormat::UNKNOWN. Three-component formats are assumed not to be padded,
+     * even though most drivers store them with an extra component. */
+    TextureFormatInfo get_texture_format_info(const TextureFormat& in_format);
+
     class Texture
     {
     public:
@@ -150,8 +163,17 @@ namespace Framework
         ~Texture();
 
         GLuint                  get_id      ()                         const;
-        TextureType             get_type    ()                         const;
         std::array<uint32_t, 3> get_mip_size(const uint32_t& in_n_mip) const;
+        GLenum                  get_target  ()                         const;
+        TextureType             get_type    ()                         const;
+
+        /* Returns the estimated amount of memory taken by all mips of the texture. */
+        uint64_t get_n_bytes() const;
+
+        /* Textures are registered with the GPU memory registry as GPUMemoryType::TEXTURE, tagged "Texture". This call
+         * lets the app attribute the texture to a more specific tag, or mark it as a render target. */
+        void set_gpu_memory_tag(const GPUMemoryType& in_type,
+                                const std::string&   in_tag);
 
     private:
 
@@ -168,9 +190,11 @@ namespace Framework
         const TextureFormat           m_format;
         const TextureType             m_type;
 
+        GPUMemoryAllocationID                 m_gpu_memory_id;
         GLuint                                m_id;
         std::vector<std::array<uint32_t, 3> > m_mip_size_vec;
         uint32_t                              m_n_mips;
+        GLenum                                m_target;
     };
 }
 #endif /* TEXTURE_H */
\ No newline at end of file
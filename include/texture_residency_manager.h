@@ -0,0 +1,158 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(TEXTURE_RESIDENCY_MANAGER_H)
+#define TEXTURE_RESIDENCY_MANAGER_H
+
+#include "framework.h"
+#include "texture.h"
+
+namespace Framework
+{
+    /* Forward decls */
+    class TextureResidencyManager;
+
+    /* Type defs */
+    typedef uint32_t                                 TextureResidencyHandle;
+    typedef std::unique_ptr<TextureResidencyManager> TextureResidencyManagerUniquePtr;
+
+    /* Invoked whenever a texture needs to be (re)loaded. Should create the texture without its @param in_n_skipped_mips
+     * largest mips (eg. by loading a downscaled version of the image) and fill it with data.
+     *
+     * Returning nullptr marks the load as failed. Another attempt is then made on next use. */
+    typedef TextureUniquePtr (*PFNTEXTURELOADPROC)(const uint32_t& in_n_skipped_mips,
+                                                   void*           in_user_arg);
+
+    struct TextureResidencyStats
+    {
+        uint32_t n_degradations;
+        uint32_t n_evictions;
+        uint32_t n_loads;
+        uint32_t n_resident_textures;
+        uint64_t resident_n_bytes;
+
+        TextureResidencyStats()
+            :n_degradations     (0),
+             n_evictions        (0),
+             n_loads            (0),
+             n_resident_textures(0),
+             resident_n_bytes   (0)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Keeps the total size of registered textures within a memory budget.
+     *
+     * Textures are registered together with a loader, which is used to (re)create them on demand. A texture is
+     * loaded at full resolution when first used. Whenever the resident textures exceed the budget, textures are
+     * released in order of increasing priority and, within a priority, least recent use. A texture which has been
+     * registered with a non-zero number of degradable mips is first reloaded without these mips, and only evicted
+     * altogether if the budget is exceeded again. Degraded & evicted textures are restored at full resolution the
+     * next time they are used.
+     *
+     * Textures used during the current frame are never released, so the budget may be exceeded if a single frame
+     * needs more memory than it allows.
+     *
+     * Texture pointers returned by use() remain valid until end_frame() is called, or until the texture is
+     * unregistered.
+     *
+     * All functions must be called from the thread which owns the GL context.
+     */
+    class TextureResidencyManager
+    {
+    public:
+        /* Public functions */
+        static TextureResidencyManagerUniquePtr create(const uint64_t& in_budget_n_bytes);
+
+        ~TextureResidencyManager();
+
+        /* Should be called once per frame, after all textures used by the frame have been used. */
+        void end_frame();
+
+        const TextureResidencyStats& get_stats() const
+        {
+            return m_stats;
+        }
+
+        /* Does not load the texture. Textures with higher priorities are released after those with lower ones.
+         *
+         * @param in_n_degradable_mips Number of mips which may be dropped before the texture is evicted. */
+        TextureResidencyHandle register_texture  (PFNTEXTURELOADPROC            in_load_func_ptr,
+                                                  void*                         in_user_arg,
+                                                  const uint32_t&               in_priority,
+                                                  const uint32_t&               in_n_degradable_mips = 0);
+        void                   unregister_texture(const TextureResidencyHandle& in_handle);
+
+        void set_budget(const uint64_t& in_budget_n_bytes);
+
+        /* Marks the texture as used during the current frame, (re)loading it at full resolution if needed, and returns
+         * it. Returns nullptr if the texture could not be loaded. */
+        const Texture* use(const TextureResidencyHandle& in_handle);
+
+    private:
+        /* Private type defs */
+        struct Entry
+        {
+            bool               is_registered;
+            void*              load_func_user_arg;
+            PFNTEXTURELOADPROC load_func_ptr;
+            uint32_t           n_degradable_mips;
+            uint32_t           n_frame_last_used;
+            uint32_t           n_skipped_mips;
+            uint32_t           priority;
+            TextureUniquePtr   texture_ptr;
+
+            Entry()
+                :is_registered     (false),
+                 load_func_user_arg(nullptr),
+                 load_func_ptr     (nullptr),
+                 n_degradable_mips (0),
+                 n_frame_last_used (UINT32_MAX),
+                 n_skipped_mips    (0),
+                 priority          (0)
+            {
+                /* Stub */
+            }
+        };
+
+        /* Private functions */
+        TextureResidencyManager(const uint64_t& in_budget_n_bytes);
+
+        bool load   (Entry*          in_entry_ptr,
+                     const uint32_t& in_n_skipped_mips);
+        void release(Entry*          in_entry_ptr);
+        void trim   ();
+
+        /* Private variables */
+        uint64_t                            m_budget_n_bytes;
+        std::vector<Entry>                  m_entry_vec;
+        std::vector<TextureResidencyHandle> m_free_handle_vec;
+        uint32_t                            m_n_current_frame;
+        TextureResidencyStats               m_stats;
+    };
+}
+
+#endif /* TEXTURE_RESIDENCY_MANAGER_H */
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#if !defined(TRACE_H)
+#define TRACE_H
+
+#include "allocation_tracker.h"
+#include "framework.h"
+#include <array>
+
+#define FRAMEWORK_TRACE_CONCAT_IMPL(a, b) a##b
+#define FRAMEWORK_TRACE_CONCAT(a, b)      FRAMEWORK_TRACE_CONCAT_IMPL(a, b)
+
+/* Records a CPU zone spanning the rest of the enclosing scope. @param name must be a string literal. */
+#define FRAMEWORK_TRACE_SCOPE(name)     Framework::TraceScope    FRAMEWORK_TRACE_CONCAT(trace_scope_,     __LINE__)(name)
+
+/* Records a GPU zone spanning GL commands issued in the rest of the enclosing scope. @param name must be a string literal. */
+#define FRAMEWORK_TRACE_GPU_SCOPE(name) Framework::GPUTraceScope FRAMEWORK_TRACE_CONCAT(gpu_trace_scope_, __LINE__)(name)
+
+namespace Framework
+{
+    /* Enums */
+    enum class FrameCounter : uint8_t
+    {
+        ALLOCATED_BYTES, /* Only counted in builds with allocation tracking, see allocation_tracker.h. */
+        N_ALLOCATIONS,   /* Only counted in builds with allocation tracking, see allocation_tracker.h. */
+        UPLOADED_BYTES,  /* Buffer & texture data uploaded by the framework. Apps can add their own uploads. */
+
+        COUNT
+    };
+
+    /* Type defs */
+    typedef std::array<uint64_t, static_cast<uint32_t>(FrameCounter::COUNT)> FrameCounterArray; /* Indexed by FrameCounter. */
+
+    /* Invoked for each zone recorded by any thread, from the thread which recorded it. */
+    typedef void (*PFNTRACEZONECALLBACKPROC)(const char*     in_name_ptr,
+                                             const uint32_t& in_thread_index,
+                                             const uint64_t& in_start_ns,
+                                             const uint64_t& in_end_ns,
+                                             const uint64_t& in_n_allocations,
+                                             const uint64_t& in_n_allocated_bytes,
+                                             void*           in_user_arg);
+
+    /* Zone tracing, enabled by running the app with "--trace <filename>". Zones recorded until shutdown are then
+     * written to the specified file as Chrome trace JSON, which can be loaded into Perfetto or chrome://tracing.
+     *
+     * Each thread records into its own preallocated buffer, so recording a zone takes no locks & does not allocate.
+     * Once a thread's buffer fills up, further zones recorded by that thread are dropped. When neither tracing nor
+     * a zone callback is enabled, a zone only costs a couple of relaxed atomic loads & thread-local stores.
+     *
+     * GPU zones are measured with GL_EXT_disjoint_timer_query and shown on a separate "GPU" track. Since the GPU
+     * clock cannot be related to the CPU clock, a GPU zone is drawn starting at the time it was submitted, or when
+     * the preceding GPU zone ended if that happened later, and lasts as long as the GPU took to execute it. GPU
+     * zones cannot be nested, must be recorded on the thread which owns the GL context, and are only supported on
+     * native builds.
+     *
+     * Zone names are stored by pointer, so they must remain valid until shutdown.
+     */
+
+    /* Thread-safe. */
+    void add_to_frame_counter(const FrameCounter& in_counter,
+                              const uint64_t&     in_delta);
+
+    /* Returns the name of the innermost CPU zone open on the calling thread, or nullptr if there is none. Zones are
+     * tracked even if they are not being recorded. */
+    const char* get_current_trace_zone_name();
+
+    const char* get_frame_counter_name(const FrameCounter& in_counter);
+
+    /* Returns a small, process-unique index of the calling thread. 0 is reserved for the GPU track. */
+    uint32_t get_trace_thread_index();
+
+    /* Returns the time elapsed since startup, in nanoseconds. */
+    uint64_t get_trace_time_ns();
+
+    /* Returns true if zones are being recorded, either for a trace or for a zone callback. */
+    bool is_zone_recording_enabled();
+
+    bool is_tracing_enabled();
+
+    /* Records a CPU zone on the calling thread. Prefer FRAMEWORK_TRACE_SCOPE over calling this directly.
+     *
+     * @param in_n_allocations and @param in_n_allocated_bytes describe heap allocations made within the zone. */
+    void record_trace_zone(const char*     in_name_ptr,
+                           const uint64_t& in_start_ns,
+                           const uint64_t& in_end_ns,
+                           const uint64_t& in_n_allocations     = 0,
+                           const uint64_t& in_n_allocated_bytes = 0);
+
+    /* Used by TraceScope. Returns the previous name. */
+    const char* set_current_trace_zone_name(const char* in_name_ptr);
+
+    /* Names the calling thread's track in exported traces. */
+    void set_trace_thread_name(const char* in_name_ptr);
+
+    /* Prefer FRAMEWORK_TRACE_GPU_SCOPE over calling these directly. */
+    void begin_gpu_trace_zone(const char* in_name_ptr);
+    void end_gpu_trace_zone  ();
+
+    /* Used by the framework. */
+    void end_trace_frame               ();
+    void fetch_and_reset_frame_counters(FrameCounterArray* out_values_ptr);
+    void release_trace_gl_objects      ();
+    void start_tracing                 (const uint32_t&    in_n_max_zones_per_thread);
+    bool stop_tracing_and_save         (const std::string& in_filename);
+
+    /* Used by the framework. Enables zone recording even if tracing is disabled. Pass nullptr to unregister. Must
+     * not be called while another callback is registered. A callback may still be running on another thread right
+     * after it has been unregistered, so its user arg must outlive all threads which record zones. */
+    void set_trace_zone_callback(PFNTRACEZONECALLBACKPROC in_func_ptr,
+                                 void*                    in_user_arg);
+
+    class TraceScope
+    {
+    public:
+        /* Public functions */
+        explicit TraceScope(const char* in_name_ptr)
+            :m_name_ptr               (is_zone_recording_enabled() ? in_name_ptr : nullptr),
+             m_parent_zone_name_ptr   (set_current_trace_zone_name(in_name_ptr) ),
+             m_start_n_allocated_bytes(get_thread_n_allocated_bytes() ),
+             m_start_n_allocations    (get_thread_n_allocations    () ),
+             m_start_ns               ((m_name_ptr != nullptr) ? get_trace_time_ns() : 0)
+        {
+            /* Stub */
+        }
+
+        ~TraceScope()
+        {
+            set_current_trace_zone_name(m_parent_zone_name_ptr);
+
+            if (m_name_ptr != nullptr)
+            {
+                record_trace_zone(m_name_ptr,
+                                  m_start_ns,
+                                  get_trace_time_ns           (),
+                                  get_thread_n_allocations    () - m_start_n_allocations,
+                                  get_thread_n_allocated_bytes() - m_start_n_allocated_bytes);
+            }
+        }
+
+    private:
+        /* Private variables */
+        const char*    m_name_ptr;
+        const char*    m_parent_zone_name_ptr;
+        const uint64_t m_start_n_allocated_bytes;
+        const uint64_t m_start_n_allocations;
+        const uint64_t m_start_ns;
+    };
+
+    class GPUTraceScope
+    {
+    public:
+        /* Public functions */
+        explicit GPUTraceScope(const char* in_name_ptr)
+        {
+            begin_gpu_trace_zone(in_name_ptr);
+        }
+
+        ~GPUTraceScope()
+        {
+            end_gpu_trace_zone();
+        }
+    };
+}
+
+#endif /* TRACE_H */
\ No newline at end of file
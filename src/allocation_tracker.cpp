@@ -0,0 +1,213 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "allocation_tracker.h"
+
+#if defined(FRAMEWORK_ALLOCATION_TRACKING)
+
+#include "trace.h"
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Operator new may be invoked during static initialization, so all of these must be constant-initialized. */
+static std::atomic<uint64_t> g_n_allocated_bytes                (0);
+static std::atomic<uint64_t> g_n_allocations                    (0);
+static std::atomic<uint64_t> g_n_no_allocation_scope_violations (0);
+static thread_local bool     t_is_reporting_violation           = false;
+static thread_local uint64_t t_n_allocated_bytes                = 0;
+static thread_local uint64_t t_n_allocations                    = 0;
+static thread_local uint32_t t_n_no_allocation_scopes           = 0;
+
+static void on_allocation(const size_t& in_size)
+{
+    g_n_allocated_bytes.fetch_add(in_size,
+                                  std::memory_order_relaxed);
+    g_n_allocations.fetch_add    (1,
+                                  std::memory_order_relaxed);
+
+    Framework::add_to_frame_counter(Framework::FrameCounter::ALLOCATED_BYTES,
+                                    in_size);
+    Framework::add_to_frame_counter(Framework::FrameCounter::N_ALLOCATIONS,
+                                    1);
+
+    t_n_allocated_bytes += in_size;
+    t_n_allocations     += 1;
+
+    if (t_n_no_allocation_scopes > 0 &&
+        !t_is_reporting_violation)
+    {
+        /* Guards against reentrancy, should reporting allocate by itself. */
+        t_is_reporting_violation = true;
+        {
+            g_n_no_allocation_scope_violations.fetch_add(1,
+                                                         std::memory_order_relaxed);
+
+            fprintf(stderr,
+                    "Heap allocation of %llu byte(s) made inside a no-allocation scope.\n",
+                    static_cast<unsigned long long>(in_size) );
+
+            assert(false);
+        }
+        t_is_reporting_violation = false;
+    }
+}
+
+static void* allocate(const size_t& in_size)
+{
+    void* result_ptr = ::malloc((in_size > 0) ? in_size : 1);
+
+    if (result_ptr != nullptr)
+    {
+        on_allocation(in_size);
+    }
+
+    return result_ptr;
+}
+
+static void* allocate_or_throw(const size_t& in_size)
+{
+    void* result_ptr = allocate(in_size);
+
+    if (result_ptr == nullptr)
+    {
+        #if defined(__cpp_exceptions)
+        {
+            throw std::bad_alloc();
+        }
+        #else
+        {
+            abort();
+        }
+        #endif
+    }
+
+    return result_ptr;
+}
+
+void Framework::begin_no_allocation_scope()
+{
+    t_n_no_allocation_scopes++;
+}
+
+void Framework::end_no_allocation_scope()
+{
+    assert(t_n_no_allocation_scopes > 0);
+
+    t_n_no_allocation_scopes--;
+}
+
+Framework::AllocationStats Framework::get_allocation_stats()
+{
+    AllocationStats result;
+
+    result.n_allocated_bytes                = g_n_allocated_bytes.load               (std::memory_order_relaxed);
+    result.n_allocations                    = g_n_allocations.load                   (std::memory_order_relaxed);
+    result.n_no_allocation_scope_violations = g_n_no_allocation_scope_violations.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+uint64_t Framework::get_thread_n_allocated_bytes()
+{
+    return t_n_allocated_bytes;
+}
+
+uint64_t Framework::get_thread_n_allocations()
+{
+    return t_n_allocations;
+}
+
+void Framework::tracked_free(void* in_ptr,
+                             void* in_user_data)
+{
+    ::free(in_ptr);
+}
+
+void* Framework::tracked_malloc(size_t in_size,
+                                void*  in_user_data)
+{
+    return allocate(in_size);
+}
+
+void* operator new(size_t in_size)
+{
+    return allocate_or_throw(in_size);
+}
+
+void* operator new[](size_t in_size)
+{
+    return allocate_or_throw(in_size);
+}
+
+void* operator new(size_t                in_size,
+                   const std::nothrow_t&) noexcept
+{
+    return allocate(in_size);
+}
+
+void* operator new[](size_t                in_size,
+                     const std::nothrow_t&) noexcept
+{
+    return allocate(in_size);
+}
+
+void operator delete(void* in_ptr) noexcept
+{
+    ::free(in_ptr);
+}
+
+void operator delete[](void* in_ptr) noexcept
+{
+    ::free(in_ptr);
+}
+
+void operator delete(void*                 in_ptr,
+                     const std::nothrow_t&) noexcept
+{
+    ::free(in_ptr);
+}
+
+void operator delete[](void*                 in_ptr,
+                       const std::nothrow_t&) noexcept
+{
+    ::free(in_ptr);
+}
+
+void operator delete(void*  in_ptr,
+                     size_t in_size) noexcept
+{
+    ::free(in_ptr);
+}
+
+void operator delete[](void*  in_ptr,
+                       size_t in_size) noexcept
+{
+    ::free(in_ptr);
+}
+
+#endif /* FRAMEWORK_ALLOCATION_TRACKING */
\ No newline at end of file
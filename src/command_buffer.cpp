@@ -0,0 +1,445 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "command_buffer.h"
+#include <assert.h>
+#include <cstring>
+
+namespace
+{
+    struct BindPayload
+    {
+        GLuint   id;
+        GLenum   target;
+        uint32_t unit;
+    };
+
+    struct DrawArraysPayload
+    {
+        uint32_t first;
+        GLenum   mode;
+        uint32_t n_instances;
+        uint32_t n_vertices;
+    };
+
+    struct DrawElementsPayload
+    {
+        uint32_t first_index;
+        GLenum   index_type;
+        GLenum   mode;
+        uint32_t n_indices;
+        uint32_t n_instances;
+    };
+
+    struct SetUniformPayload
+    {
+        GLint    location;
+        uint32_t n_elements;
+        uint32_t type;
+    };
+}
+
+Framework::CommandBuffer::CommandBuffer(const uint32_t& in_capacity_bytes)
+    :m_has_overflowed(false),
+     m_n_bytes_used  (0),
+     m_n_commands    (0)
+{
+    m_data_u8_vec.resize(in_capacity_bytes);
+}
+
+Framework::CommandBuffer::~CommandBuffer()
+{
+    /* Stub */
+}
+
+Framework::CommandBufferUniquePtr Framework::CommandBuffer::create(const uint32_t& in_capacity_bytes)
+{
+    CommandBufferUniquePtr result_ptr(
+        new CommandBuffer(in_capacity_bytes)
+    );
+
+    return result_ptr;
+}
+
+void Framework::CommandBuffer::execute(const CommandBuffer* const* in_command_buffer_ptrs,
+                                       const uint32_t&             in_n_command_buffers)
+{
+    for (uint32_t n_command_buffer = 0;
+                  n_command_buffer < in_n_command_buffers;
+                ++n_command_buffer)
+    {
+        in_command_buffer_ptrs[n_command_buffer]->execute();
+    }
+}
+
+void Framework::CommandBuffer::execute() const
+{
+    const uint8_t* data_ptr     = m_data_u8_vec.data();
+    uint32_t       n_bytes_read = 0;
+
+    while (n_bytes_read < m_n_bytes_used)
+    {
+        CommandHeader  header;
+        const uint8_t* payload_ptr = data_ptr + n_bytes_read + sizeof(CommandHeader);
+
+        memcpy(&header,
+               data_ptr + n_bytes_read,
+               sizeof(header) );
+
+        switch (header.type)
+        {
+            case CommandType::BIND_PROGRAM:
+            {
+                BindPayload payload;
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                glUseProgram(payload.id);
+                break;
+            }
+
+            case CommandType::BIND_SAMPLER:
+            {
+                BindPayload payload;
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                glBindSampler(payload.unit,
+                              payload.id);
+                break;
+            }
+
+            case CommandType::BIND_TEXTURE:
+            {
+                BindPayload payload;
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                glActiveTexture(GL_TEXTURE0 + payload.unit);
+                glBindTexture  (payload.target,
+                                payload.id);
+                break;
+            }
+
+            case CommandType::BIND_VAO:
+            {
+                BindPayload payload;
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                glBindVertexArray(payload.id);
+                break;
+            }
+
+            case CommandType::DRAW_ARRAYS:
+            {
+                DrawArraysPayload payload;
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                if (payload.n_instances == 1)
+                {
+                    glDrawArrays(payload.mode,
+                                 static_cast<GLint>  (payload.first),
+                                 static_cast<GLsizei>(payload.n_vertices) );
+                }
+                else
+                {
+                    glDrawArraysInstanced(payload.mode,
+                                          static_cast<GLint>  (payload.first),
+                                          static_cast<GLsizei>(payload.n_vertices),
+                                          static_cast<GLsizei>(payload.n_instances) );
+                }
+
+                break;
+            }
+
+            case CommandType::DRAW_ELEMENTS:
+            {
+                DrawElementsPayload payload;
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                {
+                    const uint32_t index_size     = (payload.index_type == GL_UNSIGNED_BYTE)  ? 1
+                                                  : (payload.index_type == GL_UNSIGNED_SHORT) ? 2
+                                                                                              : 4;
+                    const void*    index_data_ptr = reinterpret_cast<const void*>(static_cast<uintptr_t>(payload.first_index * index_size) );
+
+                    if (payload.n_instances == 1)
+                    {
+                        glDrawElements(payload.mode,
+                                       static_cast<GLsizei>(payload.n_indices),
+                                       payload.index_type,
+                                       index_data_ptr);
+                    }
+                    else
+                    {
+                        glDrawElementsInstanced(payload.mode,
+                                                static_cast<GLsizei>(payload.n_indices),
+                                                payload.index_type,
+                                                index_data_ptr,
+                                                static_cast<GLsizei>(payload.n_instances) );
+                    }
+                }
+
+                break;
+            }
+
+            case CommandType::SET_UNIFORM:
+            {
+                SetUniformPayload payload;
+                const void*       uniform_data_ptr = payload_ptr + sizeof(SetUniformPayload);
+
+                memcpy(&payload,
+                       payload_ptr,
+                       sizeof(payload) );
+
+                /* Uniform data is 4-byte aligned, so it can be passed to GL directly. */
+                const auto n_elements = static_cast<GLsizei>     (payload.n_elements);
+                const auto float_ptr  = static_cast<const float*>(uniform_data_ptr);
+                const auto int_ptr    = static_cast<const GLint*>(uniform_data_ptr);
+
+                switch (static_cast<UniformType>(payload.type) )
+                {
+                    case UniformType::FLOAT:      glUniform1fv       (payload.location, n_elements,           float_ptr); break;
+                    case UniformType::FLOAT_VEC2: glUniform2fv       (payload.location, n_elements,           float_ptr); break;
+                    case UniformType::FLOAT_VEC3: glUniform3fv       (payload.location, n_elements,           float_ptr); break;
+                    case UniformType::FLOAT_VEC4: glUniform4fv       (payload.location, n_elements,           float_ptr); break;
+                    case UniformType::FLOAT_MAT3: glUniformMatrix3fv (payload.location, n_elements, GL_FALSE, float_ptr); break;
+                    case UniformType::FLOAT_MAT4: glUniformMatrix4fv (payload.location, n_elements, GL_FALSE, float_ptr); break;
+                    case UniformType::INT:        glUniform1iv       (payload.location, n_elements,           int_ptr);   break;
+                    case UniformType::INT_VEC2:   glUniform2iv       (payload.location, n_elements,           int_ptr);   break;
+                    case UniformType::INT_VEC3:   glUniform3iv       (payload.location, n_elements,           int_ptr);   break;
+                    case UniformType::INT_VEC4:   glUniform4iv       (payload.location, n_elements,           int_ptr);   break;
+                    case UniformType::UINT:       glUniform1uiv      (payload.location, n_elements,           static_cast<const GLuint*>(uniform_data_ptr) ); break;
+
+                    default:
+                    {
+                        assert(false);
+                    }
+                }
+
+                break;
+            }
+
+            default:
+            {
+                assert(false);
+            }
+        }
+
+        n_bytes_read += sizeof(CommandHeader) + header.n_payload_bytes;
+    }
+}
+
+uint32_t Framework::CommandBuffer::get_uniform_type_size(const UniformType& in_type)
+{
+    uint32_t result = 0;
+
+    switch (in_type)
+    {
+        case UniformType::FLOAT:      result = sizeof(float)  * 1;  break;
+        case UniformType::FLOAT_VEC2: result = sizeof(float)  * 2;  break;
+        case UniformType::FLOAT_VEC3: result = sizeof(float)  * 3;  break;
+        case UniformType::FLOAT_VEC4: result = sizeof(float)  * 4;  break;
+        case UniformType::FLOAT_MAT3: result = sizeof(float)  * 9;  break;
+        case UniformType::FLOAT_MAT4: result = sizeof(float)  * 16; break;
+        case UniformType::INT:        result = sizeof(GLint)  * 1;  break;
+        case UniformType::INT_VEC2:   result = sizeof(GLint)  * 2;  break;
+        case UniformType::INT_VEC3:   result = sizeof(GLint)  * 3;  break;
+        case UniformType::INT_VEC4:   result = sizeof(GLint)  * 4;  break;
+        case UniformType::UINT:       result = sizeof(GLuint) * 1;  break;
+
+        default:
+        {
+            assert(false);
+        }
+    }
+
+    return result;
+}
+
+bool Framework::CommandBuffer::record(const CommandType& in_type,
+                                      const void*        in_payload_ptr,
+                                      const uint32_t&    in_n_payload_bytes,
+                                      const void*        in_opt_extra_payload_ptr,
+                                      const uint32_t&    in_n_opt_extra_payload_bytes)
+{
+    /* Sizes are summed up in size_t, so that they cannot wrap around & pass the checks below. */
+    const size_t n_total_payload_bytes = static_cast<size_t>(in_n_payload_bytes) + in_n_opt_extra_payload_bytes;
+    const size_t n_bytes_needed        = m_n_bytes_used + sizeof(CommandHeader) + n_total_payload_bytes;
+    bool         result                = false;
+
+    /* All payloads consist of 4-byte fields, so commands stay 4-byte aligned. */
+    assert((n_total_payload_bytes % 4) == 0);
+
+    if (m_has_overflowed                                 ||
+        n_total_payload_bytes > UINT16_MAX               ||
+        n_bytes_needed        > m_data_u8_vec.size() )
+    {
+        m_has_overflowed = true;
+
+        goto end;
+    }
+
+    {
+        uint8_t*            data_ptr = m_data_u8_vec.data() + m_n_bytes_used;
+        const CommandHeader header   = {in_type, static_cast<uint16_t>(n_total_payload_bytes)};
+
+        memcpy(data_ptr,
+              &header,
+               sizeof(header) );
+        memcpy(data_ptr + sizeof(header),
+               in_payload_ptr,
+               in_n_payload_bytes);
+
+        if (in_n_opt_extra_payload_bytes > 0)
+        {
+            memcpy(data_ptr + sizeof(header) + in_n_payload_bytes,
+                   in_opt_extra_payload_ptr,
+                   in_n_opt_extra_payload_bytes);
+        }
+    }
+
+    m_n_bytes_used += static_cast<uint32_t>(sizeof(CommandHeader) + n_total_payload_bytes);
+    m_n_commands++;
+
+    result = true;
+end:
+    return result;
+}
+
+bool Framework::CommandBuffer::record_bind_program(const GLuint& in_program_id)
+{
+    const BindPayload payload = {in_program_id, GL_NONE, 0};
+
+    return record(CommandType::BIND_PROGRAM,
+                 &payload,
+                  sizeof(payload) );
+}
+
+bool Framework::CommandBuffer::record_bind_sampler(const uint32_t& in_unit,
+                                                   const GLuint&   in_sampler_id)
+{
+    const BindPayload payload = {in_sampler_id, GL_NONE, in_unit};
+
+    return record(CommandType::BIND_SAMPLER,
+                 &payload,
+                  sizeof(payload) );
+}
+
+bool Framework::CommandBuffer::record_bind_texture(const uint32_t& in_unit,
+                                                   const GLenum&   in_target,
+                                                   const GLuint&   in_texture_id)
+{
+    const BindPayload payload = {in_texture_id, in_target, in_unit};
+
+    return record(CommandType::BIND_TEXTURE,
+                 &payload,
+                  sizeof(payload) );
+}
+
+bool Framework::CommandBuffer::record_bind_vao(const GLuint& in_vao_id)
+{
+    const BindPayload payload = {in_vao_id, GL_NONE, 0};
+
+    return record(CommandType::BIND_VAO,
+                 &payload,
+                  sizeof(payload) );
+}
+
+bool Framework::CommandBuffer::record_draw_arrays(const GLenum&   in_mode,
+                                                  const uint32_t& in_first,
+                                                  const uint32_t& in_n_vertices,
+                                                  const uint32_t& in_n_instances)
+{
+    const DrawArraysPayload payload = {in_first, in_mode, in_n_instances, in_n_vertices};
+
+    return record(CommandType::DRAW_ARRAYS,
+                 &payload,
+                  sizeof(payload) );
+}
+
+bool Framework::CommandBuffer::record_draw_elements(const GLenum&   in_mode,
+                                                    const GLenum&   in_index_type,
+                                                    const uint32_t& in_first_index,
+                                                    const uint32_t& in_n_indices,
+                                                    const uint32_t& in_n_instances)
+{
+    const DrawElementsPayload payload = {in_first_index, in_index_type, in_mode, in_n_indices, in_n_instances};
+
+    return record(CommandType::DRAW_ELEMENTS,
+                 &payload,
+                  sizeof(payload) );
+}
+
+bool Framework::CommandBuffer::record_set_uniform(const GLint&       in_location,
+                                                  const UniformType& in_type,
+                                                  const uint32_t&    in_n_elements,
+                                                  const void*        in_data_ptr)
+{
+    const uint32_t          n_bytes_per_element = get_uniform_type_size(in_type);
+    const SetUniformPayload payload             = {in_location, in_n_elements, static_cast<uint32_t>(in_type)};
+    bool                    result              = false;
+
+    /* Checked before multiplying, so that a wrapped around size cannot get recorded with a short payload. Values which
+     * would not fit in a single command are treated as an overflow, as in record(). */
+    if (n_bytes_per_element == 0                                ||
+        in_n_elements       >  UINT16_MAX / n_bytes_per_element)
+    {
+        m_has_overflowed = true;
+
+        goto end;
+    }
+
+    result = record(CommandType::SET_UNIFORM,
+                   &payload,
+                    sizeof(payload),
+                    in_data_ptr,
+                    n_bytes_per_element * in_n_elements);
+
+end:
+    return result;
+}
+
+void Framework::CommandBuffer::reset()
+{
+    m_has_overflowed = false;
+    m_n_bytes_used   = 0;
+    m_n_commands     = 0;
+}
\ No newline at end of file
@@ -0,0 +1,420 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "draw_batcher.h"
+#include "trace.h"
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+
+Framework::DrawBatcher::DrawBatcher(const uint32_t& in_instance_attribute_location,
+                                    const uint32_t& in_max_instance_data_bytes_per_frame)
+    :m_gpu_memory_id                    (0),
+     m_instance_buffer_id               (0),
+     m_n_instance_data_bytes_used       (0),
+     m_instance_attribute_location      (in_instance_attribute_location),
+     m_max_instance_data_bytes_per_frame(in_max_instance_data_bytes_per_frame)
+{
+    assert(in_max_instance_data_bytes_per_frame > 0);
+}
+
+Framework::DrawBatcher::~DrawBatcher()
+{
+    Framework::unregister_gpu_memory(m_gpu_memory_id);
+
+    if (m_instance_buffer_id != 0)
+    {
+        glDeleteBuffers(1,
+                       &m_instance_buffer_id);
+
+        m_instance_buffer_id = 0;
+    }
+}
+
+bool Framework::DrawBatcher::can_merge(const SubmittedDraw& in_draw1,
+                                       const SubmittedDraw& in_draw2)
+{
+    return (!is_less(in_draw1, in_draw2) &&
+            !is_less(in_draw2, in_draw1) );
+}
+
+Framework::DrawBatcherUniquePtr Framework::DrawBatcher::create(const uint32_t& in_instance_attribute_location,
+                                                               const uint32_t& in_max_instance_data_bytes_per_frame)
+{
+    DrawBatcherUniquePtr result_ptr(
+        new DrawBatcher(in_instance_attribute_location,
+                        in_max_instance_data_bytes_per_frame)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+void Framework::DrawBatcher::flush()
+{
+    const uint32_t n_submitted_draws = static_cast<uint32_t>(m_submitted_draw_vec.size() );
+
+    m_stats                   = DrawBatcherStats();
+    m_stats.n_draws_submitted = n_submitted_draws;
+
+    if (n_submitted_draws == 0)
+    {
+        goto end;
+    }
+
+    /* Group draws sharing the same state. Stable sort is used so that instance order within a batch
+     * follows the submission order. */
+    m_submitted_draw_order_vec.resize(n_submitted_draws);
+
+    for (uint32_t n_draw = 0;
+                  n_draw < n_submitted_draws;
+                ++n_draw)
+    {
+        m_submitted_draw_order_vec.at(n_draw) = n_draw;
+    }
+
+    std::stable_sort(m_submitted_draw_order_vec.begin(),
+                     m_submitted_draw_order_vec.end  (),
+                     [this](const uint32_t& in_n_draw1,
+                            const uint32_t& in_n_draw2)
+                     {
+                         return is_less(m_submitted_draw_vec[in_n_draw1],
+                                        m_submitted_draw_vec[in_n_draw2]);
+                     });
+
+    /* Repack per-instance data in batch order and upload it in one go. Orphan the buffer first so that
+     * the driver does not need to wait for the previous frame's draw calls to finish. */
+    {
+        uint32_t n_bytes_packed = 0;
+
+        for (const auto& current_n_draw : m_submitted_draw_order_vec)
+        {
+            const auto& current_draw = m_submitted_draw_vec[current_n_draw];
+
+            memcpy(m_upload_data_u8_vec.data  () + n_bytes_packed,
+                   m_instance_data_u8_vec.data() + current_draw.instance_data_offset,
+                   current_draw.instance_data_size);
+
+            n_bytes_packed += current_draw.instance_data_size;
+        }
+
+        glBindBuffer   (GL_ARRAY_BUFFER,
+                        m_instance_buffer_id);
+        glBufferData   (GL_ARRAY_BUFFER,
+                        m_max_instance_data_bytes_per_frame,
+                        nullptr,
+                        GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER,
+                        0, /* offset */
+                        n_bytes_packed,
+                        m_upload_data_u8_vec.data() );
+
+        m_stats.n_instance_bytes_uploaded = n_bytes_packed;
+
+        Framework::add_to_frame_counter(FrameCounter::UPLOADED_BYTES,
+                                        n_bytes_packed);
+    }
+
+    /* Issue one instanced draw call per batch, only touching state which actually changes between batches. */
+    {
+        std::array<GLuint, BatchedDraw::N_MAX_TEXTURES> bound_texture_ids;
+        GLuint                                          bound_program_id     = 0;
+        GLuint                                          bound_vao_id         = 0;
+        uint32_t                                        n_batch_start        = 0;
+        uint32_t                                        n_bytes_consumed     = 0;
+        uint32_t                                        n_enabled_attributes = 0; /* In the bound VAO. */
+
+        bound_texture_ids.fill(0);
+
+        while (n_batch_start < n_submitted_draws)
+        {
+            const auto& batch_draw  = m_submitted_draw_vec[m_submitted_draw_order_vec[n_batch_start] ];
+            uint32_t    n_batch_end = n_batch_start + 1;
+            uint32_t    n_instances = 1;
+
+            while (n_batch_end < n_submitted_draws &&
+                   can_merge(batch_draw,
+                             m_submitted_draw_vec[m_submitted_draw_order_vec[n_batch_end] ]) )
+            {
+                n_batch_end++;
+                n_instances++;
+            }
+
+            if (batch_draw.draw.program_ptr->get_id() != bound_program_id)
+            {
+                bound_program_id = batch_draw.draw.program_ptr->get_id();
+
+                glUseProgram(bound_program_id);
+            }
+
+            if (batch_draw.draw.vao_id != bound_vao_id)
+            {
+                /* Instanced attribute state is a part of VAO state, so it has to be reset before the VAO is
+                 * released. Otherwise, non-batched draws which use the VAO later on would source these attributes
+                 * from whatever the batcher left behind. */
+                reset_instance_attributes(0, /* in_n_first_attribute */
+                                          n_enabled_attributes);
+
+                n_enabled_attributes = 0;
+                bound_vao_id         = batch_draw.draw.vao_id;
+
+                glBindVertexArray(bound_vao_id);
+            }
+
+            for (uint32_t n_texture = 0;
+                          n_texture < BatchedDraw::N_MAX_TEXTURES;
+                        ++n_texture)
+            {
+                const auto   texture_ptr = batch_draw.draw.texture_ptrs.at(n_texture);
+                const GLuint texture_id  = (texture_ptr != nullptr) ? texture_ptr->get_id()
+                                                                    : 0;
+
+                if (texture_id != 0 &&
+                    texture_id != bound_texture_ids.at(n_texture) )
+                {
+                    glActiveTexture(GL_TEXTURE0 + n_texture);
+                    glBindTexture  (texture_ptr->get_target(),
+                                    texture_id);
+
+                    bound_texture_ids.at(n_texture) = texture_id;
+                }
+            }
+
+            /* Point instanced attributes at this batch's range of the streaming buffer. GL_ARRAY_BUFFER binding is
+             * not a part of VAO state, so the instance buffer remains bound from the upload above. Attributes which
+             * were enabled for the previous batch in the same VAO keep their enable bit & divisor; those which
+             * this batch does not use are reset. */
+            {
+                const uint32_t n_attributes = batch_draw.instance_data_size / 16;
+
+                if (n_attributes < n_enabled_attributes)
+                {
+                    reset_instance_attributes(n_attributes,
+                                              n_enabled_attributes - n_attributes);
+                }
+
+                for (uint32_t n_attribute = 0;
+                              n_attribute < n_attributes;
+                            ++n_attribute)
+                {
+                    const GLuint attribute_location = m_instance_attribute_location + n_attribute;
+
+                    if (n_attribute >= n_enabled_attributes)
+                    {
+                        glEnableVertexAttribArray(attribute_location);
+                        glVertexAttribDivisor    (attribute_location,
+                                                  1);
+                    }
+
+                    glVertexAttribPointer(attribute_location,
+                                          4,                                   /* size       */
+                                          GL_FLOAT,
+                                          GL_FALSE,                            /* normalized */
+                                          batch_draw.instance_data_size,       /* stride     */
+                                          reinterpret_cast<const void*>(static_cast<uintptr_t>(n_bytes_consumed + n_attribute * 16) ));
+                }
+
+                n_enabled_attributes = n_attributes;
+            }
+
+            {
+                const uint32_t index_size = (batch_draw.draw.index_type == GL_UNSIGNED_BYTE)  ? 1
+                                          : (batch_draw.draw.index_type == GL_UNSIGNED_SHORT) ? 2
+                                                                                              : 4;
+
+                glDrawElementsInstanced(batch_draw.draw.mode,
+                                        static_cast<GLsizei>(batch_draw.draw.n_indices),
+                                        batch_draw.draw.index_type,
+                                        reinterpret_cast<const void*>(static_cast<uintptr_t>(batch_draw.draw.first_index * index_size) ),
+                                        static_cast<GLsizei>(n_instances) );
+            }
+
+            m_stats.n_draw_calls_issued++;
+
+            n_bytes_consumed += batch_draw.instance_data_size * n_instances;
+            n_batch_start     = n_batch_end;
+        }
+
+        reset_instance_attributes(0, /* in_n_first_attribute */
+                                  n_enabled_attributes);
+
+        glBindVertexArray(0);
+        glBindBuffer     (GL_ARRAY_BUFFER,
+                          0);
+    }
+
+    m_stats.n_draws_merged = m_stats.n_draws_submitted - m_stats.n_draw_calls_issued;
+
+end:
+    m_n_instance_data_bytes_used = 0;
+
+    m_submitted_draw_vec.clear();
+}
+
+bool Framework::DrawBatcher::init()
+{
+    bool result = false;
+
+    glGenBuffers(1,
+                &m_instance_buffer_id);
+
+    if (m_instance_buffer_id == 0)
+    {
+        Framework::report_error("glGenBuffers() returned a zeroed out ID.");
+
+        goto end;
+    }
+
+    /* Preallocate all CPU-side storage, so that no allocations are made in steady state. */
+    m_instance_data_u8_vec.resize(m_max_instance_data_bytes_per_frame);
+    m_upload_data_u8_vec.resize  (m_max_instance_data_bytes_per_frame);
+
+    m_submitted_draw_vec.reserve      (m_max_instance_data_bytes_per_frame / 16);
+    m_submitted_draw_order_vec.reserve(m_max_instance_data_bytes_per_frame / 16);
+
+    /* Storage is reallocated by every flush(), but its size never changes. */
+    m_gpu_memory_id = Framework::register_gpu_memory(GPUMemoryType::BUFFER,
+                                                     "DrawBatcher",
+                                                     m_max_instance_data_bytes_per_frame);
+
+    result = true;
+end:
+    return result;
+}
+
+bool Framework::DrawBatcher::is_less(const SubmittedDraw& in_draw1,
+                                     const SubmittedDraw& in_draw2)
+{
+    const auto& draw1 = in_draw1.draw;
+    const auto& draw2 = in_draw2.draw;
+
+    if (draw1.program_ptr != draw2.program_ptr)
+    {
+        return draw1.program_ptr->get_id() < draw2.program_ptr->get_id();
+    }
+
+    if (draw1.vao_id != draw2.vao_id)
+    {
+        return draw1.vao_id < draw2.vao_id;
+    }
+
+    for (uint32_t n_texture = 0;
+                  n_texture < BatchedDraw::N_MAX_TEXTURES;
+                ++n_texture)
+    {
+        if (draw1.texture_ptrs.at(n_texture) != draw2.texture_ptrs.at(n_texture) )
+        {
+            return draw1.texture_ptrs.at(n_texture) < draw2.texture_ptrs.at(n_texture);
+        }
+    }
+
+    if (draw1.mode != draw2.mode)
+    {
+        return draw1.mode < draw2.mode;
+    }
+
+    if (draw1.index_type != draw2.index_type)
+    {
+        return draw1.index_type < draw2.index_type;
+    }
+
+    if (draw1.first_index != draw2.first_index)
+    {
+        return draw1.first_index < draw2.first_index;
+    }
+
+    if (draw1.n_indices != draw2.n_indices)
+    {
+        return draw1.n_indices < draw2.n_indices;
+    }
+
+    return in_draw1.instance_data_size < in_draw2.instance_data_size;
+}
+
+void Framework::DrawBatcher::reset_instance_attributes(const uint32_t& in_n_first_attribute,
+                                                       const uint32_t& in_n_attributes)
+{
+    for (uint32_t n_attribute = in_n_first_attribute;
+                  n_attribute < in_n_first_attribute + in_n_attributes;
+                ++n_attribute)
+    {
+        const GLuint attribute_location = m_instance_attribute_location + n_attribute;
+
+        glVertexAttribDivisor     (attribute_location,
+                                   0);
+        glDisableVertexAttribArray(attribute_location);
+    }
+}
+
+bool Framework::DrawBatcher::submit(const BatchedDraw& in_draw,
+                                    const void*        in_instance_data_ptr,
+                                    const uint32_t&    in_instance_data_size)
+{
+    bool result = false;
+
+    if (in_draw.program_ptr == nullptr)
+    {
+        Framework::report_error("Null program specified for Framework::DrawBatcher::submit()");
+
+        goto end;
+    }
+
+    if ((in_instance_data_size      == 0) ||
+        (in_instance_data_size % 16 != 0) )
+    {
+        Framework::report_error("Instance data size passed to Framework::DrawBatcher::submit() must be a non-zero multiple of 16.");
+
+        goto end;
+    }
+
+    if (m_n_instance_data_bytes_used + in_instance_data_size > m_max_instance_data_bytes_per_frame)
+    {
+        /* Out of budget for this frame. */
+        goto end;
+    }
+
+    {
+        SubmittedDraw new_draw;
+
+        new_draw.draw                 = in_draw;
+        new_draw.instance_data_offset = m_n_instance_data_bytes_used;
+        new_draw.instance_data_size   = in_instance_data_size;
+
+        memcpy(m_instance_data_u8_vec.data() + m_n_instance_data_bytes_used,
+               in_instance_data_ptr,
+               in_instance_data_size);
+
+        m_submitted_draw_vec.push_back(new_draw);
+    }
+
+    m_n_instance_data_bytes_used += in_instance_data_size;
+    result                        = true;
+end:
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,326 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "fake_gl.h"
+
+#if !defined(__EMSCRIPTEN__)
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+/* Type defs */
+typedef void (APIENTRYP PFNGLGENERICPROC)(void);
+
+static Framework::GLCallCountArray          g_call_counts      = {};
+static std::vector<Framework::GLFunctionID> g_call_log;
+static Framework::FakeGLConfig              g_config;
+static uint32_t                             g_n_last_object_id = 0;
+static PFNGLGENERICPROC                     g_original_gl_function_ptrs[static_cast<uint32_t>(Framework::GLFunctionID::COUNT)];
+
+/* Long enough for "uniform<UINT32_MAX>" incl. the terminator. */
+static const GLint UNIFORM_NAME_MAX_LENGTH = 32;
+
+static void record_call(const Framework::GLFunctionID& in_id)
+{
+    ++g_call_counts[static_cast<uint32_t>(in_id)];
+
+    if (g_config.record_call_log)
+    {
+        g_call_log.push_back(in_id);
+    }
+}
+
+namespace
+{
+    /* Default implementation: records the call and returns a zeroed out value, if any. */
+    template<Framework::GLFunctionID ID, typename PFN>
+    struct FakeGLFunction;
+
+    template<Framework::GLFunctionID ID, typename R, typename... Args>
+    struct FakeGLFunction<ID, R (APIENTRYP)(Args...)>
+    {
+        static R APIENTRY call(Args...)
+        {
+            record_call(ID);
+
+            return R();
+        }
+    };
+
+    template<Framework::GLFunctionID ID>
+    void APIENTRY fake_gl_gen(GLsizei in_n,
+                              GLuint* out_ids_ptr)
+    {
+        record_call(ID);
+
+        for (GLsizei n_id = 0;
+                     n_id < in_n;
+                   ++n_id)
+        {
+            out_ids_ptr[n_id] = ++g_n_last_object_id;
+        }
+    }
+}
+
+static GLenum APIENTRY fake_gl_check_framebuffer_status(GLenum)
+{
+    record_call(Framework::GLFunctionID::CheckFramebufferStatus);
+
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static GLenum APIENTRY fake_gl_client_wait_sync(GLsync,
+                                                GLbitfield,
+                                                GLuint64)
+{
+    record_call(Framework::GLFunctionID::ClientWaitSync);
+
+    return GL_ALREADY_SIGNALED;
+}
+
+static GLuint APIENTRY fake_gl_create_program()
+{
+    record_call(Framework::GLFunctionID::CreateProgram);
+
+    return ++g_n_last_object_id;
+}
+
+static GLuint APIENTRY fake_gl_create_shader(GLenum)
+{
+    record_call(Framework::GLFunctionID::CreateShader);
+
+    return ++g_n_last_object_id;
+}
+
+static GLsync APIENTRY fake_gl_fence_sync(GLenum,
+                                          GLbitfield)
+{
+    record_call(Framework::GLFunctionID::FenceSync);
+
+    return reinterpret_cast<GLsync>(static_cast<uintptr_t>(++g_n_last_object_id) );
+}
+
+static void APIENTRY fake_gl_get_active_uniform(GLuint,
+                                                GLuint   in_index,
+                                                GLsizei  in_buf_size,
+                                                GLsizei* out_length_ptr,
+                                                GLint*   out_size_ptr,
+                                                GLenum*  out_type_ptr,
+                                                GLchar*  out_name_ptr)
+{
+    int length = 0;
+
+    record_call(Framework::GLFunctionID::GetActiveUniform);
+
+    if (in_buf_size > 0)
+    {
+        length = snprintf(out_name_ptr,
+                          in_buf_size,
+                          "uniform%u",
+                          in_index);
+        length = std::min(length,
+                          static_cast<int>(in_buf_size) - 1);
+    }
+
+    if (out_length_ptr != nullptr)
+    {
+        *out_length_ptr = length;
+    }
+
+    *out_size_ptr = 1;
+    *out_type_ptr = GL_FLOAT_VEC4;
+}
+
+static void APIENTRY fake_gl_get_integerv(GLenum in_pname,
+                                          GLint* out_data_ptr)
+{
+    const uint32_t n_values = (in_pname == GL_SCISSOR_BOX || in_pname == GL_VIEWPORT) ? 4 : 1;
+
+    record_call(Framework::GLFunctionID::GetIntegerv);
+
+    memset(out_data_ptr,
+           0,
+           sizeof(GLint) * n_values);
+}
+
+static void APIENTRY fake_gl_get_program_info_log(GLuint,
+                                                  GLsizei  in_buf_size,
+                                                  GLsizei* out_length_ptr,
+                                                  GLchar*  out_info_log_ptr)
+{
+    record_call(Framework::GLFunctionID::GetProgramInfoLog);
+
+    if (in_buf_size > 0)
+    {
+        out_info_log_ptr[0] = 0;
+    }
+
+    if (out_length_ptr != nullptr)
+    {
+        *out_length_ptr = 0;
+    }
+}
+
+static void APIENTRY fake_gl_get_programiv(GLuint,
+                                           GLenum in_pname,
+                                           GLint* out_params_ptr)
+{
+    record_call(Framework::GLFunctionID::GetProgramiv);
+
+    switch (in_pname)
+    {
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH: *out_params_ptr = UNIFORM_NAME_MAX_LENGTH;                                   break;
+        case GL_ACTIVE_UNIFORMS:           *out_params_ptr = static_cast<GLint>(g_config.n_active_uniforms_per_program); break;
+        case GL_LINK_STATUS:               *out_params_ptr = GL_TRUE;                                                   break;
+
+        default:
+        {
+            *out_params_ptr = 0;
+        }
+    }
+}
+
+static void APIENTRY fake_gl_get_query_object_uiv(GLuint,
+                                                  GLenum  in_pname,
+                                                  GLuint* out_params_ptr)
+{
+    record_call(Framework::GLFunctionID::GetQueryObjectuiv);
+
+    *out_params_ptr = (in_pname == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0;
+}
+
+static void APIENTRY fake_gl_get_shader_info_log(GLuint,
+                                                 GLsizei  in_buf_size,
+                                                 GLsizei* out_length_ptr,
+                                                 GLchar*  out_info_log_ptr)
+{
+    record_call(Framework::GLFunctionID::GetShaderInfoLog);
+
+    if (in_buf_size > 0)
+    {
+        out_info_log_ptr[0] = 0;
+    }
+
+    if (out_length_ptr != nullptr)
+    {
+        *out_length_ptr = 0;
+    }
+}
+
+static void APIENTRY fake_gl_get_shaderiv(GLuint,
+                                          GLenum in_pname,
+                                          GLint* out_params_ptr)
+{
+    record_call(Framework::GLFunctionID::GetShaderiv);
+
+    *out_params_ptr = (in_pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+static GLint APIENTRY fake_gl_get_uniform_location(GLuint,
+                                                   const GLchar* in_name_ptr)
+{
+    GLint    result = -1;
+    uint32_t index  = 0;
+
+    record_call(Framework::GLFunctionID::GetUniformLocation);
+
+    if (sscanf(in_name_ptr,
+               "uniform%u",
+              &index) == 1                              &&
+        index         < g_config.n_active_uniforms_per_program)
+    {
+        result = static_cast<GLint>(index);
+    }
+
+    return result;
+}
+
+const Framework::GLCallCountArray& Framework::get_fake_gl_call_counts()
+{
+    return g_call_counts;
+}
+
+const std::vector<Framework::GLFunctionID>& Framework::get_fake_gl_call_log()
+{
+    return g_call_log;
+}
+
+void Framework::install_fake_gl(const FakeGLConfig& in_config)
+{
+    g_config = in_config;
+
+    #define FRAMEWORK_FAKE_GL_HOOK(name, pfn)                                                                                       \
+        g_original_gl_function_ptrs[static_cast<uint32_t>(GLFunctionID::name)] = reinterpret_cast<PFNGLGENERICPROC>(glad_gl##name); \
+        glad_gl##name                                                          = &FakeGLFunction<GLFunctionID::name, pfn>::call;
+
+    FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_FAKE_GL_HOOK)
+
+    #undef FRAMEWORK_FAKE_GL_HOOK
+
+    /* Entry-points whose results are relied upon by the framework. */
+    glad_glCheckFramebufferStatus = fake_gl_check_framebuffer_status;
+    glad_glClientWaitSync         = fake_gl_client_wait_sync;
+    glad_glCreateProgram          = fake_gl_create_program;
+    glad_glCreateShader           = fake_gl_create_shader;
+    glad_glFenceSync              = fake_gl_fence_sync;
+    glad_glGenBuffers             = fake_gl_gen<GLFunctionID::GenBuffers>;
+    glad_glGenFramebuffers        = fake_gl_gen<GLFunctionID::GenFramebuffers>;
+    glad_glGenQueries             = fake_gl_gen<GLFunctionID::GenQueries>;
+    glad_glGenRenderbuffers       = fake_gl_gen<GLFunctionID::GenRenderbuffers>;
+    glad_glGenSamplers            = fake_gl_gen<GLFunctionID::GenSamplers>;
+    glad_glGenTextures            = fake_gl_gen<GLFunctionID::GenTextures>;
+    glad_glGenTransformFeedbacks  = fake_gl_gen<GLFunctionID::GenTransformFeedbacks>;
+    glad_glGenVertexArrays        = fake_gl_gen<GLFunctionID::GenVertexArrays>;
+    glad_glGetActiveUniform       = fake_gl_get_active_uniform;
+    glad_glGetIntegerv            = fake_gl_get_integerv;
+    glad_glGetProgramInfoLog      = fake_gl_get_program_info_log;
+    glad_glGetProgramiv           = fake_gl_get_programiv;
+    glad_glGetQueryObjectuiv      = fake_gl_get_query_object_uiv;
+    glad_glGetShaderInfoLog       = fake_gl_get_shader_info_log;
+    glad_glGetShaderiv            = fake_gl_get_shaderiv;
+    glad_glGetUniformLocation     = fake_gl_get_uniform_location;
+
+    reset_fake_gl_calls();
+}
+
+void Framework::reset_fake_gl_calls()
+{
+    g_call_counts = GLCallCountArray();
+
+    g_call_log.clear();
+}
+
+void Framework::uninstall_fake_gl()
+{
+    #define FRAMEWORK_FAKE_GL_UNHOOK(name, pfn) \
+        glad_gl##name = reinterpret_cast<pfn>(g_original_gl_function_ptrs[static_cast<uint32_t>(GLFunctionID::name)]);
+
+    FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_FAKE_GL_UNHOOK)
+
+    #undef FRAMEWORK_FAKE_GL_UNHOOK
+}
+
+#endif /* !__EMSCRIPTEN__ */
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "file_io.h"
+#include "trace.h"
+#include <stdio.h>
+
+Uint8VectorUniquePtr Framework::read_file(const std::string& in_filename)
+{
+    FRAMEWORK_TRACE_SCOPE("read_file");
+
+    FILE*                file_handle = ::fopen(in_filename.c_str(),
+                                               "rb");
+    long                 file_size   = 0;
+    Uint8VectorUniquePtr result_u8_vec_ptr;
+
+    if (file_handle == nullptr)
+    {
+        Framework::report_error("Failed to open [%s].",
+                                in_filename);
+
+        goto end;
+    }
+
+    ::fseek(file_handle,
+            0L,
+            SEEK_END);
+
+    file_size = ::ftell(file_handle);
+
+    ::fseek(file_handle,
+            0L,
+            SEEK_SET);
+
+    if (file_size < 0)
+    {
+        Framework::report_error("Failed to determine size of [%s].",
+                                in_filename);
+
+        goto end;
+    }
+
+    result_u8_vec_ptr.reset(new std::vector<uint8_t>(file_size) );
+
+    if (file_size > 0)
+    {
+        if (::fread(result_u8_vec_ptr->data(),
+                    static_cast<size_t>       (file_size),
+                    1u,
+                    file_handle) != 1)
+        {
+            Framework::report_error("Failed to read [%s].",
+                                    in_filename);
+
+            result_u8_vec_ptr.reset();
+        }
+    }
+
+end:
+    if (file_handle != nullptr)
+    {
+        ::fclose(file_handle);
+    }
+
+    return result_u8_vec_ptr;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "frame_latency_limiter.h"
+#include <algorithm>
+#include <assert.h>
+
+Framework::FrameLatencyLimiter::FrameLatencyLimiter(const uint32_t& in_max_frames_in_flight)
+    :m_fence_vec           (in_max_frames_in_flight,
+                            nullptr),
+     m_n_current_frame     (0),
+     m_has_pending_input   (false),
+     m_max_frames_in_flight(in_max_frames_in_flight)
+{
+    /* Stub */
+}
+
+Framework::FrameLatencyLimiter::~FrameLatencyLimiter()
+{
+    for (auto& current_fence : m_fence_vec)
+    {
+        if (current_fence != nullptr)
+        {
+            glDeleteSync(current_fence);
+        }
+    }
+}
+
+bool Framework::FrameLatencyLimiter::begin_frame(const bool& in_can_block)
+{
+    bool result = false;
+
+    m_stats.last_fence_wait_ms = 0.0;
+
+    if (m_max_frames_in_flight > 0)
+    {
+        auto& fence = m_fence_vec[m_n_current_frame % m_max_frames_in_flight];
+
+        if (fence != nullptr)
+        {
+            const auto wait_start_time = std::chrono::steady_clock::now();
+            GLenum     wait_result     = GL_NONE;
+
+            if (in_can_block)
+            {
+                /* Give up after a second, so that a lost context does not hang the app forever. */
+                const GLuint64 timeout_ns = 100ull * 1000ull * 1000ull;
+                uint32_t       n_attempts = 0;
+
+                do
+                {
+                    wait_result = glClientWaitSync(fence,
+                                                   GL_SYNC_FLUSH_COMMANDS_BIT,
+                                                   timeout_ns);
+                }
+                while (wait_result == GL_TIMEOUT_EXPIRED &&
+                       ++n_attempts < 10);
+            }
+            else
+            {
+                wait_result = glClientWaitSync(fence,
+                                               GL_SYNC_FLUSH_COMMANDS_BIT,
+                                               0); /* timeout */
+
+                if (wait_result == GL_TIMEOUT_EXPIRED)
+                {
+                    m_stats.n_frames_skipped++;
+
+                    goto end;
+                }
+            }
+
+            if (wait_result == GL_WAIT_FAILED)
+            {
+                Framework::report_error("glClientWaitSync() failed while waiting for a frame to complete.");
+            }
+
+            glDeleteSync(fence);
+
+            fence                      = nullptr;
+            m_stats.last_fence_wait_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wait_start_time).count();
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+void Framework::FrameLatencyLimiter::end_frame()
+{
+    if (m_max_frames_in_flight > 0)
+    {
+        auto& fence = m_fence_vec[m_n_current_frame % m_max_frames_in_flight];
+
+        assert(fence == nullptr);
+
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE,
+                            0); /* flags */
+
+        /* Make sure the fence reaches the GPU, or a later wait on it could never be satisfied. */
+        glFlush();
+    }
+
+    if (m_has_pending_input)
+    {
+        const double latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_oldest_pending_input_time).count();
+
+        m_stats.n_frames_with_input++;
+
+        m_stats.average_input_to_submit_ms += (latency_ms - m_stats.average_input_to_submit_ms) / static_cast<double>(m_stats.n_frames_with_input);
+        m_stats.last_input_to_submit_ms     = latency_ms;
+        m_stats.max_input_to_submit_ms      = std::max(m_stats.max_input_to_submit_ms,
+                                                       latency_ms);
+
+        m_has_pending_input = false;
+    }
+
+    m_stats.n_frames_submitted++;
+    m_n_current_frame++;
+}
+
+Framework::FrameLatencyLimiterUniquePtr Framework::FrameLatencyLimiter::create(const uint32_t& in_max_frames_in_flight)
+{
+    FrameLatencyLimiterUniquePtr result_ptr(
+        new FrameLatencyLimiter(in_max_frames_in_flight)
+    );
+
+    return result_ptr;
+}
\ No newline at end of file
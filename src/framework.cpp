@@ -25,149 +25,2323 @@
  *       Nothing exciting in here. Just the most basic stuff needed to run actual app
  *       under both Windows and in web browsers befriended to WebAssembly and ES2.0 support.
  */
+#include "allocation_tracker.h"
+#include "file_io.h"
 #include "framework.h"
+#include "frame_latency_limiter.h"
+#include "gl_capture.h"
+#include "gl_check.h"
+#include "gl_debug_output.h"
+#include "gl_instrumentation.h"
+#include "golden_image.h"
+#include "gpu_memory.h"
+#include "hitch_detector.h"
+#include "input_event_queue.h"
+#include "input_player.h"
+#include "input_recorder.h"
+#include "trace.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <stdio.h>
+#include <stdlib.h>
 #include <vector>
 
+/* Rendering can be moved off the thread which pumps window events on native builds, as well as under Emscripten
+ * if the GL context lives on an OffscreenCanvas owned by a worker. */
+#if !defined(__EMSCRIPTEN__) || defined(FRAMEWORK_USE_OFFSCREEN_CANVAS)
+    #define FRAMEWORK_HAS_RENDER_THREAD
+#endif
+
 #ifdef __EMSCRIPTEN__
     #include "emscripten_mainloop_stub.h"
     #include <unistd.h>
+
+    #if defined(FRAMEWORK_GL_INSTRUMENTATION) || defined(FRAMEWORK_USE_OFFSCREEN_CANVAS)
+        #include <emscripten/html5.h>
+    #endif
+
+    #if defined(FRAMEWORK_USE_OFFSCREEN_CANVAS)
+        #include <emscripten/threading.h>
+        #include <pthread.h>
+    #endif
+#else
+    #include <array>
+    #include <condition_variable>
+    #include <thread>
+#endif
+
+#if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    #include "spsc_queue.h"
+#endif
+
+#include <GLFW/glfw3.h>
+
+static auto g_app_ptr           = create_app();
+static bool g_use_render_thread = false;
+
+/* Owned by the thread which submits frames. */
+static Framework::GPUMemoryAllocationID        g_default_framebuffer_gpu_memory_id = 0;
+static int                                     g_default_framebuffer_height        = 0;
+static int                                     g_default_framebuffer_width         = 0;
+static Framework::FrameLatencyLimiterUniquePtr g_frame_latency_limiter_ptr;
+static Framework::HitchDetectorUniquePtr       g_hitch_detector_ptr;
+static double                                  g_hitch_threshold_ms                = 0.0;
+static Framework::InputEventQueueUniquePtr     g_input_event_queue_ptr;
+static uint32_t                                g_max_frames_in_flight              = 0;
+static uint32_t                                g_n_hitch_history_frames            = 0;
+
+/* Input recording & replay support, enabled with --record <file> and --replay <file> command line arguments.
+ *
+ * Frames are counted from the first frame built by the app. When replaying, live input & file drops are not
+ * forwarded to the app or ImGui, vsync is disabled and the app quits once all recorded frames have been replayed.
+ * Replayed input is fed to ImGui directly, so ImGui's GLFW backend is not used, and the window is resized to match
+ * the recorded framebuffer size.
+ */
+static Framework::InputPlayerUniquePtr          g_input_player_ptr;
+static Framework::InputRecorderUniquePtr        g_input_recorder_ptr;
+static uint32_t                                 g_n_frame                    = 0; /* Frame being prepared. */
+static std::vector<Framework::ReplayedFileDrop> g_replayed_file_drop_vec;
+static double                                   g_replay_max_frame_time_ms   = 0.0;
+static double                                   g_replay_min_frame_time_ms   = 0.0;
+static std::chrono::steady_clock::time_point    g_replay_last_frame_time;
+static std::chrono::steady_clock::time_point    g_replay_start_time;
+static bool                                     g_use_imgui_glfw_backend     = true;
+static GLFWwindow*                              g_window_ptr                 = nullptr;
+
+#if !defined(__EMSCRIPTEN__)
+    /* GL capture support, enabled with --capture-gl <file> <number of frames> command line arguments. Capture starts
+     * as soon as GL is initialized, so that creation of all GL objects used by the app is recorded. */
+    static Framework::GLCaptureUniquePtr g_gl_capture_ptr;
+    static std::string                   g_gl_capture_filename;
+    static uint32_t                      g_n_gl_capture_frames = 0;
+
+    /* Zone tracing support, enabled with --trace <file> command line arguments. The trace is saved at shutdown. */
+    static std::string g_trace_filename;
+
+    /* Driver debug output capture, see FrameworkConfig::capture_gl_debug_output. */
+    static bool g_capture_gl_debug_output = false;
+
+    /* Golden image testing support, enabled with --golden-image <file> <number of frames> or
+     * --update-golden-image <file> <number of frames> command line arguments. See golden_image.h. */
+    static std::string                         g_golden_image_filename;
+    static Framework::GoldenImageMode          g_golden_image_mode     = Framework::GoldenImageMode::CHECK;
+    static Framework::GoldenImageTestUniquePtr g_golden_image_test_ptr;
+    static uint32_t                            g_n_golden_image_frames = 0;
+#endif
+
+/* On-demand rendering support.
+ *
+ * A redraw is requested by input & window events, as well as explicitly via Framework::request_redraw().
+ * Each request results in a few frames being rendered, so that ImGui's state (eg. hover highlights) has
+ * a chance to settle. Otherwise, a frame is only rendered once the idle timeout expires.
+ */
+static const uint32_t    N_FRAMES_TO_RENDER_PER_REDRAW_REQUEST = 3;
+static const double      ON_DEMAND_IDLE_TIMEOUT                = 1.0; /* s - lets time-based UI (eg. tooltips) catch up. */
+static const double      ON_DEMAND_TEXT_INPUT_IDLE_TIMEOUT     = 0.5; /* s - keeps text cursor blinking. */
+
+static std::atomic<bool> g_is_event_loop_running               (false);
+static std::atomic<bool> g_is_redraw_requested                 (true);
+static double            g_last_on_demand_frame_time           = 0.0;
+static uint32_t          g_n_on_demand_frames_to_render        = 0;
+static bool              g_use_on_demand_rendering             = false;
+
+#if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    /* Render thread support.
+     *
+     * When the app requests a render thread, GLFW callbacks running on the main thread do not call into the app.
+     * Instead, they capture all the information needed to handle the event and push it to a lock-free queue which
+     * the render thread drains at the beginning of each frame.
+     */
+    enum class WindowEventType : uint8_t
+    {
+        CHAR,
+        CURSOR_ENTER,
+        CURSOR_POS,
+        FILE_DROP,
+        FRAMEBUFFER_SIZE,
+        KEY,
+        MOUSE_BUTTON,
+        SCROLL,
+        WINDOW_FOCUS,
+        WINDOW_SIZE,
+
+        UNKNOWN
+    };
+
+    struct WindowEvent
+    {
+        WindowEventType type;
+
+        std::chrono::steady_clock::time_point time;
+
+        double   x;
+        double   y;
+        int32_t  ints[4];
+        void*    data_ptr; /* FILE_DROP: std::vector<std::string>* owned by the consumer. */
+    };
+
+    struct RenderThreadWindowState
+    {
+        int    framebuffer_height;
+        int    framebuffer_width;
+        double last_frame_time;
+        int    window_height;
+        int    window_width;
+
+        RenderThreadWindowState()
+            :framebuffer_height(0),
+             framebuffer_width (0),
+             last_frame_time   (0.0),
+             window_height     (0),
+             window_width      (0)
+        {
+            /* Stub */
+        }
+    };
+
+    static Framework::SPSCQueue<WindowEvent, 4096> g_window_event_queue;
+#endif
+
+#if !defined(__EMSCRIPTEN__)
+    static std::atomic<bool>       g_render_thread_done            (false);
+    static std::atomic<bool>       g_render_thread_should_quit     (false);
+    static std::condition_variable g_render_thread_wake_up_cv;
+    static std::mutex              g_render_thread_wake_up_mutex;
+    static bool                    g_render_thread_wake_up_pending = false;
+
+    /* Pipelined frame execution support.
+     *
+     * The worker thread builds ImGui UI for the next frame and copies the resulting draw data into one of two
+     * snapshots, while the GL thread submits the other one. Draw lists in the snapshots are persistent and only
+     * ever grow, so no allocations are made in steady state.
+     *
+     * There is only one ImGui context and it is not thread-safe. The renderer backend reads IO & backend state
+     * from it even when submitting snapshotted draw data, so g_imgui_context_mutex is held by the worker while
+     * it builds the UI & takes the snapshot, and by the GL thread while it submits ImGui draw data. App callbacks
+     * run outside of the lock, so update_frame() and render_frame() still overlap.
+     */
+    struct DrawDataSnapshot
+    {
+        int                      display_h;
+        int                      display_w;
+        ImDrawData               draw_data;
+        std::vector<ImDrawList*> draw_list_ptrs;
+        bool                     is_app_frame;
+        bool                     is_valid;
+
+        DrawDataSnapshot()
+            :display_h   (0),
+             display_w   (0),
+             is_app_frame(false),
+             is_valid    (false)
+        {
+            /* Stub */
+        }
+    };
+
+    static std::array<DrawDataSnapshot, 2> g_draw_data_snapshots;
+    static std::mutex                      g_imgui_context_mutex;
+    static uint32_t                        g_n_draw_data_snapshot_being_built = 0;
+    static std::condition_variable         g_pipeline_worker_cv;
+    static bool                            g_pipeline_worker_has_work         = false;
+    static std::mutex                      g_pipeline_worker_mutex;
+    static bool                            g_pipeline_worker_should_quit      = false;
+    static std::thread                     g_pipeline_worker_thread;
+    static bool                            g_use_pipelined_frames             = false;
+#endif
+
+
+#if !defined(__EMSCRIPTEN__)
+    /* Wakes the render thread up if it is idling in on-demand rendering mode. */
+    static void wake_render_thread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_render_thread_wake_up_mutex);
+
+            g_render_thread_wake_up_pending = true;
+        }
+
+        g_render_thread_wake_up_cv.notify_one();
+    }
+#endif
+
+Framework::FrameLatencyStats Framework::get_frame_latency_stats()
+{
+    return (g_frame_latency_limiter_ptr != nullptr) ? g_frame_latency_limiter_ptr->get_stats()
+                                                    : Framework::FrameLatencyStats();
+}
+
+void Framework::request_redraw()
+{
+    g_is_redraw_requested.store(true,
+                                std::memory_order_release);
+
+    #if !defined(__EMSCRIPTEN__)
+    {
+        /* Wake up whichever thread may be waiting. */
+        if (g_is_event_loop_running.load(std::memory_order_acquire) )
+        {
+            glfwPostEmptyEvent();
+        }
+
+        wake_render_thread();
+    }
+    #endif
+}
+
+#if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    static void push_window_event(const WindowEventType& in_type,
+                                  const double&          in_x        = 0.0,
+                                  const double&          in_y        = 0.0,
+                                  const int32_t&         in_int0     = 0,
+                                  const int32_t&         in_int1     = 0,
+                                  const int32_t&         in_int2     = 0,
+                                  const int32_t&         in_int3     = 0,
+                                  void*                  in_data_ptr = nullptr)
+    {
+        WindowEvent new_event;
+
+        new_event.data_ptr = in_data_ptr;
+        new_event.ints[0]  = in_int0;
+        new_event.ints[1]  = in_int1;
+        new_event.ints[2]  = in_int2;
+        new_event.ints[3]  = in_int3;
+        new_event.time     = std::chrono::steady_clock::now();
+        new_event.type     = in_type;
+        new_event.x        = in_x;
+        new_event.y        = in_y;
+
+        if (g_window_event_queue.push(new_event) )
+        {
+            #if !defined(__EMSCRIPTEN__)
+            {
+                if (g_use_on_demand_rendering)
+                {
+                    wake_render_thread();
+                }
+            }
+            #endif
+        }
+        else
+        {
+            /* The render thread has not drained the queue for a long time. Drop the event rather than block
+             * the event thread. */
+            if (in_type == WindowEventType::FILE_DROP)
+            {
+                delete reinterpret_cast<std::vector<std::string>*>(in_data_ptr);
+            }
+        }
+    }
 #endif
 
-#include <GLFW/glfw3.h>
+static double get_time()
+{
+    #if defined(__EMSCRIPTEN__)
+        /* GLFW state lives on the browser main thread, so it cannot be used to measure time on a worker. */
+        return emscripten_get_now() / 1000.0;
+    #else
+        return glfwGetTime();
+    #endif
+}
+
+static double get_on_demand_idle_timeout()
+{
+    return (ImGui::GetIO().WantTextInput) ? ON_DEMAND_TEXT_INPUT_IDLE_TIMEOUT
+                                          : ON_DEMAND_IDLE_TIMEOUT;
+}
+
+/* Returns time left until the idle timeout expires, in seconds. */
+static double get_on_demand_wait_time()
+{
+    const double time_left = g_last_on_demand_frame_time + get_on_demand_idle_timeout() - get_time();
+
+    return (time_left > 0.0) ? time_left
+                             : 0.0;
+}
+
+/* Must be called from the thread which submits frames. */
+static void mark_redraw_needed()
+{
+    g_is_redraw_requested.store(true,
+                                std::memory_order_release);
+}
+
+/* Decides whether a new frame should be rendered in on-demand rendering mode. Must be called once per main loop
+ * iteration, from the thread which submits frames. */
+static bool should_render_on_demand_frame()
+{
+    const double current_time = get_time();
+    bool         result       = false;
+
+    if (g_is_redraw_requested.exchange(false,
+                                       std::memory_order_acq_rel) )
+    {
+        g_n_on_demand_frames_to_render = N_FRAMES_TO_RENDER_PER_REDRAW_REQUEST;
+    }
+
+    if (g_n_on_demand_frames_to_render > 0)
+    {
+        g_n_on_demand_frames_to_render--;
+
+        result = true;
+    }
+    else
+    {
+        result = (current_time - g_last_on_demand_frame_time >= get_on_demand_idle_timeout() );
+    }
+
+    if (result)
+    {
+        g_last_on_demand_frame_time = current_time;
+    }
+
+    return result;
+}
+
+static void on_input_event(const std::chrono::steady_clock::time_point& in_event_time)
+{
+    if (g_frame_latency_limiter_ptr != nullptr)
+    {
+        g_frame_latency_limiter_ptr->on_input_event(in_event_time);
+    }
+
+    mark_redraw_needed();
+}
+
+/* Queues a live input event for the app & records it, if requested. */
+static void push_input_event(const InputEvent& in_event)
+{
+    if (g_input_player_ptr != nullptr)
+    {
+        /* Replayed events are queued by replay_input_events() instead. */
+        goto end;
+    }
+
+    if (g_input_recorder_ptr != nullptr)
+    {
+        g_input_recorder_ptr->record_input_event(g_n_frame,
+                                                 in_event);
+    }
+
+    g_input_event_queue_ptr->push(in_event);
+
+end:
+    ;
+}
+
+static void queue_input_event(const InputEventType&                        in_type,
+                              const std::chrono::steady_clock::time_point& in_time,
+                              const double&                                in_x,
+                              const double&                                in_y,
+                              const MouseButton&                           in_mouse_button = MouseButton::UNKNOWN,
+                              const bool&                                  in_is_pressed   = false)
+{
+    InputEvent new_event;
+
+    new_event.is_pressed   = in_is_pressed;
+    new_event.mouse_button = in_mouse_button;
+    new_event.time         = in_time;
+    new_event.type         = in_type;
+    new_event.x            = in_x;
+    new_event.y            = in_y;
+
+    push_input_event(new_event);
+}
+
+static void queue_char_input_event(const std::chrono::steady_clock::time_point& in_time,
+                                   const uint32_t&                              in_codepoint)
+{
+    InputEvent new_event;
+
+    new_event.codepoint = in_codepoint;
+    new_event.time      = in_time;
+    new_event.type      = InputEventType::CHAR;
+
+    push_input_event(new_event);
+}
+
+static void queue_key_input_event(const std::chrono::steady_clock::time_point& in_time,
+                                  const int&                                   in_key,
+                                  const int&                                   in_action,
+                                  const int&                                   in_mods)
+{
+    InputEvent new_event;
+
+    new_event.key        = in_key;
+    new_event.key_action = in_action;
+    new_event.key_mods   = in_mods;
+    new_event.time       = in_time;
+    new_event.type       = InputEventType::KEY;
+
+    push_input_event(new_event);
+}
+
+static ImGuiKey glfw_key_to_imgui_key(const int& in_key)
+{
+    if (in_key >= GLFW_KEY_0 && in_key <= GLFW_KEY_9)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_0 + (in_key - GLFW_KEY_0) );
+    }
+
+    if (in_key >= GLFW_KEY_A && in_key <= GLFW_KEY_Z)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_A + (in_key - GLFW_KEY_A) );
+    }
+
+    if (in_key >= GLFW_KEY_F1 && in_key <= GLFW_KEY_F12)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_F1 + (in_key - GLFW_KEY_F1) );
+    }
+
+    if (in_key >= GLFW_KEY_KP_0 && in_key <= GLFW_KEY_KP_9)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_Keypad0 + (in_key - GLFW_KEY_KP_0) );
+    }
+
+    switch (in_key)
+    {
+        case GLFW_KEY_APOSTROPHE:    return ImGuiKey_Apostrophe;
+        case GLFW_KEY_BACKSLASH:     return ImGuiKey_Backslash;
+        case GLFW_KEY_BACKSPACE:     return ImGuiKey_Backspace;
+        case GLFW_KEY_CAPS_LOCK:     return ImGuiKey_CapsLock;
+        case GLFW_KEY_COMMA:         return ImGuiKey_Comma;
+        case GLFW_KEY_DELETE:        return ImGuiKey_Delete;
+        case GLFW_KEY_DOWN:          return ImGuiKey_DownArrow;
+        case GLFW_KEY_END:           return ImGuiKey_End;
+        case GLFW_KEY_ENTER:         return ImGuiKey_Enter;
+        case GLFW_KEY_EQUAL:         return ImGuiKey_Equal;
+        case GLFW_KEY_ESCAPE:        return ImGuiKey_Escape;
+        case GLFW_KEY_GRAVE_ACCENT:  return ImGuiKey_GraveAccent;
+        case GLFW_KEY_HOME:          return ImGuiKey_Home;
+        case GLFW_KEY_INSERT:        return ImGuiKey_Insert;
+        case GLFW_KEY_KP_ADD:        return ImGuiKey_KeypadAdd;
+        case GLFW_KEY_KP_DECIMAL:    return ImGuiKey_KeypadDecimal;
+        case GLFW_KEY_KP_DIVIDE:     return ImGuiKey_KeypadDivide;
+        case GLFW_KEY_KP_ENTER:      return ImGuiKey_KeypadEnter;
+        case GLFW_KEY_KP_EQUAL:      return ImGuiKey_KeypadEqual;
+        case GLFW_KEY_KP_MULTIPLY:   return ImGuiKey_KeypadMultiply;
+        case GLFW_KEY_KP_SUBTRACT:   return ImGuiKey_KeypadSubtract;
+        case GLFW_KEY_LEFT:          return ImGuiKey_LeftArrow;
+        case GLFW_KEY_LEFT_ALT:      return ImGuiKey_LeftAlt;
+        case GLFW_KEY_LEFT_BRACKET:  return ImGuiKey_LeftBracket;
+        case GLFW_KEY_LEFT_CONTROL:  return ImGuiKey_LeftCtrl;
+        case GLFW_KEY_LEFT_SHIFT:    return ImGuiKey_LeftShift;
+        case GLFW_KEY_LEFT_SUPER:    return ImGuiKey_LeftSuper;
+        case GLFW_KEY_MENU:          return ImGuiKey_Menu;
+        case GLFW_KEY_MINUS:         return ImGuiKey_Minus;
+        case GLFW_KEY_PAGE_DOWN:     return ImGuiKey_PageDown;
+        case GLFW_KEY_PAGE_UP:       return ImGuiKey_PageUp;
+        case GLFW_KEY_PERIOD:        return ImGuiKey_Period;
+        case GLFW_KEY_RIGHT:         return ImGuiKey_RightArrow;
+        case GLFW_KEY_RIGHT_ALT:     return ImGuiKey_RightAlt;
+        case GLFW_KEY_RIGHT_BRACKET: return ImGuiKey_RightBracket;
+        case GLFW_KEY_RIGHT_CONTROL: return ImGuiKey_RightCtrl;
+        case GLFW_KEY_RIGHT_SHIFT:   return ImGuiKey_RightShift;
+        case GLFW_KEY_RIGHT_SUPER:   return ImGuiKey_RightSuper;
+        case GLFW_KEY_SEMICOLON:     return ImGuiKey_Semicolon;
+        case GLFW_KEY_SLASH:         return ImGuiKey_Slash;
+        case GLFW_KEY_SPACE:         return ImGuiKey_Space;
+        case GLFW_KEY_TAB:           return ImGuiKey_Tab;
+        case GLFW_KEY_UP:            return ImGuiKey_UpArrow;
+
+        default:
+        {
+            return ImGuiKey_None;
+        }
+    }
+}
+
+/* Feeds a key event to ImGui, the same way ImGui's GLFW backend does. */
+static void add_imgui_key_event(const int& in_key,
+                                const int& in_action,
+                                const int& in_mods)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (in_action != GLFW_PRESS   &&
+        in_action != GLFW_RELEASE)
+    {
+        /* ImGui handles key repeat on its own. */
+        goto end;
+    }
+
+    io.AddKeyEvent(ImGuiMod_Ctrl,  (in_mods & GLFW_MOD_CONTROL) != 0);
+    io.AddKeyEvent(ImGuiMod_Shift, (in_mods & GLFW_MOD_SHIFT)   != 0);
+    io.AddKeyEvent(ImGuiMod_Alt,   (in_mods & GLFW_MOD_ALT)     != 0);
+    io.AddKeyEvent(ImGuiMod_Super, (in_mods & GLFW_MOD_SUPER)   != 0);
+
+    {
+        const ImGuiKey imgui_key = glfw_key_to_imgui_key(in_key);
+
+        if (imgui_key != ImGuiKey_None)
+        {
+            io.AddKeyEvent(imgui_key,
+                           (in_action == GLFW_PRESS) );
+        }
+    }
+
+end:
+    ;
+}
+
+/* Feeds replayed input events & the recorded display size to ImGui, in place of ImGui's GLFW backend. */
+static void update_imgui_replay_state(const InputEventBatch& in_batch,
+                                      const int&             in_display_w,
+                                      const int&             in_display_h)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    /* A fixed time step keeps replayed UI animations deterministic. */
+    io.DeltaTime               = 1.0f / 60.0f;
+    io.DisplayFramebufferScale = ImVec2(1.0f,
+                                        1.0f);
+    io.DisplaySize             = ImVec2(static_cast<float>(in_display_w),
+                                        static_cast<float>(in_display_h) );
+
+    for (uint32_t n_event = 0;
+                  n_event < in_batch.n_events;
+                ++n_event)
+    {
+        const auto& current_event = in_batch.events_ptr[n_event];
+
+        switch (current_event.type)
+        {
+            case InputEventType::CHAR:
+            {
+                io.AddInputCharacter(current_event.codepoint);
+
+                break;
+            }
+
+            case InputEventType::KEY:
+            {
+                add_imgui_key_event(current_event.key,
+                                    current_event.key_action,
+                                    current_event.key_mods);
+
+                break;
+            }
+
+            case InputEventType::MOUSE_BUTTON:
+            case InputEventType::MOUSE_POS:
+            {
+                io.AddMousePosEvent(static_cast<float>(current_event.x),
+                                    static_cast<float>(current_event.y) );
+
+                if (current_event.type         == InputEventType::MOUSE_BUTTON &&
+                    current_event.mouse_button != MouseButton::UNKNOWN)
+                {
+                    io.AddMouseButtonEvent(static_cast<int>(current_event.mouse_button), /* MouseButton matches ImGuiMouseButton */
+                                           current_event.is_pressed);
+                }
+
+                break;
+            }
+
+            case InputEventType::SCROLL:
+            {
+                io.AddMouseWheelEvent(static_cast<float>(current_event.x),
+                                      static_cast<float>(current_event.y) );
+
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+}
+
+/* Resizes the window, so that its framebuffer matches the recorded one. Must be called from the main thread. */
+static void resize_window_for_replay(const int& in_framebuffer_w,
+                                     const int& in_framebuffer_h)
+{
+    int framebuffer_h = 0;
+    int framebuffer_w = 0;
+    int window_h      = 0;
+    int window_w      = 0;
+
+    glfwGetFramebufferSize(g_window_ptr,
+                          &framebuffer_w,
+                          &framebuffer_h);
+
+    if (framebuffer_w <= 0                   ||
+        framebuffer_h <= 0                   ||
+        (framebuffer_w == in_framebuffer_w &&
+         framebuffer_h == in_framebuffer_h) )
+    {
+        goto end;
+    }
+
+    glfwGetWindowSize(g_window_ptr,
+                     &window_w,
+                     &window_h);
+
+    /* Window size is expressed in screen coordinates, which may differ from pixels. */
+    glfwSetWindowSize(g_window_ptr,
+                      in_framebuffer_w * window_w / framebuffer_w,
+                      in_framebuffer_h * window_h / framebuffer_h);
+
+end:
+    ;
+}
+
+/* Prints replay timings & asks the app to quit. Called once all recorded frames have been replayed. */
+static void finish_replay()
+{
+    const auto   current_time  = std::chrono::steady_clock::now();
+    const double total_time_ms = std::chrono::duration<double, std::milli>(current_time - g_replay_start_time).count();
+    const auto   n_frames      = g_input_player_ptr->get_n_frames();
+
+    printf("Replayed %u frame(s) in %.3f ms: avg %.3f ms, min %.3f ms, max %.3f ms (%.1f FPS).\n",
+           n_frames,
+           total_time_ms,
+           (n_frames > 0) ? total_time_ms / static_cast<double>(n_frames) : 0.0,
+           g_replay_min_frame_time_ms,
+           g_replay_max_frame_time_ms,
+           (total_time_ms > 0.0) ? 1000.0 * static_cast<double>(n_frames) / total_time_ms : 0.0);
+    fflush(stdout);
+
+    g_input_player_ptr.reset();
+
+    glfwSetWindowShouldClose(g_window_ptr,
+                             1);
+
+    #if !defined(__EMSCRIPTEN__)
+    {
+        glfwPostEmptyEvent();
+    }
+    #endif
+}
+
+/* Replays recorded input of the frame being prepared in place of live input. */
+static void replay_input_events(int* inout_display_w_ptr,
+                                int* inout_display_h_ptr)
+{
+    const auto current_time = std::chrono::steady_clock::now();
+
+    g_input_event_queue_ptr->clear();
+
+    if (g_n_frame == 0)
+    {
+        g_replay_last_frame_time = current_time;
+        g_replay_start_time      = current_time;
+    }
+    else
+    {
+        const double frame_time_ms = std::chrono::duration<double, std::milli>(current_time - g_replay_last_frame_time).count();
+
+        g_replay_last_frame_time   = current_time;
+        g_replay_max_frame_time_ms = (g_n_frame == 1) ? frame_time_ms : std::max(g_replay_max_frame_time_ms, frame_time_ms);
+        g_replay_min_frame_time_ms = (g_n_frame == 1) ? frame_time_ms : std::min(g_replay_min_frame_time_ms, frame_time_ms);
+    }
+
+    if (g_n_frame >= g_input_player_ptr->get_n_frames() )
+    {
+        finish_replay();
+
+        goto end;
+    }
+
+    if (!g_input_player_ptr->play_frame(g_n_frame,
+                                        g_input_event_queue_ptr.get(),
+                                        inout_display_w_ptr,
+                                        inout_display_h_ptr,
+                                       &g_replayed_file_drop_vec) )
+    {
+        g_input_player_ptr.reset();
+
+        goto end;
+    }
+
+    update_imgui_replay_state(g_input_event_queue_ptr->get_batch(),
+                              *inout_display_w_ptr,
+                              *inout_display_h_ptr);
+
+    if (!g_use_render_thread)
+    {
+        resize_window_for_replay(*inout_display_w_ptr,
+                                 *inout_display_h_ptr);
+    }
+
+    for (auto& current_file_drop : g_replayed_file_drop_vec)
+    {
+        g_app_ptr->on_file_dropped_callback(current_file_drop.filename,
+                                            std::move(current_file_drop.data_u8_vec_ptr) );
+    }
+
+    g_replayed_file_drop_vec.clear();
+
+end:
+    ;
+}
+
+/* Hands all input events gathered since the previous frame over to the app. Must be called from the thread which
+ * invokes app callbacks, right before a new frame is built.
+ *
+ * When replaying, the display size is overwritten with the recorded one. */
+static void dispatch_input_events(int* inout_display_w_ptr,
+                                  int* inout_display_h_ptr)
+{
+    if (g_input_player_ptr != nullptr)
+    {
+        replay_input_events(inout_display_w_ptr,
+                            inout_display_h_ptr);
+    }
+
+    {
+        const auto batch = g_input_event_queue_ptr->get_batch();
+
+        if (g_input_recorder_ptr != nullptr)
+        {
+            /* Input events have been recorded as they were queued. */
+            g_input_recorder_ptr->record_framebuffer_size(g_n_frame,
+                                                          *inout_display_w_ptr,
+                                                          *inout_display_h_ptr);
+        }
+
+        if (batch.n_events                      > 0 ||
+            batch.n_mouse_motion_history_events > 0)
+        {
+            g_app_ptr->on_input_events(batch);
+        }
+    }
+
+    g_input_event_queue_ptr->clear();
+
+    ++g_n_frame;
+}
+
+static void load_dropped_files(const std::vector<std::string>& in_paths)
+{
+    FRAMEWORK_TRACE_SCOPE("load_dropped_files");
+
+    /* Cache each file and report to the app. */
+    assert(g_app_ptr != nullptr);
+
+    if (g_input_player_ptr != nullptr)
+    {
+        /* Replayed file drops are delivered by dispatch_input_events(). */
+        goto end;
+    }
+
+    for (const auto& current_path : in_paths)
+    {
+        auto file_data_u8_vec_ptr = Framework::read_file(current_path);
+
+        if (file_data_u8_vec_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        #if defined(__EMSCRIPTEN__)
+        {
+            ::unlink(current_path.c_str() );
+        }
+        #endif
+
+        if (file_data_u8_vec_ptr->size() > 0)
+        {
+            if (g_input_recorder_ptr != nullptr)
+            {
+                g_input_recorder_ptr->record_file_drop(g_n_frame,
+                                                       current_path,
+                                                       *file_data_u8_vec_ptr);
+            }
+
+            g_app_ptr->on_file_dropped_callback(current_path,
+                                                std::move(file_data_u8_vec_ptr) );
+        }
+    }
+
+end:
+    ;
+}
+
+static void glfw_cursorpos_callback(GLFWwindow* window,
+                                    double      x,
+                                    double      y)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::CURSOR_POS,
+                              x,
+                              y);
+
+            return;
+        }
+    }
+    #endif
+
+    {
+        const auto event_time = std::chrono::steady_clock::now();
+
+        on_input_event   (event_time);
+        queue_input_event(InputEventType::MOUSE_POS,
+                          event_time,
+                          x,
+                          y);
+    }
+}
+
+static void glfw_drop_callback(GLFWwindow* window,
+                               int         n_paths,
+                               const char* paths[])
+{
+    std::vector<std::string>* paths_ptr = new std::vector<std::string>(paths,
+                                                                       paths + n_paths);
+
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            /* Let the render thread do the actual loading, so that the event thread is not blocked on file I/O. */
+            push_window_event(WindowEventType::FILE_DROP,
+                              0.0,       /* in_x    */
+                              0.0,       /* in_y    */
+                              0,         /* in_int0 */
+                              0,         /* in_int1 */
+                              0,         /* in_int2 */
+                              0,         /* in_int3 */
+                              paths_ptr);
+
+            return;
+        }
+    }
+    #endif
+
+    load_dropped_files(*paths_ptr);
+
+    delete paths_ptr;
+}
+
+static void glfw_error_callback(int         error,
+                                const char* description)
+{
+    Framework::report_error("GLFW reported an error: %s",
+                            description);
+}
+
+static void glfw_mousebutton_callback(GLFWwindow* window,
+                                      int         button,
+                                      int         action,
+                                      int         mods)
+{
+    const bool is_pressed   = (action == GLFW_PRESS);
+    const auto mouse_button = (button == GLFW_MOUSE_BUTTON_LEFT)   ? MouseButton::LEFT
+                            : (button == GLFW_MOUSE_BUTTON_RIGHT)  ? MouseButton::RIGHT
+                            : (button == GLFW_MOUSE_BUTTON_MIDDLE) ? MouseButton::MIDDLE
+                                                                   : MouseButton::UNKNOWN;
+    double     x            = 0;
+    double     y            = 0;
+
+    glfwGetCursorPos(window,
+                    &x,
+                    &y);
+
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::MOUSE_BUTTON,
+                              x,
+                              y,
+                              button,
+                              action,
+                              mods);
+
+            return;
+        }
+    }
+    #endif
+
+    {
+        const auto event_time = std::chrono::steady_clock::now();
+
+        on_input_event(event_time);
+
+        if (mouse_button != MouseButton::UNKNOWN)
+        {
+            queue_input_event(InputEventType::MOUSE_BUTTON,
+                              event_time,
+                              x,
+                              y,
+                              mouse_button,
+                              is_pressed);
+        }
+    }
+}
+
+static void glfw_scroll_callback(GLFWwindow* window,
+                                 double      xoffset,
+                                 double      yoffset)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::SCROLL,
+                              xoffset,
+                              yoffset);
+
+            return;
+        }
+    }
+    #endif
+
+    {
+        const auto event_time = std::chrono::steady_clock::now();
+
+        on_input_event   (event_time);
+        queue_input_event(InputEventType::SCROLL,
+                          event_time,
+                          xoffset,
+                          yoffset);
+    }
+}
+
+static void glfw_char_callback(GLFWwindow*  window,
+                               unsigned int codepoint)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::CHAR,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              static_cast<int32_t>(codepoint) );
+
+            return;
+        }
+    }
+    #endif
+
+    {
+        const auto event_time = std::chrono::steady_clock::now();
+
+        on_input_event        (event_time);
+        queue_char_input_event(event_time,
+                               codepoint);
+    }
+}
+
+static void glfw_cursorenter_callback(GLFWwindow* window,
+                                      int         entered)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::CURSOR_ENTER,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              entered);
+
+            return;
+        }
+    }
+    #endif
+
+    mark_redraw_needed();
+}
+
+static void glfw_framebuffersize_callback(GLFWwindow* window,
+                                          int         width,
+                                          int         height)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::FRAMEBUFFER_SIZE,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              width,
+                              height);
+
+            return;
+        }
+    }
+    #endif
+
+    mark_redraw_needed();
+}
+
+static void glfw_key_callback(GLFWwindow* window,
+                              int         key,
+                              int         scancode,
+                              int         action,
+                              int         mods)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::KEY,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              key,
+                              scancode,
+                              action,
+                              mods);
+
+            return;
+        }
+    }
+    #endif
+
+    {
+        const auto event_time = std::chrono::steady_clock::now();
+
+        on_input_event       (event_time);
+        queue_key_input_event(event_time,
+                              key,
+                              action,
+                              mods);
+    }
+}
+
+static void glfw_windowfocus_callback(GLFWwindow* window,
+                                      int         focused)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::WINDOW_FOCUS,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              focused);
+
+            return;
+        }
+    }
+    #endif
+
+    mark_redraw_needed();
+}
+
+static void glfw_windowsize_callback(GLFWwindow* window,
+                                     int         width,
+                                     int         height)
+{
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
+        {
+            push_window_event(WindowEventType::WINDOW_SIZE,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              width,
+                              height);
+
+            return;
+        }
+    }
+    #endif
+
+    mark_redraw_needed();
+}
+
+#if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    /* Handles an event captured on the main thread. Since ImGui's GLFW backend cannot be used off the main thread,
+     * input is fed to ImGui directly. */
+    static void process_window_event(const WindowEvent&       in_event,
+                                     RenderThreadWindowState* inout_state_ptr)
+    {
+        ImGuiIO&   io                  = ImGui::GetIO();
+        const bool is_imgui_input_live = (g_input_player_ptr == nullptr); /* Replayed input is fed to ImGui instead. */
+
+        if (in_event.type == WindowEventType::CHAR         ||
+            in_event.type == WindowEventType::CURSOR_POS   ||
+            in_event.type == WindowEventType::KEY          ||
+            in_event.type == WindowEventType::MOUSE_BUTTON ||
+            in_event.type == WindowEventType::SCROLL)
+        {
+            on_input_event(in_event.time);
+        }
+        else
+        {
+            mark_redraw_needed();
+        }
+
+        switch (in_event.type)
+        {
+            case WindowEventType::CHAR:
+            {
+                if (is_imgui_input_live)
+                {
+                    io.AddInputCharacter(static_cast<unsigned int>(in_event.ints[0]) );
+                }
+
+                queue_char_input_event(in_event.time,
+                                       static_cast<uint32_t>(in_event.ints[0]) );
+
+                break;
+            }
+
+            case WindowEventType::CURSOR_ENTER:
+            {
+                if (in_event.ints[0] == GLFW_FALSE)
+                {
+                    io.AddMousePosEvent(-FLT_MAX,
+                                        -FLT_MAX);
+                }
+
+                break;
+            }
+
+            case WindowEventType::CURSOR_POS:
+            {
+                if (is_imgui_input_live)
+                {
+                    io.AddMousePosEvent(static_cast<float>(in_event.x),
+                                        static_cast<float>(in_event.y) );
+                }
+
+                queue_input_event(InputEventType::MOUSE_POS,
+                                  in_event.time,
+                                  in_event.x,
+                                  in_event.y);
+
+                break;
+            }
+
+            case WindowEventType::FILE_DROP:
+            {
+                std::unique_ptr<std::vector<std::string> > paths_ptr(reinterpret_cast<std::vector<std::string>*>(in_event.data_ptr) );
+
+                load_dropped_files(*paths_ptr);
+
+                break;
+            }
+
+            case WindowEventType::FRAMEBUFFER_SIZE:
+            {
+                inout_state_ptr->framebuffer_width  = in_event.ints[0];
+                inout_state_ptr->framebuffer_height = in_event.ints[1];
+
+                break;
+            }
+
+            case WindowEventType::KEY:
+            {
+                if (is_imgui_input_live)
+                {
+                    add_imgui_key_event(in_event.ints[0],  /* in_key    */
+                                        in_event.ints[2],  /* in_action */
+                                        in_event.ints[3]); /* in_mods   */
+                }
+
+                queue_key_input_event(in_event.time,
+                                      in_event.ints[0],  /* in_key    */
+                                      in_event.ints[2],  /* in_action */
+                                      in_event.ints[3]); /* in_mods   */
+
+                break;
+            }
+
+            case WindowEventType::MOUSE_BUTTON:
+            {
+                const int  button       = in_event.ints[0];
+                const bool is_pressed   = (in_event.ints[1] == GLFW_PRESS);
+                const auto mouse_button = (button == GLFW_MOUSE_BUTTON_LEFT)   ? MouseButton::LEFT
+                                        : (button == GLFW_MOUSE_BUTTON_RIGHT)  ? MouseButton::RIGHT
+                                        : (button == GLFW_MOUSE_BUTTON_MIDDLE) ? MouseButton::MIDDLE
+                                                                               : MouseButton::UNKNOWN;
+
+                if (is_imgui_input_live      &&
+                    button >= 0 && button < 5)
+                {
+                    io.AddMouseButtonEvent(button,
+                                           is_pressed);
+                }
+
+                if (mouse_button != MouseButton::UNKNOWN)
+                {
+                    queue_input_event(InputEventType::MOUSE_BUTTON,
+                                      in_event.time,
+                                      in_event.x,
+                                      in_event.y,
+                                      mouse_button,
+                                      is_pressed);
+                }
+
+                break;
+            }
+
+            case WindowEventType::SCROLL:
+            {
+                if (is_imgui_input_live)
+                {
+                    io.AddMouseWheelEvent(static_cast<float>(in_event.x),
+                                          static_cast<float>(in_event.y) );
+                }
+
+                queue_input_event(InputEventType::SCROLL,
+                                  in_event.time,
+                                  in_event.x,
+                                  in_event.y);
+
+                break;
+            }
+
+            case WindowEventType::WINDOW_FOCUS:
+            {
+                io.AddFocusEvent(in_event.ints[0] != GLFW_FALSE);
+
+                break;
+            }
+
+            case WindowEventType::WINDOW_SIZE:
+            {
+                inout_state_ptr->window_width  = in_event.ints[0];
+                inout_state_ptr->window_height = in_event.ints[1];
+
+                break;
+            }
+
+            default:
+            {
+                assert(false);
+            }
+        }
+    }
+
+    /* Drains all events which the event thread has captured since the previous call. */
+    static void process_window_events(RenderThreadWindowState* inout_state_ptr)
+    {
+        WindowEvent current_event;
+
+        while (g_window_event_queue.pop(&current_event) )
+        {
+            process_window_event(current_event,
+                                 inout_state_ptr);
+        }
+    }
+
+    /* Updates ImGui's platform state. This is normally done by ImGui's GLFW backend. */
+    static void update_imgui_platform_state(RenderThreadWindowState* inout_state_ptr)
+    {
+        ImGuiIO&     io           = ImGui::GetIO();
+        const double current_time = get_time();
+
+        io.DisplaySize = ImVec2(static_cast<float>(inout_state_ptr->window_width),
+                                static_cast<float>(inout_state_ptr->window_height) );
+
+        if (inout_state_ptr->window_width  > 0 &&
+            inout_state_ptr->window_height > 0)
+        {
+            io.DisplayFramebufferScale = ImVec2(static_cast<float>(inout_state_ptr->framebuffer_width)  / static_cast<float>(inout_state_ptr->window_width),
+                                                static_cast<float>(inout_state_ptr->framebuffer_height) / static_cast<float>(inout_state_ptr->window_height) );
+        }
+
+        io.DeltaTime = (inout_state_ptr->last_frame_time > 0.0 && current_time > inout_state_ptr->last_frame_time) ? static_cast<float>(current_time - inout_state_ptr->last_frame_time)
+                                                                                                                    : 1.0f / 60.0f;
+
+        inout_state_ptr->last_frame_time = current_time;
+    }
+#endif
+
+#if !defined(__EMSCRIPTEN__)
+    /* Must be called right after each buffer swap. Finalizes the GL capture once all requested frames are in. */
+    static void end_gl_capture_frame()
+    {
+        if (g_gl_capture_ptr != nullptr        &&
+            !g_gl_capture_ptr->on_frame_end() )
+        {
+            g_gl_capture_ptr.reset();
+        }
+    }
+
+    /* Must be called right before each buffer swap. Asks the app to quit once the golden image test is complete. */
+    static void end_golden_image_frame(const int& in_framebuffer_width,
+                                       const int& in_framebuffer_height)
+    {
+        if (g_golden_image_test_ptr != nullptr                            &&
+            g_golden_image_test_ptr->on_frame_end(in_framebuffer_width,
+                                                  in_framebuffer_height) )
+        {
+            glfwSetWindowShouldClose(g_window_ptr,
+                                     1);
+        }
+    }
+#endif
+
+/* Creates objects which watch over frame submission. Must be called by the thread which submits frames. */
+static void create_frame_monitors()
+{
+    g_frame_latency_limiter_ptr = Framework::FrameLatencyLimiter::create(g_max_frames_in_flight);
+
+    if (g_hitch_threshold_ms > 0.0)
+    {
+        g_hitch_detector_ptr = Framework::HitchDetector::create(g_hitch_threshold_ms,
+                                                                g_n_hitch_history_frames);
+    }
+}
+
+/* Resolves GL entry-points, if needed, and installs GL instrumentation hooks in instrumented builds. Must be called
+ * with the GL context current. */
+static bool load_gl_entrypoints()
+{
+    bool result = false;
+
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (gladLoadGLES2Loader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress) ) == 0)
+        {
+            assert(false);
+
+            goto end;
+        }
+    }
+    #elif defined(FRAMEWORK_GL_INSTRUMENTATION)
+    {
+        if (gladLoadGLES2Loader(reinterpret_cast<GLADloadproc>(emscripten_webgl_get_proc_address) ) == 0)
+        {
+            assert(false);
+
+            goto end;
+        }
+    }
+    #endif
+
+    /* Installed ahead of GL capture hooks, so that capture overhead is not attributed to the driver. */
+    Framework::install_gl_instrumentation();
+
+    result = true;
+end:
+    return result;
+}
+
+#if defined(__EMSCRIPTEN__) && defined(FRAMEWORK_GL_INSTRUMENTATION)
+    /* The main loop never returns under Emscripten, so the report is printed when the page is closed instead. */
+    static const char* on_before_unload(int         event_type,
+                                        const void* reserved,
+                                        void*       user_data)
+    {
+        Framework::print_gl_instrumentation_report();
+
+        return nullptr;
+    }
+#endif
+
+static bool init_gl(GLFWwindow* in_window_ptr)
+{
+    bool result    = false;
+    bool use_vsync = (g_input_player_ptr == nullptr); /* Replays run as fast as possible. */
+
+    #if !defined(__EMSCRIPTEN__)
+    {
+        /* So do golden image tests. */
+        use_vsync &= (g_golden_image_test_ptr == nullptr);
+    }
+    #endif
+
+    glfwMakeContextCurrent(in_window_ptr);
+    glfwSwapInterval      ((use_vsync) ? 1 : 0);
+
+    if (!load_gl_entrypoints() )
+    {
+        goto end;
+    }
+
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (g_capture_gl_debug_output)
+        {
+            Framework::enable_gl_debug_output();
+        }
+
+        if (!g_gl_capture_filename.empty() )
+        {
+            int framebuffer_height = 0;
+            int framebuffer_width  = 0;
+
+            glfwGetFramebufferSize(in_window_ptr,
+                                  &framebuffer_width,
+                                  &framebuffer_height);
+
+            g_gl_capture_ptr = Framework::GLCapture::create(g_gl_capture_filename,
+                                                            g_n_gl_capture_frames,
+                                                            framebuffer_width,
+                                                            framebuffer_height);
+        }
+    }
+    #endif
+
+    result = true;
+end:
+    return result;
+}
+
+static void init_imgui(GLFWwindow* in_window_ptr,
+                       const bool& in_use_glfw_backend)
+{
+    // Setup Dear ImGui context
+    IMGUI_CHECKVERSION();
+
+    #if defined(FRAMEWORK_ALLOCATION_TRACKING)
+    {
+        /* ImGui allocates with malloc() by default, which would bypass allocation tracking. */
+        ImGui::SetAllocatorFunctions(Framework::tracked_malloc,
+                                     Framework::tracked_free);
+    }
+    #endif
+
+    ImGui::CreateContext();
+
+    {
+        ImGuiIO& io = ImGui::GetIO();
+
+        io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+        io.IniFilename  = nullptr;
+    }
+
+    ImGui::StyleColorsDark();
+
+    // Setup Platform/Renderer backends
+    if (in_use_glfw_backend)
+    {
+        ImGui_ImplGlfw_InitForOpenGL(in_window_ptr,
+                                     true); /* install_callbacks */
+
+        #ifdef __EMSCRIPTEN__
+        {
+            ImGui_ImplGlfw_InstallEmscriptenCanvasResizeCallback("#canvas");
+        }
+        #endif
+    }
+
+    ImGui_ImplOpenGL3_Init("#version 100");
+}
+
+static void deinit_imgui(const bool& in_use_glfw_backend)
+{
+    ImGui_ImplOpenGL3_Shutdown();
+
+    if (in_use_glfw_backend)
+    {
+        ImGui_ImplGlfw_Shutdown();
+    }
+
+    ImGui::DestroyContext();
+}
+
+/* Builds ImGui UI for a single frame. Returns false if the panic window was built instead of the app's UI,
+ * in which case render_frame() must not be called for the frame. */
+static bool build_frame(const int& in_display_w,
+                        const int& in_display_h)
+{
+    const bool is_app_frame = !Framework::has_reported_error();
+
+    /* Moves records logged since the previous frame to the history, echoing warnings & errors. */
+    Framework::drain_log();
+
+    ImGui::NewFrame();
+    {
+        if (is_app_frame)
+        {
+            FRAMEWORK_TRACE_SCOPE("configure_imgui");
+
+            // Let the app record imgui commands as needed..
+            g_app_ptr->configure_imgui(in_display_w,
+                                       in_display_h);
+        }
+        else
+        {
+            // Show the panic window
+            ImVec2 window_size;
+
+            ImGui::Begin("I give up.", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
+            {
+                ImGui::Text("An error was reported by the app: %s",
+                            Framework::get_reported_error().c_str() );
+
+                window_size = ImGui::GetWindowSize();
+
+                // Center it.
+                ImGui::SetWindowPos(ImVec2( (in_display_w - window_size.x) / 2, (in_display_h - window_size.y) / 2) );
+            }
+            ImGui::End();
+        }
+    }
+
+    {
+        FRAMEWORK_TRACE_SCOPE("ImGui::Render");
+
+        ImGui::Render();
+    }
+
+    return is_app_frame;
+}
+
+static void render_imgui_draw_data(ImDrawData* in_draw_data_ptr)
+{
+    FRAMEWORK_TRACE_SCOPE    ("ImGui_ImplOpenGL3_RenderDrawData");
+    FRAMEWORK_TRACE_GPU_SCOPE("ImGui");
+
+    ImGui_ImplOpenGL3_RenderDrawData(in_draw_data_ptr);
+}
+
+/* Attachments of the default framebuffer are allocated by the windowing system, so the framework registers them
+ * as render target memory itself, re-registering them whenever the framebuffer is resized. The estimate assumes
+ * GLFW's defaults: double-buffered RGBA8 color and a D24S8 depth/stencil attachment. Pass 0x0 to unregister. */
+static void update_default_framebuffer_gpu_memory(const int& in_width,
+                                                  const int& in_height)
+{
+    if (in_width  == g_default_framebuffer_width &&
+        in_height == g_default_framebuffer_height)
+    {
+        goto end;
+    }
+
+    Framework::unregister_gpu_memory(g_default_framebuffer_gpu_memory_id);
+
+    g_default_framebuffer_gpu_memory_id = 0;
+    g_default_framebuffer_height        = in_height;
+    g_default_framebuffer_width         = in_width;
+
+    if (in_width  > 0 &&
+        in_height > 0)
+    {
+        const uint64_t n_texels = static_cast<uint64_t>(in_width) * static_cast<uint64_t>(in_height);
+
+        g_default_framebuffer_gpu_memory_id = Framework::register_gpu_memory(Framework::GPUMemoryType::RENDER_TARGET,
+                                                                             "Default framebuffer",
+                                                                             n_texels * (4 /* color */ * 2 + 4 /* depth/stencil */) );
+    }
+
+end:
+    ;
+}
+
+/* Builds & submits a single frame. Platform & renderer backends must have been updated for the new frame by the caller. */
+static void run_frame(const int& in_display_w,
+                      const int& in_display_h)
+{
+    int display_h = in_display_h;
+    int display_w = in_display_w;
+
+    update_default_framebuffer_gpu_memory(in_display_w,
+                                          in_display_h);
+
+    dispatch_input_events(&display_w,
+                          &display_h);
+
+    if (build_frame(display_w,
+                    display_h) )
+    {
+        {
+            FRAMEWORK_TRACE_SCOPE("update_frame");
+
+            g_app_ptr->update_frame(display_w,
+                                    display_h);
+        }
+
+        // Follow up with a rendering callback.
+        {
+            FRAMEWORK_TRACE_SCOPE    ("render_frame");
+            FRAMEWORK_TRACE_GPU_SCOPE("render_frame");
+
+            g_app_ptr->render_frame(display_w,
+                                    display_h);
+        }
+    }
+    else
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    render_imgui_draw_data(ImGui::GetDrawData() );
+}
+
+#if !defined(__EMSCRIPTEN__)
+    template<typename T>
+    static void copy_imvector(const ImVector<T>& in_src,
+                              ImVector<T>*       out_dst_ptr)
+    {
+        /* ImVector::resize() never shrinks capacity, so this only allocates until the high watermark is reached. */
+        out_dst_ptr->resize(in_src.Size);
+
+        if (in_src.Size > 0)
+        {
+            memcpy(out_dst_ptr->Data,
+                   in_src.Data,
+                   sizeof(T) * in_src.Size);
+        }
+    }
+
+    static void snapshot_draw_data(const ImDrawData* in_draw_data_ptr,
+                                   DrawDataSnapshot* out_snapshot_ptr)
+    {
+        auto& snapshot_draw_data = out_snapshot_ptr->draw_data;
+
+        while (out_snapshot_ptr->draw_list_ptrs.size() < static_cast<size_t>(in_draw_data_ptr->CmdListsCount) )
+        {
+            out_snapshot_ptr->draw_list_ptrs.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData() ) );
+        }
+
+        snapshot_draw_data.CmdLists.resize(0);
+
+        for (int n_draw_list = 0;
+                 n_draw_list < in_draw_data_ptr->CmdListsCount;
+               ++n_draw_list)
+        {
+            const ImDrawList* src_draw_list_ptr = in_draw_data_ptr->CmdLists[n_draw_list];
+            ImDrawList*       dst_draw_list_ptr = out_snapshot_ptr->draw_list_ptrs[n_draw_list];
+
+            copy_imvector(src_draw_list_ptr->CmdBuffer,
+                         &dst_draw_list_ptr->CmdBuffer);
+            copy_imvector(src_draw_list_ptr->IdxBuffer,
+                         &dst_draw_list_ptr->IdxBuffer);
+            copy_imvector(src_draw_list_ptr->VtxBuffer,
+                         &dst_draw_list_ptr->VtxBuffer);
+
+            dst_draw_list_ptr->Flags = src_draw_list_ptr->Flags;
+
+            snapshot_draw_data.CmdLists.push_back(dst_draw_list_ptr);
+        }
+
+        snapshot_draw_data.CmdListsCount    = in_draw_data_ptr->CmdListsCount;
+        snapshot_draw_data.DisplayPos       = in_draw_data_ptr->DisplayPos;
+        snapshot_draw_data.DisplaySize      = in_draw_data_ptr->DisplaySize;
+        snapshot_draw_data.FramebufferScale = in_draw_data_ptr->FramebufferScale;
+        snapshot_draw_data.OwnerViewport    = nullptr;
+        snapshot_draw_data.TotalIdxCount    = in_draw_data_ptr->TotalIdxCount;
+        snapshot_draw_data.TotalVtxCount    = in_draw_data_ptr->TotalVtxCount;
+        snapshot_draw_data.Valid            = in_draw_data_ptr->Valid;
+    }
+
+    static void pipeline_worker_entrypoint()
+    {
+        std::unique_lock<std::mutex> lock(g_pipeline_worker_mutex);
+
+        Framework::set_trace_thread_name("Pipeline worker");
+
+        while (true)
+        {
+            g_pipeline_worker_cv.wait(lock,
+                                      []()
+                                      {
+                                          return g_pipeline_worker_has_work || g_pipeline_worker_should_quit;
+                                      });
+
+            if (g_pipeline_worker_should_quit)
+            {
+                break;
+            }
+
+            lock.unlock();
+            {
+                auto& snapshot = g_draw_data_snapshots[g_n_draw_data_snapshot_being_built];
+
+                {
+                    std::lock_guard<std::mutex> imgui_lock(g_imgui_context_mutex);
+
+                    snapshot.is_app_frame = build_frame(snapshot.display_w,
+                                                        snapshot.display_h);
+
+                    snapshot_draw_data(ImGui::GetDrawData(),
+                                      &snapshot);
+                }
+
+                if (snapshot.is_app_frame)
+                {
+                    FRAMEWORK_TRACE_SCOPE("update_frame");
+
+                    g_app_ptr->update_frame(snapshot.display_w,
+                                            snapshot.display_h);
+                }
+
+                snapshot.is_valid = true;
+            }
+            lock.lock();
+
+            g_pipeline_worker_has_work = false;
+
+            g_pipeline_worker_cv.notify_all();
+        }
+    }
+
+    static void wait_for_pipeline_worker()
+    {
+        std::unique_lock<std::mutex> lock(g_pipeline_worker_mutex);
+
+        g_pipeline_worker_cv.wait(lock,
+                                  []()
+                                  {
+                                      return !g_pipeline_worker_has_work;
+                                  });
+    }
+
+    static void start_pipeline_worker()
+    {
+        g_pipeline_worker_should_quit = false;
+        g_pipeline_worker_thread      = std::thread(pipeline_worker_entrypoint);
+    }
+
+    static void stop_pipeline_worker()
+    {
+        wait_for_pipeline_worker();
+
+        {
+            std::lock_guard<std::mutex> lock(g_pipeline_worker_mutex);
+
+            g_pipeline_worker_should_quit = true;
+        }
+
+        g_pipeline_worker_cv.notify_all();
+        g_pipeline_worker_thread.join  ();
+
+        for (auto& current_snapshot : g_draw_data_snapshots)
+        {
+            for (auto& current_draw_list_ptr : current_snapshot.draw_list_ptrs)
+            {
+                IM_DELETE(current_draw_list_ptr);
+            }
+
+            current_snapshot.draw_list_ptrs.clear();
+            current_snapshot.draw_data.CmdLists.resize(0);
+
+            current_snapshot.is_valid = false;
+        }
+    }
+
+    /* Pipelined counterpart of run_frame(). Kicks off UI construction of the new frame on the worker thread,
+     * then submits the frame which the worker built during the previous call.
+     *
+     * The worker must be idle at the time of the call (see wait_for_pipeline_worker()), and platform & renderer
+     * backends must have been updated for the new frame. */
+    static void run_pipelined_frame(const int& in_display_w,
+                                    const int& in_display_h)
+    {
+        const uint32_t n_snapshot_to_submit = g_n_draw_data_snapshot_being_built;
+        int            display_h            = in_display_h;
+        int            display_w            = in_display_w;
+
+        update_default_framebuffer_gpu_memory(in_display_w,
+                                              in_display_h);
+
+        dispatch_input_events(&display_w,
+                              &display_h);
+
+        {
+            std::lock_guard<std::mutex> lock(g_pipeline_worker_mutex);
+
+            g_n_draw_data_snapshot_being_built ^= 1;
+
+            g_draw_data_snapshots[g_n_draw_data_snapshot_being_built].display_h = display_h;
+            g_draw_data_snapshots[g_n_draw_data_snapshot_being_built].display_w = display_w;
+            g_pipeline_worker_has_work                                          = true;
+        }
+
+        g_pipeline_worker_cv.notify_all();
+
+        {
+            const auto& snapshot = g_draw_data_snapshots[n_snapshot_to_submit];
+
+            if (!snapshot.is_valid)
+            {
+                /* Very first frame - nothing has been built yet. */
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            else
+            {
+                if (snapshot.is_app_frame)
+                {
+                    FRAMEWORK_TRACE_SCOPE    ("render_frame");
+                    FRAMEWORK_TRACE_GPU_SCOPE("render_frame");
+
+                    g_app_ptr->render_frame(snapshot.display_w,
+                                            snapshot.display_h);
+                }
+                else
+                {
+                    glClear(GL_COLOR_BUFFER_BIT);
+                }
+
+                {
+                    /* The worker may be building the next frame's UI on the same ImGui context. */
+                    std::lock_guard<std::mutex> imgui_lock(g_imgui_context_mutex);
+
+                    render_imgui_draw_data(const_cast<ImDrawData*>(&snapshot.draw_data) );
+                }
+            }
+        }
+    }
+#endif
+
+#if !defined(__EMSCRIPTEN__)
+    static void render_thread_entrypoint(GLFWwindow* in_window_ptr)
+    {
+        RenderThreadWindowState window_state;
+
+        Framework::set_trace_thread_name("Render");
+
+        if (!init_gl(in_window_ptr) )
+        {
+            goto end;
+        }
+
+        init_imgui(in_window_ptr,
+                   false); /* in_use_glfw_backend */
+
+        create_frame_monitors();
+
+        if (g_use_pipelined_frames)
+        {
+            start_pipeline_worker();
+        }
+
+        while (!g_render_thread_should_quit.load(std::memory_order_acquire) )
+        {
+            if (g_use_pipelined_frames)
+            {
+                /* Events are fed to ImGui & the app below, so the worker must be done with the previous frame. */
+                wait_for_pipeline_worker();
+            }
+
+            if (g_use_on_demand_rendering)
+            {
+                process_window_events(&window_state);
+
+                if (!should_render_on_demand_frame() )
+                {
+                    std::unique_lock<std::mutex> lock(g_render_thread_wake_up_mutex);
+
+                    g_render_thread_wake_up_cv.wait_for(lock,
+                                                        std::chrono::duration<double>(get_on_demand_wait_time() ),
+                                                        []()
+                                                        {
+                                                            return g_render_thread_wake_up_pending;
+                                                        });
+
+                    g_render_thread_wake_up_pending = false;
+
+                    continue;
+                }
+            }
+
+            g_frame_latency_limiter_ptr->begin_frame(true); /* in_can_block */
+
+            if (g_hitch_detector_ptr != nullptr)
+            {
+                g_hitch_detector_ptr->begin_frame();
+            }
+
+            Framework::begin_gl_error_check_frame();
+
+            process_window_events     (&window_state);
+            update_imgui_platform_state(&window_state);
+
+            ImGui_ImplOpenGL3_NewFrame();
+
+            if (g_use_pipelined_frames)
+            {
+                run_pipelined_frame(window_state.framebuffer_width,
+                                    window_state.framebuffer_height);
+            }
+            else
+            {
+                run_frame(window_state.framebuffer_width,
+                          window_state.framebuffer_height);
+            }
+
+            {
+                FRAMEWORK_TRACE_SCOPE("glfwSwapBuffers");
+
+                glfwSwapBuffers(in_window_ptr);
+            }
+
+            g_frame_latency_limiter_ptr->end_frame();
+
+            Framework::end_gl_instrumentation_frame();
+            Framework::end_trace_frame             ();
+
+            if (g_hitch_detector_ptr != nullptr)
+            {
+                g_hitch_detector_ptr->end_frame();
+            }
+
+            end_gl_capture_frame();
+        }
+
+        if (g_use_pipelined_frames)
+        {
+            stop_pipeline_worker();
+        }
+
+        /* GL objects need to be released while the context is still current. */
+        Framework::release_trace_gl_objects();
+
+        g_gl_capture_ptr.reset           ();
+        g_frame_latency_limiter_ptr.reset();
+        g_hitch_detector_ptr.reset       ();
+        g_app_ptr.reset                  ();
+        g_input_player_ptr.reset         ();
+        g_input_recorder_ptr.reset       ();
+
+        update_default_framebuffer_gpu_memory(0,  /* in_width  */
+                                              0); /* in_height */
+
+        deinit_imgui(false); /* in_use_glfw_backend */
+
+        Framework::drain_log                     ();
+        Framework::print_gl_debug_output_report  ();
+        Framework::print_gl_instrumentation_report();
+
+        glfwMakeContextCurrent(nullptr);
+    end:
+        g_render_thread_done.store(true,
+                                   std::memory_order_release);
+
+        /* Wake up the main thread in case it is waiting for events. */
+        glfwPostEmptyEvent();
+    }
+
+    static void run_render_thread(GLFWwindow* in_window_ptr)
+    {
+        /* Seed the render thread with the initial window state. */
+        {
+            int height = 0;
+            int width  = 0;
+
+            glfwGetFramebufferSize(in_window_ptr,
+                                  &width,
+                                  &height);
+            push_window_event     (WindowEventType::FRAMEBUFFER_SIZE,
+                                   0.0, /* in_x */
+                                   0.0, /* in_y */
+                                   width,
+                                   height);
+
+            glfwGetWindowSize(in_window_ptr,
+                             &width,
+                             &height);
+            push_window_event(WindowEventType::WINDOW_SIZE,
+                              0.0, /* in_x */
+                              0.0, /* in_y */
+                              width,
+                              height);
+        }
+
+        {
+            std::thread render_thread(render_thread_entrypoint,
+                                      in_window_ptr);
+
+            /* The main thread now only pumps events. */
+            while (!glfwWindowShouldClose(in_window_ptr)                          &&
+                   !g_render_thread_done.load(std::memory_order_acquire) )
+            {
+                glfwWaitEvents();
+            }
+
+            g_render_thread_should_quit.store(true,
+                                              std::memory_order_release);
+
+            wake_render_thread();
+
+            render_thread.join();
+        }
+
+        /* Release file drop payloads which the render thread did not get to. */
+        {
+            WindowEvent current_event;
+
+            while (g_window_event_queue.pop(&current_event) )
+            {
+                if (current_event.type == WindowEventType::FILE_DROP)
+                {
+                    delete reinterpret_cast<std::vector<std::string>*>(current_event.data_ptr);
+                }
+            }
+        }
+    }
+#endif
+
+#if defined(__EMSCRIPTEN__) && defined(FRAMEWORK_USE_OFFSCREEN_CANVAS)
+    /* OffscreenCanvas support.
+     *
+     * GLFW stays on the browser main thread, where it only captures input. Control over the canvas is transferred
+     * to a worker thread which owns the WebGL context, ImGui and the app, and which runs its own main loop.
+     */
+    static RenderThreadWindowState g_offscreen_canvas_window_state;
+
+    static void offscreen_canvas_thread_frame()
+    {
+        if (g_use_on_demand_rendering)
+        {
+            process_window_events(&g_offscreen_canvas_window_state);
+
+            if (!should_render_on_demand_frame() )
+            {
+                /* The canvas retains its contents if nothing is drawn to it. */
+                return;
+            }
+        }
+
+        if (!g_frame_latency_limiter_ptr->begin_frame(false) ) /* in_can_block */
+        {
+            /* Too many frames in flight. Try again on the next animation frame. */
+            return;
+        }
+
+        if (g_hitch_detector_ptr != nullptr)
+        {
+            g_hitch_detector_ptr->begin_frame();
+        }
+
+        Framework::begin_gl_error_check_frame();
+
+        process_window_events(&g_offscreen_canvas_window_state);
+
+        /* The canvas is not resized by the main thread once its control has been transferred to the worker,
+         * so its size doubles as both window & framebuffer size. */
+        {
+            int height = 0;
+            int width  = 0;
+
+            emscripten_get_canvas_element_size("#canvas",
+                                              &width,
+                                              &height);
+
+            g_offscreen_canvas_window_state.framebuffer_height = height;
+            g_offscreen_canvas_window_state.framebuffer_width  = width;
+            g_offscreen_canvas_window_state.window_height      = height;
+            g_offscreen_canvas_window_state.window_width       = width;
+        }
+
+        update_imgui_platform_state(&g_offscreen_canvas_window_state);
+
+        ImGui_ImplOpenGL3_NewFrame();
+
+        run_frame(g_offscreen_canvas_window_state.framebuffer_width,
+                  g_offscreen_canvas_window_state.framebuffer_height);
 
-static auto        g_app_ptr               = create_app();
-static std::string g_reported_error_string;
+        /* The frame is presented once control returns to the worker's event loop. */
+        g_frame_latency_limiter_ptr->end_frame();
 
+        Framework::end_gl_instrumentation_frame();
 
-void Framework::report_error(const std::string& in_error)
-{
-    if (g_reported_error_string.size() == 0)
-    {
-        g_reported_error_string = in_error;
+        if (g_hitch_detector_ptr != nullptr)
+        {
+            g_hitch_detector_ptr->end_frame();
+        }
     }
-}
 
-static void glfw_cursorpos_callback(GLFWwindow* window,
-                                    double      x,
-                                    double      y)
-{
-    g_app_ptr->on_mouse_pos_callback(x,
-                                     y);
-}
+    /* main() has returned by the time the worker runs, so failures are reported straight to the browser console.
+     * Asserts are compiled out in release builds, which would otherwise leave the user with a blank page. */
+    static void* offscreen_canvas_thread_entrypoint(void*)
+    {
+        EmscriptenWebGLContextAttributes context_attributes;
+        EMSCRIPTEN_WEBGL_CONTEXT_HANDLE  context_handle = 0;
 
-static void glfw_drop_callback(GLFWwindow* window,
-                               int         n_paths,
-                               const char* paths[])
-{
-    /* Cache each file and report to the app. */
-    assert(g_app_ptr != nullptr);
+        emscripten_webgl_init_context_attributes(&context_attributes);
 
-    for (int32_t n_path = 0;
-                 n_path < n_paths;
-               ++n_path)
-    {
-        FILE*       file_handle = ::fopen(paths[n_path],
-                                          "rb");
-        std::string file_name   = std::string(paths[n_path]);
-        long        file_size   = 0;
+        context_attributes.majorVersion = 2;
+        context_attributes.minorVersion = 0;
+
+        context_handle = emscripten_webgl_create_context("#canvas",
+                                                         &context_attributes);
+
+        if (context_handle <= 0)
+        {
+            fprintf(stderr,
+                    "Could not create a WebGL2 context for the OffscreenCanvas worker (error %d). Make sure the page is "
+                    "served with cross-origin isolation headers (Cross-Origin-Opener-Policy: same-origin, "
+                    "Cross-Origin-Embedder-Policy: require-corp) and that the browser supports WebGL2 in workers.\n",
+                    static_cast<int>(context_handle) );
+
+            assert(false);
 
-        if (file_handle == nullptr)
+            goto end;
+        }
+
+        emscripten_webgl_make_context_current(context_handle);
+
+        if (!load_gl_entrypoints() )
         {
-            Framework::report_error("Failed to open [" + file_name + "].");
+            fprintf(stderr,
+                    "Could not load GL entry-points on the OffscreenCanvas worker.\n");
 
             goto end;
         }
 
-        ::fseek(file_handle,
-                0L,
-                SEEK_END);
+        init_imgui(nullptr, /* in_window_ptr */
+                   false);  /* in_use_glfw_backend */
+
+        create_frame_monitors();
+
+        /* Never returns. */
+        emscripten_set_main_loop(offscreen_canvas_thread_frame,
+                                 0,     /* fps                    */
+                                 true); /* simulate_infinite_loop */
+
+    end:
+        return nullptr;
+    }
+
+    static bool run_offscreen_canvas_thread()
+    {
+        pthread_attr_t thread_attributes;
+        pthread_t      thread;
+        bool           result = false;
+
+        pthread_attr_init                             (&thread_attributes);
+        emscripten_pthread_attr_settransferredcanvases(&thread_attributes,
+                                                       "#canvas");
+
+        result = (pthread_create(&thread,
+                                 &thread_attributes,
+                                 offscreen_canvas_thread_entrypoint,
+                                 nullptr) == 0);
+
+        pthread_attr_destroy(&thread_attributes);
+
+        return result;
+    }
+#endif
+
+int main(int    argc,
+         char** argv)
+{
+    FrameworkConfig config;
+    int             result     = 1;
+    GLFWwindow*     window_ptr = nullptr;
+
+    glfwSetErrorCallback(glfw_error_callback);
+
+    if (g_app_ptr == nullptr)
+    {
+        assert(false);
 
-        file_size = ::ftell(file_handle);
+        goto end;
+    }
 
-        ::fseek(file_handle,
-                0L,
-                SEEK_SET);
+    for (int n_arg = 1;
+             n_arg < argc;
+           ++n_arg)
+    {
+        const std::string current_arg = argv[n_arg];
 
-        if (file_size > 0)
+        if (current_arg == "--record" &&
+            n_arg + 1   <  argc)
         {
-            Uint8VectorUniquePtr file_data_u8_vec_ptr(new std::vector<uint8_t>(file_size) );
+            g_input_recorder_ptr = Framework::InputRecorder::create(argv[++n_arg]);
 
-            if (::fread(file_data_u8_vec_ptr->data(),
-                        static_cast<size_t>       (file_size),
-                        1u,
-                        file_handle) != 1)
+            if (g_input_recorder_ptr == nullptr)
             {
-                Framework::report_error("Failed to read drag & dropped file [" + file_name + "].");
-
                 goto end;
             }
+        }
+        else if (current_arg == "--replay" &&
+                 n_arg + 1   <  argc)
+        {
+            g_input_player_ptr = Framework::InputPlayer::create(argv[++n_arg]);
 
-            ::fclose(file_handle);
-
-            #if defined(__EMSCRIPTEN__)
+            if (g_input_player_ptr == nullptr)
             {
-                ::unlink(paths[n_path]);
+                goto end;
             }
-            #endif
-
-            g_app_ptr->on_file_dropped_callback(file_name,
-                                                std::move(file_data_u8_vec_ptr) );
         }
+        #if !defined(__EMSCRIPTEN__)
+        else if (current_arg == "--capture-gl" &&
+                 n_arg + 2   <  argc)
+        {
+            g_gl_capture_filename = argv[++n_arg];
+            g_n_gl_capture_frames = static_cast<uint32_t>(strtoul(argv[++n_arg],
+                                                                  nullptr, /* endptr */
+                                                                  10) );   /* base   */
+        }
+        else if (current_arg == "--trace" &&
+                 n_arg + 1   <  argc)
+        {
+            g_trace_filename = argv[++n_arg];
+        }
+        else if ((current_arg == "--golden-image"         ||
+                  current_arg == "--update-golden-image") &&
+                 n_arg + 2                              <  argc)
+        {
+            g_golden_image_filename = argv[++n_arg];
+            g_golden_image_mode     = (current_arg == "--golden-image") ? Framework::GoldenImageMode::CHECK
+                                                                        : Framework::GoldenImageMode::UPDATE;
+            g_n_golden_image_frames = static_cast<uint32_t>(strtoul(argv[++n_arg],
+                                                                    nullptr, /* endptr */
+                                                                    10) );   /* base   */
+        }
+        #endif
     }
 
-end:
-    ;
-}
-
-static void glfw_error_callback(int         error,
-                                const char* description)
-{
-    Framework::report_error("GLFW reported an error: " + std::string(description) );
-}
-
-static void glfw_mousebutton_callback(GLFWwindow* window,
-                                      int         button,
-                                      int         action,
-                                      int         mods)
-{
-    const bool is_pressed   = (action == GLFW_PRESS);
-    const auto mouse_button = (button == GLFW_MOUSE_BUTTON_LEFT)   ? MouseButton::LEFT
-                            : (button == GLFW_MOUSE_BUTTON_RIGHT)  ? MouseButton::RIGHT
-                            : (button == GLFW_MOUSE_BUTTON_MIDDLE) ? MouseButton::MIDDLE
-                                                                   : MouseButton::UNKNOWN;
-    double     x            = 0;
-    double     y            = 0;
+    config = g_app_ptr->get_framework_config();
 
-    glfwGetCursorPos(window,
-                    &x,
-                    &y);
+    if (g_input_player_ptr != nullptr)
+    {
+        /* Replayed frames are rendered back-to-back. */
+        config.use_on_demand_rendering = false;
+    }
 
-    if (mouse_button != MouseButton::UNKNOWN)
+    #if !defined(__EMSCRIPTEN__)
     {
-        g_app_ptr->on_mouse_button_callback(x,
-                                            y,
-                                            mouse_button,
-                                            is_pressed);
+        if (!g_golden_image_filename.empty() )
+        {
+            /* Golden image tests render frames back-to-back, on the thread which pumps window events. */
+            config.use_on_demand_rendering = false;
+            config.use_pipelined_frames    = false;
+            config.use_render_thread       = false;
+
+            g_golden_image_test_ptr = Framework::GoldenImageTest::create(g_golden_image_filename,
+                                                                         g_n_golden_image_frames,
+                                                                         g_golden_image_mode,
+                                                                         config.golden_image_tolerance,
+                                                                         config.golden_image_min_psnr_db);
+
+            if (g_golden_image_test_ptr == nullptr)
+            {
+                Framework::drain_log();
+
+                goto end;
+            }
+        }
     }
-}
+    #endif
 
-static void glfw_scroll_callback(GLFWwindow* window,
-                                 double      xoffset,
-                                 double      yoffset)
-{
-    g_app_ptr->on_scroll_callback(xoffset,
-                                  yoffset);
-}
+    g_input_event_queue_ptr   = Framework::InputEventQueue::create(config.input_event_queue_capacity,
+                                                                   config.keep_mouse_motion_history);
+    g_hitch_threshold_ms      = config.hitch_threshold_ms;
+    g_max_frames_in_flight    = config.max_frames_in_flight;
+    g_n_hitch_history_frames  = config.n_hitch_history_frames;
+    g_use_on_demand_rendering = config.use_on_demand_rendering;
 
-int main(int, char**)
-{
-    int         result     = 1;
-    GLFWwindow* window_ptr = nullptr;
+    Framework::set_gl_error_check_frame_interval(config.gl_error_check_frame_interval);
+    Framework::set_gpu_memory_budget            (config.gpu_memory_budget_bytes);
 
-    glfwSetErrorCallback(glfw_error_callback);
+    #if !defined(__EMSCRIPTEN__)
+    {
+        g_capture_gl_debug_output = config.capture_gl_debug_output;
+        g_use_pipelined_frames    = config.use_pipelined_frames;
+        g_use_render_thread       = config.use_render_thread;
+
+        if (!g_trace_filename.empty() )
+        {
+            Framework::start_tracing        (config.max_trace_zones_per_thread);
+            Framework::set_trace_thread_name("Main");
+        }
+    }
+    #elif defined(FRAMEWORK_USE_OFFSCREEN_CANVAS)
+    {
+        /* Build-time opt-in, takes precedence over FrameworkConfig. */
+        g_use_render_thread = true;
+    }
+    #endif
 
     if (!glfwInit() )
     {
@@ -180,6 +2354,27 @@ int main(int, char**)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
     glfwWindowHint(GLFW_CLIENT_API,            GLFW_OPENGL_ES_API);
 
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (g_capture_gl_debug_output)
+        {
+            glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+        }
+
+        if (g_golden_image_test_ptr != nullptr)
+        {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        }
+    }
+    #endif
+
+    #if defined(__EMSCRIPTEN__) && defined(FRAMEWORK_USE_OFFSCREEN_CANVAS)
+    {
+        /* The WebGL context is created by the worker thread instead. */
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    }
+    #endif
+
     // Create window with graphics context
     window_ptr = glfwCreateWindow(1280,
                                   720,
@@ -194,60 +2389,101 @@ int main(int, char**)
         goto end;
     }
 
-    if (g_app_ptr == nullptr)
-    {
-        assert(false);
-
-        goto end;
-    }
+    g_window_ptr = window_ptr;
 
+    /* ImGui's GLFW backend, if used, chains to these callbacks. */
+    glfwSetCharCallback       (window_ptr, glfw_char_callback);
     glfwSetDropCallback       (window_ptr, glfw_drop_callback);
+    glfwSetKeyCallback        (window_ptr, glfw_key_callback);
     glfwSetMouseButtonCallback(window_ptr, glfw_mousebutton_callback);
     glfwSetCursorPosCallback  (window_ptr, glfw_cursorpos_callback);
     glfwSetScrollCallback     (window_ptr, glfw_scroll_callback);
 
-    glfwMakeContextCurrent(window_ptr);
-    glfwSwapInterval      (1); // Enable vsync
+    if (g_use_on_demand_rendering ||
+        g_use_render_thread)
+    {
+        /* In render thread mode, ImGui's GLFW backend is not used, so capture the events it would normally handle.
+         * In on-demand rendering mode, these callbacks request a redraw. */
+        glfwSetCursorEnterCallback    (window_ptr, glfw_cursorenter_callback);
+        glfwSetFramebufferSizeCallback(window_ptr, glfw_framebuffersize_callback);
+        glfwSetWindowFocusCallback    (window_ptr, glfw_windowfocus_callback);
+        glfwSetWindowSizeCallback     (window_ptr, glfw_windowsize_callback);
+    }
 
-    #if !defined(__EMSCRIPTEN__)
+    g_is_event_loop_running.store(true,
+                                  std::memory_order_release);
+
+    #if defined(__EMSCRIPTEN__) && defined(FRAMEWORK_GL_INSTRUMENTATION)
     {
-        int version = gladLoadGLES2Loader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress) );
+        emscripten_set_beforeunload_callback(nullptr, /* userData */
+                                             on_before_unload);
+    }
+    #endif
 
-        if (version == 0)
+    #if defined(FRAMEWORK_HAS_RENDER_THREAD)
+    {
+        if (g_use_render_thread)
         {
-            assert(false);
 
+            #if defined(__EMSCRIPTEN__)
+            {
+                /* The runtime is kept alive after main() returns, so GLFW keeps on capturing input for the worker. */
+                if (!run_offscreen_canvas_thread() )
+                {
+                    fprintf(stderr,
+                            "Could not start the OffscreenCanvas worker thread. Make sure the page is served with "
+                            "cross-origin isolation headers, so that SharedArrayBuffer & threads are available.\n");
+
+                    assert(false);
+
+                    goto end;
+                }
+            }
+            #else
+            {
+                run_render_thread(window_ptr);
+
+                g_is_event_loop_running.store(false,
+                                              std::memory_order_release);
+
+                glfwDestroyWindow(window_ptr);
+                glfwTerminate    ();
+
+                if (!g_trace_filename.empty() )
+                {
+                    Framework::stop_tracing_and_save(g_trace_filename);
+                }
+            }
+            #endif
+
+            result = 0;
             goto end;
         }
     }
     #endif
 
-    // Setup Dear ImGui context
-    IMGUI_CHECKVERSION();
-
-    ImGui::CreateContext();
-
+    if (!init_gl(window_ptr) )
     {
-        ImGuiIO& io = ImGui::GetIO();
-
-        io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-        io.IniFilename  = nullptr;
+        goto end;
     }
 
-    ImGui::StyleColorsDark();
+    /* Replays feed recorded input to ImGui, so live input must not reach it via the backend. */
+    g_use_imgui_glfw_backend = (g_input_player_ptr == nullptr);
 
-    // Setup Platform/Renderer backends
-    ImGui_ImplGlfw_InitForOpenGL(window_ptr,
-                                 true); /* install_callbacks */
+    init_imgui(window_ptr,
+               g_use_imgui_glfw_backend);
+
+    create_frame_monitors();
 
-    #ifdef __EMSCRIPTEN__
+    #if !defined(__EMSCRIPTEN__)
     {
-        ImGui_ImplGlfw_InstallEmscriptenCanvasResizeCallback("#canvas");
+        if (g_use_pipelined_frames)
+        {
+            start_pipeline_worker();
+        }
     }
     #endif
 
-    ImGui_ImplOpenGL3_Init("#version 100");
-
     // Main loop
 #ifdef __EMSCRIPTEN__
     EMSCRIPTEN_MAINLOOP_BEGIN
@@ -255,73 +2491,184 @@ int main(int, char**)
     while (!glfwWindowShouldClose(window_ptr))
 #endif
     {
-        glfwPollEvents();
-
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame   ();
+        int display_h = 0;
+        int display_w = 0;
 
-        ImGui::NewFrame();
+        #if !defined(__EMSCRIPTEN__)
         {
-            int display_h = 0;
-            int display_w = 0;
+            if (g_use_pipelined_frames)
+            {
+                /* Event callbacks touch ImGui & the app, so the worker must be done with the previous frame. */
+                wait_for_pipeline_worker();
+            }
+        }
+        #endif
 
-            glfwGetFramebufferSize(window_ptr,
-                                  &display_w,
-                                  &display_h);
+        if (g_use_on_demand_rendering)
+        {
+            #if defined(__EMSCRIPTEN__)
+            {
+                if (!should_render_on_demand_frame() )
+                {
+                    /* The canvas retains its contents if nothing is drawn to it. Leaves the main loop body until
+                     * the next animation frame. */
+                    continue;
+                }
+            }
+            #else
+            {
+                /* Callbacks invoked while waiting for events request a redraw if needed. */
+                while (!should_render_on_demand_frame() &&
+                       !glfwWindowShouldClose(window_ptr) )
+                {
+                    glfwWaitEventsTimeout(get_on_demand_wait_time() );
+                }
+            }
+            #endif
+        }
 
-            if (g_reported_error_string.size() == 0)
+        /* Events are polled after the wait, so that the frame is built from the most recent input. */
+        #if defined(__EMSCRIPTEN__)
+        {
+            if (!g_frame_latency_limiter_ptr->begin_frame(false) ) /* in_can_block */
             {
-                // Let the app record imgui commands as needed..
-                g_app_ptr->configure_imgui(display_w,
-                                           display_h);
+                /* Too many frames in flight. Leaves the main loop body until the next animation frame. */
+                continue;
+            }
+        }
+        #else
+        {
+            g_frame_latency_limiter_ptr->begin_frame(true); /* in_can_block */
+        }
+        #endif
+
+        if (g_hitch_detector_ptr != nullptr)
+        {
+            g_hitch_detector_ptr->begin_frame();
+        }
+
+        Framework::begin_gl_error_check_frame();
+
+        {
+            FRAMEWORK_TRACE_SCOPE("glfwPollEvents");
+
+            glfwPollEvents();
+        }
+
+        ImGui_ImplOpenGL3_NewFrame();
+
+        if (g_use_imgui_glfw_backend)
+        {
+            ImGui_ImplGlfw_NewFrame();
+        }
 
-                ImGui::Render();
+        glfwGetFramebufferSize(window_ptr,
+                              &display_w,
+                              &display_h);
 
-                // Follow up with a rendering callback.
-                g_app_ptr->render_frame(display_w,
-                                        display_h);
+        #if !defined(__EMSCRIPTEN__)
+        {
+            if (g_use_pipelined_frames)
+            {
+                run_pipelined_frame(display_w,
+                                    display_h);
             }
             else
             {
-                // Show the panic window
-                ImVec2 window_size;
+                run_frame(display_w,
+                          display_h);
+            }
+        }
+        #else
+        {
+            run_frame(display_w,
+                      display_h);
+        }
+        #endif
 
-                ImGui::Begin("I give up.", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
-                {
-                    ImGui::Text("An error was reported by the app: %s",
-                                g_reported_error_string.c_str() );
+        #if !defined(__EMSCRIPTEN__)
+        {
+            end_golden_image_frame(display_w,
+                                   display_h);
+        }
+        #endif
 
-                    window_size = ImGui::GetWindowSize();
+        {
+            FRAMEWORK_TRACE_SCOPE("glfwSwapBuffers");
 
-                    ImGui::SetWindowPos(ImVec2( (display_w - window_size.x) / 2, (display_h - window_size.y) / 2) );
-                }
-                ImGui::End();
+            glfwSwapBuffers(window_ptr);
+        }
 
-                // Center it.
+        g_frame_latency_limiter_ptr->end_frame();
 
-                ImGui::Render();
+        Framework::end_gl_instrumentation_frame();
+        Framework::end_trace_frame             ();
 
-                glClear(GL_COLOR_BUFFER_BIT);
-            }
+        if (g_hitch_detector_ptr != nullptr)
+        {
+            g_hitch_detector_ptr->end_frame();
         }
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData() );
 
-        glfwSwapBuffers(window_ptr);
+        #if !defined(__EMSCRIPTEN__)
+        {
+            end_gl_capture_frame();
+        }
+        #endif
     }
 #ifdef __EMSCRIPTEN__
     EMSCRIPTEN_MAINLOOP_END;
 #endif
 
-    g_app_ptr.reset();
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (g_use_pipelined_frames)
+        {
+            stop_pipeline_worker();
+        }
+
+        Framework::release_trace_gl_objects();
+
+        g_gl_capture_ptr.reset();
+    }
+    #endif
+
+    g_frame_latency_limiter_ptr.reset();
+    g_hitch_detector_ptr.reset       ();
+    g_app_ptr.reset                  ();
+    g_input_player_ptr.reset         ();
+    g_input_recorder_ptr.reset       ();
+
+    update_default_framebuffer_gpu_memory(0,  /* in_width  */
+                                          0); /* in_height */
 
     // Cleanup
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown   ();
-    ImGui::DestroyContext     ();
+    deinit_imgui(g_use_imgui_glfw_backend);
+
+    Framework::drain_log                     ();
+    Framework::print_gl_debug_output_report  ();
+    Framework::print_gl_instrumentation_report();
+
+    g_is_event_loop_running.store(false,
+                                  std::memory_order_release);
 
     glfwDestroyWindow(window_ptr);
     glfwTerminate    ();
 
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (!g_trace_filename.empty() )
+        {
+            Framework::stop_tracing_and_save(g_trace_filename);
+        }
+
+        if (g_golden_image_test_ptr != nullptr        &&
+            !g_golden_image_test_ptr->has_passed() )
+        {
+            goto end;
+        }
+    }
+    #endif
+
     result = 0;
 end:
     return result;
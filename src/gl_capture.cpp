@@ -0,0 +1,958 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gl_capture.h"
+
+#if !defined(__EMSCRIPTEN__)
+
+/* Type defs */
+typedef void (APIENTRYP PFNGLGENERICPROC)(void);
+
+static Framework::GLCapture* g_active_capture_ptr = nullptr;
+static PFNGLGENERICPROC      g_original_gl_function_ptrs[static_cast<uint32_t>(Framework::GLFunctionID::COUNT)];
+
+/* Queries context state without going through the capture hooks. */
+static GLint get_integer(const GLenum& in_pname)
+{
+    const auto get_integerv_func_ptr = reinterpret_cast<PFNGLGETINTEGERVPROC>(g_original_gl_function_ptrs[static_cast<uint32_t>(Framework::GLFunctionID::GetIntegerv)]);
+    GLint      result                = 0;
+
+    get_integerv_func_ptr(in_pname,
+                         &result);
+
+    return result;
+}
+
+static uint32_t get_bytes_per_pixel(const GLenum& in_format,
+                                    const GLenum& in_type)
+{
+    uint32_t n_bytes_per_component = 1;
+    uint32_t n_components          = 4;
+
+    switch (in_type)
+    {
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+        case GL_UNSIGNED_SHORT_5_6_5:
+        {
+            return 2;
+        }
+
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+        case GL_UNSIGNED_INT_24_8:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_5_9_9_9_REV:
+        {
+            return 4;
+        }
+
+        case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        {
+            return 8;
+        }
+
+        case GL_HALF_FLOAT:
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        {
+            n_bytes_per_component = 2;
+
+            break;
+        }
+
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        {
+            n_bytes_per_component = 4;
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    switch (in_format)
+    {
+        case GL_ALPHA:
+        case GL_DEPTH_COMPONENT:
+        case GL_LUMINANCE:
+        case GL_RED:
+        case GL_RED_INTEGER:
+        {
+            n_components = 1;
+
+            break;
+        }
+
+        case GL_DEPTH_STENCIL:
+        case GL_LUMINANCE_ALPHA:
+        case GL_RG:
+        case GL_RG_INTEGER:
+        {
+            n_components = 2;
+
+            break;
+        }
+
+        case GL_RGB:
+        case GL_RGB_INTEGER:
+        {
+            n_components = 3;
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return n_components * n_bytes_per_component;
+}
+
+/* Returns the number of bytes read from client memory by a pixel upload, following the context's unpack state.
+ * Returns 0 if the data is sourced from a pixel unpack buffer instead. */
+static uint32_t get_unpacked_image_size(const GLsizei& in_width,
+                                        const GLsizei& in_height,
+                                        const GLsizei& in_depth,
+                                        const GLenum&  in_format,
+                                        const GLenum&  in_type,
+                                        const bool&    in_is_3d)
+{
+    if (in_width                                   <= 0 ||
+        in_height                                  <= 0 ||
+        in_depth                                   <= 0 ||
+        get_integer(GL_PIXEL_UNPACK_BUFFER_BINDING) != 0)
+    {
+        return 0;
+    }
+
+    const uint32_t alignment      = static_cast<uint32_t>(get_integer(GL_UNPACK_ALIGNMENT) );
+    const uint32_t bpp            = get_bytes_per_pixel  (in_format,
+                                                          in_type);
+    const GLint    image_height   = (in_is_3d) ? get_integer(GL_UNPACK_IMAGE_HEIGHT) : 0;
+    const GLint    row_length     = get_integer(GL_UNPACK_ROW_LENGTH);
+    const uint32_t skip_images    = (in_is_3d) ? static_cast<uint32_t>(get_integer(GL_UNPACK_SKIP_IMAGES) ) : 0;
+    const uint32_t skip_pixels    = static_cast<uint32_t>(get_integer(GL_UNPACK_SKIP_PIXELS) );
+    const uint32_t skip_rows      = static_cast<uint32_t>(get_integer(GL_UNPACK_SKIP_ROWS) );
+    const uint32_t pixels_per_row = static_cast<uint32_t>( (row_length   > 0) ? row_length   : in_width);
+    const uint32_t rows_per_image = static_cast<uint32_t>( (image_height > 0) ? image_height : in_height);
+    const uint32_t row_size       = (pixels_per_row * bpp + alignment - 1) / alignment * alignment;
+
+    return (skip_images + static_cast<uint32_t>(in_depth)  - 1) * row_size * rows_per_image +
+           (skip_rows   + static_cast<uint32_t>(in_height) - 1) * row_size                  +
+           (skip_pixels + static_cast<uint32_t>(in_width) )     * bpp;
+}
+
+static void set_input_payload(const void*                  in_data_ptr,
+                              const uint32_t&              in_size,
+                              Framework::GLCapturePayload* out_payload_ptr)
+{
+    if (in_data_ptr != nullptr &&
+        in_size     >  0)
+    {
+        out_payload_ptr->data_ptr = in_data_ptr;
+        out_payload_ptr->size     = in_size;
+        out_payload_ptr->type     = Framework::GLCapturePayloadType::INPUT;
+    }
+}
+
+static void set_output_payload(void*                        in_data_ptr,
+                               const uint32_t&              in_size,
+                               Framework::GLCapturePayload* out_payload_ptr)
+{
+    if (in_data_ptr != nullptr &&
+        in_size     >  0)
+    {
+        out_payload_ptr->data_ptr = in_data_ptr;
+        out_payload_ptr->size     = in_size;
+        out_payload_ptr->type     = Framework::GLCapturePayloadType::OUTPUT;
+    }
+}
+
+static void set_string_payload(const GLchar*                in_string_ptr,
+                               Framework::GLCapturePayload* out_payload_ptr)
+{
+    if (in_string_ptr != nullptr)
+    {
+        set_input_payload(in_string_ptr,
+                          static_cast<uint32_t>(strlen(in_string_ptr) + 1),
+                          out_payload_ptr);
+    }
+}
+
+static void set_string_array_payload(const GLchar* const*         in_strings_ptr,
+                                     const GLint*                 in_opt_lengths_ptr,
+                                     const GLsizei&               in_n_strings,
+                                     Framework::GLCapturePayload* out_payload_ptr)
+{
+    out_payload_ptr->data_ptr    = in_strings_ptr;
+    out_payload_ptr->lengths_ptr = in_opt_lengths_ptr;
+    out_payload_ptr->n_strings   = static_cast<uint32_t>(in_n_strings);
+    out_payload_ptr->type        = Framework::GLCapturePayloadType::STRING_ARRAY;
+}
+
+/* Describes data referenced by pointer arguments of a call, before the call is made. Entries of
+ * @param out_payloads_ptr correspond to the function's arguments. Pointers of functions without a specialization
+ * are captured as-is. */
+template<Framework::GLFunctionID ID, typename... Args>
+static void get_payloads(Framework::GLCapturePayload* out_payloads_ptr,
+                         Args...                      in_args)
+{
+    /* Stub */
+}
+
+#define FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(delete_name, gen_name)                                    \
+    template<>                                                                                             \
+    void get_payloads<Framework::GLFunctionID::delete_name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                            GLsizei                      in_n,             \
+                                                            const GLuint*                in_names_ptr)     \
+    {                                                                                                      \
+        set_input_payload(in_names_ptr,                                                                    \
+                          static_cast<uint32_t>(in_n) * sizeof(GLuint),                                    \
+                          out_payloads_ptr + 1);                                                           \
+    }                                                                                                      \
+                                                                                                           \
+    template<>                                                                                             \
+    void get_payloads<Framework::GLFunctionID::gen_name>(Framework::GLCapturePayload* out_payloads_ptr,    \
+                                                         GLsizei                      in_n,                \
+                                                         GLuint*                      out_names_ptr)       \
+    {                                                                                                      \
+        set_output_payload(out_names_ptr,                                                                  \
+                           static_cast<uint32_t>(in_n) * sizeof(GLuint),                                   \
+                           out_payloads_ptr + 1);                                                          \
+    }
+
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteBuffers,            GenBuffers)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteFramebuffers,       GenFramebuffers)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteQueries,            GenQueries)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteRenderbuffers,      GenRenderbuffers)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteSamplers,           GenSamplers)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteTextures,           GenTextures)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteTransformFeedbacks, GenTransformFeedbacks)
+FRAMEWORK_GL_CAPTURE_NAME_ARRAY_PAYLOADS(DeleteVertexArrays,       GenVertexArrays)
+
+#define FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(name, type, n_components)                      \
+    template<>                                                                                      \
+    void get_payloads<Framework::GLFunctionID::name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                     GLint                        in_location,      \
+                                                     GLsizei                      in_count,         \
+                                                     const type*                  in_values_ptr)    \
+    {                                                                                               \
+        set_input_payload(in_values_ptr,                                                            \
+                          static_cast<uint32_t>(in_count) * n_components * sizeof(type),            \
+                          out_payloads_ptr + 2);                                                    \
+    }
+
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform1fv,  GLfloat, 1)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform1iv,  GLint,   1)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform1uiv, GLuint,  1)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform2fv,  GLfloat, 2)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform2iv,  GLint,   2)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform3fv,  GLfloat, 3)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform3iv,  GLint,   3)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform4fv,  GLfloat, 4)
+FRAMEWORK_GL_CAPTURE_UNIFORM_VECTOR_PAYLOADS(Uniform4iv,  GLint,   4)
+
+#define FRAMEWORK_GL_CAPTURE_UNIFORM_MATRIX_PAYLOADS(name, n_components)                            \
+    template<>                                                                                      \
+    void get_payloads<Framework::GLFunctionID::name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                     GLint                        in_location,      \
+                                                     GLsizei                      in_count,         \
+                                                     GLboolean                    in_transpose,     \
+                                                     const GLfloat*               in_values_ptr)    \
+    {                                                                                               \
+        set_input_payload(in_values_ptr,                                                            \
+                          static_cast<uint32_t>(in_count) * n_components * sizeof(GLfloat),         \
+                          out_payloads_ptr + 3);                                                    \
+    }
+
+FRAMEWORK_GL_CAPTURE_UNIFORM_MATRIX_PAYLOADS(UniformMatrix3fv, 9)
+FRAMEWORK_GL_CAPTURE_UNIFORM_MATRIX_PAYLOADS(UniformMatrix4fv, 16)
+
+#define FRAMEWORK_GL_CAPTURE_CLEAR_BUFFER_PAYLOADS(name, type)                                      \
+    template<>                                                                                      \
+    void get_payloads<Framework::GLFunctionID::name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                     GLenum                       in_buffer,        \
+                                                     GLint                        in_drawbuffer,    \
+                                                     const type*                  in_values_ptr)    \
+    {                                                                                               \
+        set_input_payload(in_values_ptr,                                                            \
+                          ( (in_buffer == GL_COLOR) ? 4 : 1) * sizeof(type),                        \
+                          out_payloads_ptr + 2);                                                    \
+    }
+
+FRAMEWORK_GL_CAPTURE_CLEAR_BUFFER_PAYLOADS(ClearBufferfv,  GLfloat)
+FRAMEWORK_GL_CAPTURE_CLEAR_BUFFER_PAYLOADS(ClearBufferiv,  GLint)
+FRAMEWORK_GL_CAPTURE_CLEAR_BUFFER_PAYLOADS(ClearBufferuiv, GLuint)
+
+#define FRAMEWORK_GL_CAPTURE_NAMED_LOOKUP_PAYLOADS(name)                                            \
+    template<>                                                                                      \
+    void get_payloads<Framework::GLFunctionID::name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                     GLuint                       in_program,       \
+                                                     const GLchar*                in_name_ptr)      \
+    {                                                                                               \
+        set_string_payload(in_name_ptr,                                                             \
+                           out_payloads_ptr + 1);                                                   \
+    }
+
+FRAMEWORK_GL_CAPTURE_NAMED_LOOKUP_PAYLOADS(GetAttribLocation)
+FRAMEWORK_GL_CAPTURE_NAMED_LOOKUP_PAYLOADS(GetUniformBlockIndex)
+FRAMEWORK_GL_CAPTURE_NAMED_LOOKUP_PAYLOADS(GetUniformLocation)
+
+#define FRAMEWORK_GL_CAPTURE_QUERY_PAYLOADS(name, type)                                             \
+    template<>                                                                                      \
+    void get_payloads<Framework::GLFunctionID::name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                     GLuint                       in_object,        \
+                                                     GLenum                       in_pname,         \
+                                                     type*                        out_params_ptr)   \
+    {                                                                                               \
+        set_output_payload(out_params_ptr,                                                          \
+                           sizeof(type),                                                            \
+                           out_payloads_ptr + 2);                                                   \
+    }
+
+FRAMEWORK_GL_CAPTURE_QUERY_PAYLOADS(GetProgramiv,      GLint)
+FRAMEWORK_GL_CAPTURE_QUERY_PAYLOADS(GetQueryObjectuiv, GLuint)
+FRAMEWORK_GL_CAPTURE_QUERY_PAYLOADS(GetShaderiv,       GLint)
+
+#define FRAMEWORK_GL_CAPTURE_INFO_LOG_PAYLOADS(name)                                                \
+    template<>                                                                                      \
+    void get_payloads<Framework::GLFunctionID::name>(Framework::GLCapturePayload* out_payloads_ptr, \
+                                                     GLuint                       in_object,        \
+                                                     GLsizei                      in_buffer_size,   \
+                                                     GLsizei*                     out_length_ptr,   \
+                                                     GLchar*                      out_info_log_ptr) \
+    {                                                                                               \
+        set_output_payload(out_length_ptr,                                                          \
+                           sizeof(GLsizei),                                                         \
+                           out_payloads_ptr + 2);                                                   \
+        set_output_payload(out_info_log_ptr,                                                        \
+                           static_cast<uint32_t>(in_buffer_size),                                   \
+                           out_payloads_ptr + 3);                                                   \
+    }
+
+FRAMEWORK_GL_CAPTURE_INFO_LOG_PAYLOADS(GetProgramInfoLog)
+FRAMEWORK_GL_CAPTURE_INFO_LOG_PAYLOADS(GetShaderInfoLog)
+
+template<>
+void get_payloads<Framework::GLFunctionID::BindAttribLocation>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                               GLuint                       in_program,
+                                                               GLuint                       in_index,
+                                                               const GLchar*                in_name_ptr)
+{
+    set_string_payload(in_name_ptr,
+                       out_payloads_ptr + 2);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::BufferData>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                       GLenum                       in_target,
+                                                       GLsizeiptr                   in_size,
+                                                       const void*                  in_data_ptr,
+                                                       GLenum                       in_usage)
+{
+    set_input_payload(in_data_ptr,
+                      static_cast<uint32_t>(in_size),
+                      out_payloads_ptr + 2);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::BufferSubData>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                          GLenum                       in_target,
+                                                          GLintptr                     in_offset,
+                                                          GLsizeiptr                   in_size,
+                                                          const void*                  in_data_ptr)
+{
+    set_input_payload(in_data_ptr,
+                      static_cast<uint32_t>(in_size),
+                      out_payloads_ptr + 3);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::CompressedTexImage2D>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                                 GLenum                       in_target,
+                                                                 GLint                        in_level,
+                                                                 GLenum                       in_internalformat,
+                                                                 GLsizei                      in_width,
+                                                                 GLsizei                      in_height,
+                                                                 GLint                        in_border,
+                                                                 GLsizei                      in_image_size,
+                                                                 const void*                  in_data_ptr)
+{
+    if (get_integer(GL_PIXEL_UNPACK_BUFFER_BINDING) == 0)
+    {
+        set_input_payload(in_data_ptr,
+                          static_cast<uint32_t>(in_image_size),
+                          out_payloads_ptr + 7);
+    }
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::CompressedTexSubImage2D>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                                    GLenum                       in_target,
+                                                                    GLint                        in_level,
+                                                                    GLint                        in_xoffset,
+                                                                    GLint                        in_yoffset,
+                                                                    GLsizei                      in_width,
+                                                                    GLsizei                      in_height,
+                                                                    GLenum                       in_format,
+                                                                    GLsizei                      in_image_size,
+                                                                    const void*                  in_data_ptr)
+{
+    if (get_integer(GL_PIXEL_UNPACK_BUFFER_BINDING) == 0)
+    {
+        set_input_payload(in_data_ptr,
+                          static_cast<uint32_t>(in_image_size),
+                          out_payloads_ptr + 8);
+    }
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::DrawBuffers>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                        GLsizei                      in_n,
+                                                        const GLenum*                in_buffers_ptr)
+{
+    set_input_payload(in_buffers_ptr,
+                      static_cast<uint32_t>(in_n) * sizeof(GLenum),
+                      out_payloads_ptr + 1);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::GetActiveUniform>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                             GLuint                       in_program,
+                                                             GLuint                       in_index,
+                                                             GLsizei                      in_buffer_size,
+                                                             GLsizei*                     out_length_ptr,
+                                                             GLint*                       out_size_ptr,
+                                                             GLenum*                      out_type_ptr,
+                                                             GLchar*                      out_name_ptr)
+{
+    set_output_payload(out_length_ptr,
+                       sizeof(GLsizei),
+                       out_payloads_ptr + 3);
+    set_output_payload(out_size_ptr,
+                       sizeof(GLint),
+                       out_payloads_ptr + 4);
+    set_output_payload(out_type_ptr,
+                       sizeof(GLenum),
+                       out_payloads_ptr + 5);
+    set_output_payload(out_name_ptr,
+                       static_cast<uint32_t>(in_buffer_size),
+                       out_payloads_ptr + 6);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::GetIntegerv>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                        GLenum                       in_pname,
+                                                        GLint*                       out_data_ptr)
+{
+    /* Most queries return up to 4 values. */
+    uint32_t n_values = 4;
+
+    switch (in_pname)
+    {
+        case GL_COMPRESSED_TEXTURE_FORMATS: n_values = static_cast<uint32_t>(get_integer(GL_NUM_COMPRESSED_TEXTURE_FORMATS) ); break;
+        case GL_PROGRAM_BINARY_FORMATS:     n_values = static_cast<uint32_t>(get_integer(GL_NUM_PROGRAM_BINARY_FORMATS) );     break;
+        case GL_SHADER_BINARY_FORMATS:      n_values = static_cast<uint32_t>(get_integer(GL_NUM_SHADER_BINARY_FORMATS) );      break;
+
+        default:
+        {
+            break;
+        }
+    }
+
+    set_output_payload(out_data_ptr,
+                       n_values * sizeof(GLint),
+                       out_payloads_ptr + 1);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::InvalidateFramebuffer>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                                  GLenum                       in_target,
+                                                                  GLsizei                      in_n_attachments,
+                                                                  const GLenum*                in_attachments_ptr)
+{
+    set_input_payload(in_attachments_ptr,
+                      static_cast<uint32_t>(in_n_attachments) * sizeof(GLenum),
+                      out_payloads_ptr + 2);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::ShaderSource>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                         GLuint                       in_shader,
+                                                         GLsizei                      in_count,
+                                                         const GLchar* const*         in_strings_ptr,
+                                                         const GLint*                 in_opt_lengths_ptr)
+{
+    /* Strings are stored NUL-terminated, so lengths are not needed on replay. */
+    set_string_array_payload(in_strings_ptr,
+                             in_opt_lengths_ptr,
+                             in_count,
+                             out_payloads_ptr + 2);
+
+    out_payloads_ptr[3].type = Framework::GLCapturePayloadType::NULL_POINTER;
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::TexImage2D>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                       GLenum                       in_target,
+                                                       GLint                        in_level,
+                                                       GLint                        in_internalformat,
+                                                       GLsizei                      in_width,
+                                                       GLsizei                      in_height,
+                                                       GLint                        in_border,
+                                                       GLenum                       in_format,
+                                                       GLenum                       in_type,
+                                                       const void*                  in_pixels_ptr)
+{
+    set_input_payload(in_pixels_ptr,
+                      get_unpacked_image_size(in_width,
+                                              in_height,
+                                              1, /* in_depth */
+                                              in_format,
+                                              in_type,
+                                              false), /* in_is_3d */
+                      out_payloads_ptr + 8);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::TexImage3D>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                       GLenum                       in_target,
+                                                       GLint                        in_level,
+                                                       GLint                        in_internalformat,
+                                                       GLsizei                      in_width,
+                                                       GLsizei                      in_height,
+                                                       GLsizei                      in_depth,
+                                                       GLint                        in_border,
+                                                       GLenum                       in_format,
+                                                       GLenum                       in_type,
+                                                       const void*                  in_pixels_ptr)
+{
+    set_input_payload(in_pixels_ptr,
+                      get_unpacked_image_size(in_width,
+                                              in_height,
+                                              in_depth,
+                                              in_format,
+                                              in_type,
+                                              true), /* in_is_3d */
+                      out_payloads_ptr + 9);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::TexSubImage2D>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                          GLenum                       in_target,
+                                                          GLint                        in_level,
+                                                          GLint                        in_xoffset,
+                                                          GLint                        in_yoffset,
+                                                          GLsizei                      in_width,
+                                                          GLsizei                      in_height,
+                                                          GLenum                       in_format,
+                                                          GLenum                       in_type,
+                                                          const void*                  in_pixels_ptr)
+{
+    set_input_payload(in_pixels_ptr,
+                      get_unpacked_image_size(in_width,
+                                              in_height,
+                                              1, /* in_depth */
+                                              in_format,
+                                              in_type,
+                                              false), /* in_is_3d */
+                      out_payloads_ptr + 8);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::TexSubImage3D>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                          GLenum                       in_target,
+                                                          GLint                        in_level,
+                                                          GLint                        in_xoffset,
+                                                          GLint                        in_yoffset,
+                                                          GLint                        in_zoffset,
+                                                          GLsizei                      in_width,
+                                                          GLsizei                      in_height,
+                                                          GLsizei                      in_depth,
+                                                          GLenum                       in_format,
+                                                          GLenum                       in_type,
+                                                          const void*                  in_pixels_ptr)
+{
+    set_input_payload(in_pixels_ptr,
+                      get_unpacked_image_size(in_width,
+                                              in_height,
+                                              in_depth,
+                                              in_format,
+                                              in_type,
+                                              true), /* in_is_3d */
+                      out_payloads_ptr + 10);
+}
+
+template<>
+void get_payloads<Framework::GLFunctionID::TransformFeedbackVaryings>(Framework::GLCapturePayload* out_payloads_ptr,
+                                                                      GLuint                       in_program,
+                                                                      GLsizei                      in_count,
+                                                                      const GLchar* const*         in_varyings_ptr,
+                                                                      GLenum                       in_buffer_mode)
+{
+    set_string_array_payload(in_varyings_ptr,
+                             nullptr, /* in_opt_lengths_ptr */
+                             in_count,
+                             out_payloads_ptr + 2);
+}
+
+namespace Framework
+{
+    template<GLFunctionID ID, typename... Args>
+    struct GLCaptureCall
+    {
+        /* Writes the call's ID, arguments and input payloads. */
+        static void begin(GLCapturePayload* out_payloads_ptr,
+                          Args...           in_args)
+        {
+            const uint32_t id               = static_cast<uint32_t>(ID);
+            const uint64_t arg_slots[]      = {pack_gl_capture_slot(in_args)..., 0};
+            const bool     is_payload_arg[] = {IsGLCapturePayloadArg<Args>::value..., false};
+
+            get_payloads<ID>(out_payloads_ptr,
+                             in_args...);
+
+            g_active_capture_ptr->write(&id,
+                                        sizeof(id) );
+            g_active_capture_ptr->write(arg_slots,
+                                        sizeof(uint64_t) * sizeof...(Args) );
+
+            for (uint32_t n_arg = 0;
+                          n_arg < sizeof...(Args);
+                        ++n_arg)
+            {
+                if (is_payload_arg[n_arg])
+                {
+                    g_active_capture_ptr->write_payload(out_payloads_ptr[n_arg]);
+                }
+            }
+        }
+
+        /* Writes contents of output payloads, as filled by the call. */
+        static void end(const GLCapturePayload* in_payloads_ptr)
+        {
+            const bool is_payload_arg[] = {IsGLCapturePayloadArg<Args>::value..., false};
+
+            g_active_capture_ptr->write_output_payloads(in_payloads_ptr,
+                                                        is_payload_arg,
+                                                        sizeof...(Args) );
+        }
+
+        template<typename R>
+        static void write_result(const R& in_result)
+        {
+            const uint64_t result_slot = pack_gl_capture_slot(in_result);
+
+            g_active_capture_ptr->write(&result_slot,
+                                        sizeof(result_slot) );
+        }
+    };
+
+    /* Replaces a glad function pointer of type PFN for the duration of the capture. */
+    template<GLFunctionID ID, typename PFN>
+    struct GLCaptureHook;
+
+    template<GLFunctionID ID, typename R, typename... Args>
+    struct GLCaptureHook<ID, R (APIENTRYP)(Args...)>
+    {
+        typedef R (APIENTRYP PFNORIGINALPROC)(Args...);
+
+        static R APIENTRY hook(Args... in_args)
+        {
+            const auto       original_func_ptr = reinterpret_cast<PFNORIGINALPROC>(g_original_gl_function_ptrs[static_cast<uint32_t>(ID)]);
+            GLCapturePayload payloads[sizeof...(Args) + 1];
+            R                result;
+
+            GLCaptureCall<ID, Args...>::begin(payloads,
+                                              in_args...);
+
+            result = original_func_ptr(in_args...);
+
+            GLCaptureCall<ID, Args...>::write_result(result);
+            GLCaptureCall<ID, Args...>::end         (payloads);
+
+            return result;
+        }
+    };
+
+    template<GLFunctionID ID, typename... Args>
+    struct GLCaptureHook<ID, void (APIENTRYP)(Args...)>
+    {
+        typedef void (APIENTRYP PFNORIGINALPROC)(Args...);
+
+        static void APIENTRY hook(Args... in_args)
+        {
+            const auto       original_func_ptr = reinterpret_cast<PFNORIGINALPROC>(g_original_gl_function_ptrs[static_cast<uint32_t>(ID)]);
+            GLCapturePayload payloads[sizeof...(Args) + 1];
+
+            GLCaptureCall<ID, Args...>::begin(payloads,
+                                              in_args...);
+
+            original_func_ptr(in_args...);
+
+            GLCaptureCall<ID, Args...>::end(payloads);
+        }
+    };
+}
+
+Framework::GLCapture::GLCapture(const std::string& in_filename,
+                                const uint32_t&    in_n_frames,
+                                const int&         in_framebuffer_width,
+                                const int&         in_framebuffer_height)
+    :m_file_ptr          (nullptr),
+     m_has_write_failed  (false),
+     m_n_bytes_written   (0),
+     m_n_frames_captured (0),
+     m_filename          (in_filename),
+     m_framebuffer_height(in_framebuffer_height),
+     m_framebuffer_width (in_framebuffer_width),
+     m_n_frames          (in_n_frames)
+{
+    /* Stub */
+}
+
+Framework::GLCapture::~GLCapture()
+{
+    if (g_active_capture_ptr == this)
+    {
+        #define FRAMEWORK_GL_CAPTURE_UNHOOK(name, pfn) \
+            glad_gl##name = reinterpret_cast<pfn>(g_original_gl_function_ptrs[static_cast<uint32_t>(GLFunctionID::name)]);
+
+        FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_GL_CAPTURE_UNHOOK)
+
+        #undef FRAMEWORK_GL_CAPTURE_UNHOOK
+
+        g_active_capture_ptr = nullptr;
+    }
+
+    if (m_file_ptr != nullptr)
+    {
+        write(&GL_CAPTURE_RECORD_END_OF_STREAM,
+              sizeof(GL_CAPTURE_RECORD_END_OF_STREAM) );
+
+        ::fclose(m_file_ptr);
+    }
+}
+
+Framework::GLCaptureUniquePtr Framework::GLCapture::create(const std::string& in_filename,
+                                                           const uint32_t&    in_n_frames,
+                                                           const int&         in_framebuffer_width,
+                                                           const int&         in_framebuffer_height)
+{
+    GLCaptureUniquePtr result_ptr(
+        new GLCapture(in_filename,
+                      in_n_frames,
+                      in_framebuffer_width,
+                      in_framebuffer_height)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+bool Framework::GLCapture::init()
+{
+    const int32_t  framebuffer_height = static_cast<int32_t> (m_framebuffer_height);
+    const int32_t  framebuffer_width  = static_cast<int32_t> (m_framebuffer_width);
+    const uint32_t n_functions        = static_cast<uint32_t>(GLFunctionID::COUNT);
+    bool           result             = false;
+
+    if (g_active_capture_ptr != nullptr)
+    {
+        Framework::report_error("Only one GL capture can be active at a time.");
+
+        goto end;
+    }
+
+    m_file_ptr = ::fopen(m_filename.c_str(),
+                         "wb");
+
+    if (m_file_ptr == nullptr)
+    {
+        Framework::report_error("Could not open [%s] for writing.",
+                                m_filename);
+
+        goto end;
+    }
+
+    write(&GL_CAPTURE_MAGIC,
+          sizeof(GL_CAPTURE_MAGIC) );
+    write(&GL_CAPTURE_VERSION,
+          sizeof(GL_CAPTURE_VERSION) );
+    write(&n_functions,
+          sizeof(n_functions) );
+    write(&framebuffer_width,
+          sizeof(framebuffer_width) );
+    write(&framebuffer_height,
+          sizeof(framebuffer_height) );
+
+    /* Swap glad's function pointers for the hooks. */
+    #define FRAMEWORK_GL_CAPTURE_HOOK(name, pfn)                                                                                           \
+        g_original_gl_function_ptrs[static_cast<uint32_t>(GLFunctionID::name)] = reinterpret_cast<PFNGLGENERICPROC>(glad_gl##name);        \
+        glad_gl##name                                                          = &GLCaptureHook<GLFunctionID::name, pfn>::hook;
+
+    FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_GL_CAPTURE_HOOK)
+
+    #undef FRAMEWORK_GL_CAPTURE_HOOK
+
+    g_active_capture_ptr = this;
+
+    result = true;
+end:
+    return result;
+}
+
+bool Framework::GLCapture::on_frame_end()
+{
+    write(&GL_CAPTURE_RECORD_END_OF_FRAME,
+          sizeof(GL_CAPTURE_RECORD_END_OF_FRAME) );
+
+    ++m_n_frames_captured;
+
+    return (m_n_frames_captured < m_n_frames) &&
+           !m_has_write_failed;
+}
+
+void Framework::GLCapture::write(const void*   in_data_ptr,
+                                 const size_t& in_size)
+{
+    if (in_size          == 0 ||
+        m_has_write_failed)
+    {
+        goto end;
+    }
+
+    if (::fwrite(in_data_ptr,
+                 in_size,
+                 1, /* count */
+                 m_file_ptr) != 1)
+    {
+        Framework::report_error("Failed to write to GL capture [%s].",
+                                m_filename);
+
+        m_has_write_failed = true;
+        goto end;
+    }
+
+    m_n_bytes_written += in_size;
+end:
+    ;
+}
+
+void Framework::GLCapture::write_output_payloads(const GLCapturePayload* in_payloads_ptr,
+                                                 const bool*             in_is_payload_arg_ptr,
+                                                 const uint32_t&         in_n_args)
+{
+    for (uint32_t n_arg = 0;
+                  n_arg < in_n_args;
+                ++n_arg)
+    {
+        if (in_is_payload_arg_ptr[n_arg]                                &&
+            in_payloads_ptr      [n_arg].type == GLCapturePayloadType::OUTPUT)
+        {
+            write(in_payloads_ptr[n_arg].data_ptr,
+                  in_payloads_ptr[n_arg].size);
+        }
+    }
+}
+
+void Framework::GLCapture::write_payload(const GLCapturePayload& in_payload)
+{
+    static const uint8_t padding[8] = {};
+
+    const uint8_t type = static_cast<uint8_t>(in_payload.type);
+    uint32_t      size = in_payload.size;
+
+    if (in_payload.type == GLCapturePayloadType::STRING_ARRAY)
+    {
+        const auto strings_ptr = static_cast<const GLchar* const*>(in_payload.data_ptr);
+
+        size = 0;
+
+        for (uint32_t n_string = 0;
+                      n_string < in_payload.n_strings;
+                    ++n_string)
+        {
+            size += (in_payload.lengths_ptr           != nullptr &&
+                     in_payload.lengths_ptr[n_string] >= 0)      ? static_cast<uint32_t>(in_payload.lengths_ptr[n_string]) + 1
+                                                                 : static_cast<uint32_t>(strlen(strings_ptr[n_string]) )   + 1;
+        }
+    }
+
+    write(&type,
+          sizeof(type) );
+    write(&size,
+          sizeof(size) );
+
+    if (in_payload.type == GLCapturePayloadType::STRING_ARRAY)
+    {
+        write(&in_payload.n_strings,
+              sizeof(in_payload.n_strings) );
+    }
+
+    if (in_payload.type == GLCapturePayloadType::INPUT ||
+        in_payload.type == GLCapturePayloadType::STRING_ARRAY)
+    {
+        write(padding,
+              static_cast<size_t>( (8 - m_n_bytes_written % 8) % 8) );
+
+        if (in_payload.type == GLCapturePayloadType::INPUT)
+        {
+            write(in_payload.data_ptr,
+                  size);
+        }
+        else
+        {
+            const auto strings_ptr = static_cast<const GLchar* const*>(in_payload.data_ptr);
+
+            for (uint32_t n_string = 0;
+                          n_string < in_payload.n_strings;
+                        ++n_string)
+            {
+                const size_t string_length = (in_payload.lengths_ptr           != nullptr &&
+                                              in_payload.lengths_ptr[n_string] >= 0)      ? static_cast<size_t>(in_payload.lengths_ptr[n_string])
+                                                                                          : strlen(strings_ptr[n_string]);
+
+                write(strings_ptr[n_string],
+                      string_length);
+                write(padding,
+                      1); /* NUL terminator */
+            }
+        }
+    }
+}
+
+#endif /* !__EMSCRIPTEN__ */
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gl_check.h"
+
+#if defined(FRAMEWORK_GL_ERROR_CHECKS)
+
+/* Private variables */
+static uint32_t g_frame_interval   = 1;
+static bool     g_is_frame_sampled = true;
+static uint32_t g_n_errors         = 0;
+static uint32_t g_n_frame          = 0;
+
+/* Upper bound on the number of errors fetched per check. Guards against implementations which keep on returning
+ * an error, eg. after the context has been lost. */
+static const uint32_t MAX_ERRORS_PER_CHECK = 8;
+
+static const char* get_gl_error_name(const GLenum& in_error)
+{
+    switch (in_error)
+    {
+        case GL_INVALID_ENUM:                  return "GL_INVALID_ENUM";
+        case GL_INVALID_FRAMEBUFFER_OPERATION: return "GL_INVALID_FRAMEBUFFER_OPERATION";
+        case GL_INVALID_OPERATION:             return "GL_INVALID_OPERATION";
+        case GL_INVALID_VALUE:                 return "GL_INVALID_VALUE";
+        case GL_OUT_OF_MEMORY:                 return "GL_OUT_OF_MEMORY";
+    }
+
+    return "?";
+}
+
+static void report_gl_errors(const char* in_call_ptr,
+                             const char* in_file_ptr,
+                             const int&  in_line,
+                             const bool& in_is_before_call)
+{
+    for (uint32_t n_error = 0;
+                  n_error < MAX_ERRORS_PER_CHECK;
+                ++n_error)
+    {
+        const GLenum error = glGetError();
+
+        if (error == GL_NO_ERROR)
+        {
+            break;
+        }
+
+        ++g_n_errors;
+
+        if (in_is_before_call)
+        {
+            Framework::log_message(Framework::LogSeverity::ERROR,
+                                   "GL",
+                                   "%s (0x%x) raised by an unchecked call preceding %s at %s:%d",
+                                   get_gl_error_name(error),
+                                   error,
+                                   in_call_ptr,
+                                   in_file_ptr,
+                                   in_line);
+        }
+        else
+        {
+            Framework::log_message(Framework::LogSeverity::ERROR,
+                                   "GL",
+                                   "%s (0x%x) raised by %s at %s:%d",
+                                   get_gl_error_name(error),
+                                   error,
+                                   in_call_ptr,
+                                   in_file_ptr,
+                                   in_line);
+        }
+    }
+}
+
+Framework::GLErrorCheck::GLErrorCheck(const char* in_call_ptr,
+                                      const char* in_file_ptr,
+                                      const int&  in_line)
+    :m_call_ptr((g_is_frame_sampled) ? in_call_ptr : nullptr),
+     m_file_ptr(in_file_ptr),
+     m_line    (in_line)
+{
+    if (m_call_ptr != nullptr)
+    {
+        report_gl_errors(m_call_ptr,
+                         m_file_ptr,
+                         m_line,
+                         true); /* in_is_before_call */
+    }
+}
+
+Framework::GLErrorCheck::~GLErrorCheck()
+{
+    if (m_call_ptr != nullptr)
+    {
+        report_gl_errors(m_call_ptr,
+                         m_file_ptr,
+                         m_line,
+                         false); /* in_is_before_call */
+    }
+}
+
+void Framework::begin_gl_error_check_frame()
+{
+    g_is_frame_sampled = (g_frame_interval != 0) && ((g_n_frame % g_frame_interval) == 0);
+
+    ++g_n_frame;
+}
+
+uint32_t Framework::get_n_gl_errors()
+{
+    return g_n_errors;
+}
+
+bool Framework::is_gl_error_checking_active()
+{
+    return g_is_frame_sampled;
+}
+
+void Framework::set_gl_error_check_frame_interval(const uint32_t& in_n_frames)
+{
+    g_frame_interval   = in_n_frames;
+    g_is_frame_sampled = (in_n_frames != 0);
+}
+
+#endif /* FRAMEWORK_GL_ERROR_CHECKS */
\ No newline at end of file
@@ -0,0 +1,177 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gl_debug_output.h"
+
+#if !defined(__EMSCRIPTEN__)
+
+#include "trace.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdio.h>
+#include <tuple>
+
+/* Type defs */
+typedef std::tuple<GLenum, GLuint, const char*> GLDebugMessageKey; /* Source, ID & zone name. */
+
+static std::map<GLDebugMessageKey, Framework::GLDebugMessage> g_message_map;
+static std::mutex                                             g_message_map_mutex;
+
+static const char* get_gl_debug_source_name(const GLenum& in_source)
+{
+    switch (in_source)
+    {
+        case GL_DEBUG_SOURCE_API_KHR:             return "API";
+        case GL_DEBUG_SOURCE_APPLICATION_KHR:     return "Application";
+        case GL_DEBUG_SOURCE_OTHER_KHR:           return "Other";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER_KHR: return "Shader compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY_KHR:     return "Third party";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM_KHR:   return "Window system";
+    }
+
+    return "?";
+}
+
+static void APIENTRY on_gl_debug_message(GLenum        source,
+                                         GLenum        type,
+                                         GLuint        id,
+                                         GLenum        severity,
+                                         GLsizei       length,
+                                         const GLchar* message,
+                                         const void*   user_param)
+{
+    const char*                 zone_name_ptr = Framework::get_current_trace_zone_name();
+    const GLDebugMessageKey     message_key  (source,
+                                              id,
+                                              zone_name_ptr);
+    std::lock_guard<std::mutex> lock(g_message_map_mutex);
+    auto                        message_iterator = g_message_map.find(message_key);
+
+    if (message_iterator == g_message_map.end() )
+    {
+        Framework::GLDebugMessage new_message;
+
+        new_message.id            = id;
+        new_message.message       = (length >= 0) ? std::string(message, static_cast<size_t>(length) )
+                                                  : std::string(message);
+        new_message.n_occurrences = 0;
+        new_message.severity      = severity;
+        new_message.source        = source;
+        new_message.zone_name_ptr = zone_name_ptr;
+
+        message_iterator = g_message_map.emplace(message_key,
+                                                 new_message).first;
+    }
+
+    message_iterator->second.n_occurrences++;
+}
+
+bool Framework::enable_gl_debug_output()
+{
+    bool result = false;
+
+    if (!GLAD_GL_KHR_debug)
+    {
+        printf("KHR_debug is not supported, driver debug output will not be captured.\n");
+
+        goto end;
+    }
+
+    /* Only performance warnings are of interest. Errors are already surfaced by the driver returning them via
+     * glGetError(), and notifications tend to be very chatty. */
+    glDebugMessageControlKHR(GL_DONT_CARE, /* source   */
+                             GL_DONT_CARE, /* type     */
+                             GL_DONT_CARE, /* severity */
+                             0,            /* count    */
+                             nullptr,      /* ids      */
+                             GL_FALSE);    /* enabled  */
+    glDebugMessageControlKHR(GL_DONT_CARE,                  /* source   */
+                             GL_DEBUG_TYPE_PERFORMANCE_KHR, /* type     */
+                             GL_DONT_CARE,                  /* severity */
+                             0,                             /* count    */
+                             nullptr,                       /* ids      */
+                             GL_TRUE);                      /* enabled  */
+
+    glDebugMessageCallbackKHR(on_gl_debug_message,
+                              nullptr); /* userParam */
+
+    glEnable(GL_DEBUG_OUTPUT_KHR);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR);
+
+    result = true;
+end:
+    return result;
+}
+
+std::vector<Framework::GLDebugMessage> Framework::get_gl_debug_messages()
+{
+    std::vector<GLDebugMessage> result_vec;
+
+    {
+        std::lock_guard<std::mutex> lock(g_message_map_mutex);
+
+        result_vec.reserve(g_message_map.size() );
+
+        for (const auto& current_message : g_message_map)
+        {
+            result_vec.push_back(current_message.second);
+        }
+    }
+
+    std::stable_sort(result_vec.begin(),
+                     result_vec.end  (),
+                     [](const GLDebugMessage& in_message1,
+                        const GLDebugMessage& in_message2)
+                     {
+                         return in_message1.n_occurrences > in_message2.n_occurrences;
+                     });
+
+    return result_vec;
+}
+
+void Framework::print_gl_debug_output_report()
+{
+    const auto message_vec = get_gl_debug_messages();
+
+    if (!message_vec.empty() )
+    {
+        printf("Driver performance warnings:\n");
+
+        for (const auto& current_message : message_vec)
+        {
+            printf("%8ux [%s #%u] in zone [%s]: %s\n",
+                   current_message.n_occurrences,
+                   get_gl_debug_source_name(current_message.source),
+                   current_message.id,
+                   (current_message.zone_name_ptr != nullptr) ? current_message.zone_name_ptr : "-",
+                   current_message.message.c_str() );
+        }
+
+        fflush(stdout);
+    }
+}
+
+#endif /* !__EMSCRIPTEN__ */
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gl_instrumentation.h"
+
+#if defined(FRAMEWORK_GL_INSTRUMENTATION)
+
+#include <algorithm>
+#include <stdio.h>
+
+/* Type defs */
+typedef void (APIENTRYP PFNGLGENERICPROC)(void);
+
+static Framework::GLCallStatsArray      g_frame_gl_call_stats       = {};
+static void*                            g_gl_call_callback_user_arg = nullptr;
+static Framework::GLCallStatsArray      g_last_frame_gl_call_stats  = {};
+static uint32_t                         g_n_frames                  = 0;
+static PFNGLGENERICPROC                 g_original_gl_function_ptrs[static_cast<uint32_t>(Framework::GLFunctionID::COUNT)];
+static Framework::PFNGLCALLCALLBACKPROC g_post_gl_call_func_ptr     = nullptr;
+static Framework::PFNGLCALLCALLBACKPROC g_pre_gl_call_func_ptr      = nullptr;
+static Framework::GLCallStatsArray      g_total_gl_call_stats       = {};
+
+namespace
+{
+    /* Brackets a single GL call. */
+    class GLCallScope
+    {
+    public:
+        GLCallScope(const Framework::GLFunctionID& in_id)
+            :m_id(in_id)
+        {
+            if (g_pre_gl_call_func_ptr != nullptr)
+            {
+                g_pre_gl_call_func_ptr(m_id,
+                                       g_gl_call_callback_user_arg);
+            }
+
+            m_start_time = std::chrono::steady_clock::now();
+        }
+
+        ~GLCallScope()
+        {
+            auto& call_stats = g_frame_gl_call_stats[static_cast<uint32_t>(m_id)];
+
+            call_stats.cpu_time_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start_time).count();
+            call_stats.n_calls     += 1;
+
+            if (g_post_gl_call_func_ptr != nullptr)
+            {
+                g_post_gl_call_func_ptr(m_id,
+                                        g_gl_call_callback_user_arg);
+            }
+        }
+
+    private:
+        const Framework::GLFunctionID         m_id;
+        std::chrono::steady_clock::time_point m_start_time;
+    };
+
+    template<Framework::GLFunctionID ID, typename PFN>
+    struct GLInstrumentationHook;
+
+    template<Framework::GLFunctionID ID, typename R, typename... Args>
+    struct GLInstrumentationHook<ID, R (APIENTRYP)(Args...)>
+    {
+        typedef R (APIENTRYP PFNORIGINALPROC)(Args...);
+
+        static R APIENTRY hook(Args... in_args)
+        {
+            GLCallScope scope(ID);
+
+            return reinterpret_cast<PFNORIGINALPROC>(g_original_gl_function_ptrs[static_cast<uint32_t>(ID)])(in_args...);
+        }
+    };
+}
+
+void Framework::end_gl_instrumentation_frame()
+{
+    for (uint32_t n_function = 0;
+                  n_function < static_cast<uint32_t>(GLFunctionID::COUNT);
+                ++n_function)
+    {
+        g_total_gl_call_stats[n_function].cpu_time_ms += g_frame_gl_call_stats[n_function].cpu_time_ms;
+        g_total_gl_call_stats[n_function].n_calls     += g_frame_gl_call_stats[n_function].n_calls;
+    }
+
+    g_last_frame_gl_call_stats = g_frame_gl_call_stats;
+    g_frame_gl_call_stats      = GLCallStatsArray();
+
+    ++g_n_frames;
+}
+
+const Framework::GLCallStatsArray& Framework::get_gl_call_stats(const bool& in_last_frame_only)
+{
+    return (in_last_frame_only) ? g_last_frame_gl_call_stats
+                                : g_total_gl_call_stats;
+}
+
+void Framework::install_gl_instrumentation()
+{
+    /* Calls made before glad has been loaded would crash either way, so there is no point in checking for nullptrs. */
+    #define FRAMEWORK_GL_INSTRUMENTATION_HOOK(name, pfn)                                                                            \
+        g_original_gl_function_ptrs[static_cast<uint32_t>(GLFunctionID::name)] = reinterpret_cast<PFNGLGENERICPROC>(glad_gl##name); \
+        glad_gl##name                                                          = &GLInstrumentationHook<GLFunctionID::name, pfn>::hook;
+
+    FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_GL_INSTRUMENTATION_HOOK)
+
+    #undef FRAMEWORK_GL_INSTRUMENTATION_HOOK
+}
+
+void Framework::print_gl_instrumentation_report()
+{
+    std::vector<uint32_t> function_index_vec;
+    uint64_t              n_total_calls      = 0;
+    double                total_call_time_ms = 0.0;
+
+    for (uint32_t n_function = 0;
+                  n_function < static_cast<uint32_t>(GLFunctionID::COUNT);
+                ++n_function)
+    {
+        if (g_total_gl_call_stats[n_function].n_calls > 0)
+        {
+            function_index_vec.push_back(n_function);
+
+            n_total_calls      += g_total_gl_call_stats[n_function].n_calls;
+            total_call_time_ms += g_total_gl_call_stats[n_function].cpu_time_ms;
+        }
+    }
+
+    std::sort(function_index_vec.begin(),
+              function_index_vec.end  (),
+              [](const uint32_t& in_function1,
+                 const uint32_t& in_function2)
+              {
+                  return g_total_gl_call_stats[in_function1].cpu_time_ms > g_total_gl_call_stats[in_function2].cpu_time_ms;
+              });
+
+    printf("GL calls over %u frame(s), excluding ImGui's renderer backend: %llu call(s), %.3f ms.\n",
+           g_n_frames,
+           static_cast<unsigned long long>(n_total_calls),
+           total_call_time_ms);
+
+    printf("%-32s %10s %14s %12s %10s\n",
+           "Function",
+           "Calls",
+           "Calls / frame",
+           "Total [ms]",
+           "Avg [us]");
+
+    for (const auto& current_function : function_index_vec)
+    {
+        const auto& current_stats = g_total_gl_call_stats[current_function];
+
+        printf("%-32s %10u %14.1f %12.3f %10.3f\n",
+               get_gl_function_name(static_cast<GLFunctionID>(current_function) ),
+               current_stats.n_calls,
+               (g_n_frames > 0) ? static_cast<double>(current_stats.n_calls) / static_cast<double>(g_n_frames) : 0.0,
+               current_stats.cpu_time_ms,
+               1000.0 * current_stats.cpu_time_ms / static_cast<double>(current_stats.n_calls) );
+    }
+
+    fflush(stdout);
+}
+
+void Framework::set_gl_call_callbacks(PFNGLCALLCALLBACKPROC in_pre_call_func_ptr,
+                                      PFNGLCALLCALLBACKPROC in_post_call_func_ptr,
+                                      void*                 in_user_arg)
+{
+    g_gl_call_callback_user_arg = in_user_arg;
+    g_post_gl_call_func_ptr     = in_post_call_func_ptr;
+    g_pre_gl_call_func_ptr      = in_pre_call_func_ptr;
+}
+
+#endif /* FRAMEWORK_GL_INSTRUMENTATION */
\ No newline at end of file
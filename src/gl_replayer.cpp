@@ -0,0 +1,924 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gl_replayer.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+
+/* Max number of arguments taken by a function listed in FRAMEWORK_GL_FUNCTIONS. */
+static const uint32_t N_MAX_GL_FUNCTION_ARGS = 11;
+
+namespace Framework
+{
+    template<typename R>
+    struct GLReplayInvoker
+    {
+        template<typename PFN, typename... Args>
+        static uint64_t invoke(PFN     in_func_ptr,
+                               Args... in_args)
+        {
+            return pack_gl_capture_slot(in_func_ptr(in_args...) );
+        }
+    };
+
+    template<>
+    struct GLReplayInvoker<void>
+    {
+        template<typename PFN, typename... Args>
+        static uint64_t invoke(PFN     in_func_ptr,
+                               Args... in_args)
+        {
+            in_func_ptr(in_args...);
+
+            return 0;
+        }
+    };
+
+    template<GLFunctionID ID, typename R, typename... Args>
+    struct GLReplayCall<ID, R (APIENTRYP)(Args...)>
+    {
+        typedef R (APIENTRYP PFNPROC)(Args...);
+
+        static bool replay(GLReplayer* in_replayer_ptr)
+        {
+            static_assert(sizeof...(Args) <= N_MAX_GL_FUNCTION_ARGS, "N_MAX_GL_FUNCTION_ARGS is too small.");
+
+            const auto          func_ptr                       = reinterpret_cast<PFNPROC>(in_replayer_ptr->m_gl_function_ptrs[static_cast<uint32_t>(ID)]);
+            const bool          is_payload_arg[]               = {IsGLCapturePayloadArg<Args>::value..., false};
+            uint64_t            arg_slots[sizeof...(Args) + 1] = {};
+            uint64_t            captured_result_slot           = 0;
+            GLReplayer::Payload payloads [sizeof...(Args) + 1] = {};
+            bool                result                         = false;
+            uint64_t            result_slot                    = 0;
+
+            if (!in_replayer_ptr->read(arg_slots,
+                                       sizeof(uint64_t) * sizeof...(Args) ))
+            {
+                goto end;
+            }
+
+            for (uint32_t n_arg = 0;
+                          n_arg < sizeof...(Args);
+                        ++n_arg)
+            {
+                if (is_payload_arg[n_arg]                                  &&
+                    !in_replayer_ptr->read_payload(n_arg,
+                                                   payloads + n_arg) )
+                {
+                    goto end;
+                }
+            }
+
+            in_replayer_ptr->on_before_call(ID,
+                                            arg_slots,
+                                            payloads);
+
+            {
+                const auto start_time = std::chrono::steady_clock::now();
+
+                result_slot = invoke(func_ptr,
+                                     arg_slots,
+                                     payloads,
+                                     std::index_sequence_for<Args...>() );
+
+                in_replayer_ptr->on_call_timed(ID,
+                                               std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count() );
+            }
+
+            if (!std::is_void<R>::value                                       &&
+                !in_replayer_ptr->read(&captured_result_slot,
+                                       sizeof(captured_result_slot) ))
+            {
+                goto end;
+            }
+
+            in_replayer_ptr->on_after_call(ID,
+                                           arg_slots,
+                                           captured_result_slot,
+                                           result_slot);
+
+            result = in_replayer_ptr->read_output_payloads(ID,
+                                                           payloads,
+                                                           is_payload_arg,
+                                                           sizeof...(Args) );
+        end:
+            return result;
+        }
+
+    private:
+        template<typename T>
+        static T get_arg(const uint64_t&            in_slot,
+                         const GLReplayer::Payload& in_payload,
+                         std::false_type            in_is_payload_arg)
+        {
+            return unpack_gl_capture_slot<T>(in_slot);
+        }
+
+        template<typename T>
+        static T get_arg(const uint64_t&            in_slot,
+                         const GLReplayer::Payload& in_payload,
+                         std::true_type             in_is_payload_arg)
+        {
+            switch (in_payload.type)
+            {
+                case GLCapturePayloadType::NONE:         return unpack_gl_capture_slot<T>(in_slot);
+                case GLCapturePayloadType::NULL_POINTER: return nullptr;
+
+                default:
+                {
+                    return reinterpret_cast<T>(in_payload.data_ptr);
+                }
+            }
+        }
+
+        template<size_t... N_ARGS>
+        static uint64_t invoke(PFNPROC                    in_func_ptr,
+                               const uint64_t*            in_arg_slots_ptr,
+                               const GLReplayer::Payload* in_payloads_ptr,
+                               std::index_sequence<N_ARGS...>)
+        {
+            return GLReplayInvoker<R>::invoke(in_func_ptr,
+                                              get_arg<Args>(in_arg_slots_ptr[N_ARGS],
+                                                            in_payloads_ptr [N_ARGS],
+                                                            std::integral_constant<bool, IsGLCapturePayloadArg<Args>::value>() )...);
+        }
+    };
+}
+
+Framework::GLReplayer::GLReplayer(const std::string& in_filename)
+    :m_framebuffer_height      (0),
+     m_framebuffer_width       (0),
+     m_read_offset             (0),
+     m_current_program         (0),
+     m_frame_stats_ptr         (nullptr),
+     m_n_unknown_object_names  (0),
+     m_filename                (in_filename)
+{
+    /* Stub */
+}
+
+Framework::GLReplayerUniquePtr Framework::GLReplayer::create(const std::string& in_filename)
+{
+    GLReplayerUniquePtr result_ptr(
+        new GLReplayer(in_filename)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+bool Framework::GLReplayer::get_object_name_array_namespace(const GLFunctionID& in_id,
+                                                            ObjectNamespace*    out_namespace_ptr)
+{
+    switch (in_id)
+    {
+        case GLFunctionID::DeleteBuffers:
+        case GLFunctionID::GenBuffers:            *out_namespace_ptr = ObjectNamespace::BUFFER;             return true;
+        case GLFunctionID::DeleteFramebuffers:
+        case GLFunctionID::GenFramebuffers:       *out_namespace_ptr = ObjectNamespace::FRAMEBUFFER;        return true;
+        case GLFunctionID::DeleteQueries:
+        case GLFunctionID::GenQueries:            *out_namespace_ptr = ObjectNamespace::QUERY;              return true;
+        case GLFunctionID::DeleteRenderbuffers:
+        case GLFunctionID::GenRenderbuffers:      *out_namespace_ptr = ObjectNamespace::RENDERBUFFER;       return true;
+        case GLFunctionID::DeleteSamplers:
+        case GLFunctionID::GenSamplers:           *out_namespace_ptr = ObjectNamespace::SAMPLER;            return true;
+        case GLFunctionID::DeleteTextures:
+        case GLFunctionID::GenTextures:           *out_namespace_ptr = ObjectNamespace::TEXTURE;            return true;
+        case GLFunctionID::DeleteTransformFeedbacks:
+        case GLFunctionID::GenTransformFeedbacks: *out_namespace_ptr = ObjectNamespace::TRANSFORM_FEEDBACK; return true;
+        case GLFunctionID::DeleteVertexArrays:
+        case GLFunctionID::GenVertexArrays:       *out_namespace_ptr = ObjectNamespace::VERTEX_ARRAY;       return true;
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool Framework::GLReplayer::init()
+{
+    FILE*    file_handle        = ::fopen(m_filename.c_str(),
+                                          "rb");
+    long     file_size          = 0;
+    int32_t  framebuffer_height = 0;
+    int32_t  framebuffer_width  = 0;
+    uint32_t magic              = 0;
+    uint32_t n_functions        = 0;
+    bool     result             = false;
+    uint32_t version            = 0;
+
+    if (file_handle == nullptr)
+    {
+        Framework::report_error("Could not open GL capture [%s].",
+                                m_filename);
+
+        goto end;
+    }
+
+    ::fseek(file_handle,
+            0L,
+            SEEK_END);
+
+    file_size = ::ftell(file_handle);
+
+    ::fseek(file_handle,
+            0L,
+            SEEK_SET);
+
+    if (file_size <= 0)
+    {
+        Framework::report_error("GL capture [%s] is empty.",
+                                m_filename);
+
+        goto end;
+    }
+
+    m_data_u8_vec.resize(static_cast<size_t>(file_size) );
+
+    if (::fread(m_data_u8_vec.data(),
+                m_data_u8_vec.size(),
+                1, /* count */
+                file_handle) != 1)
+    {
+        Framework::report_error("Failed to read GL capture [%s].",
+                                m_filename);
+
+        goto end;
+    }
+
+    if (!read(&magic,              sizeof(magic) )                          ||
+        !read(&version,            sizeof(version) )                        ||
+        !read(&n_functions,        sizeof(n_functions) )                    ||
+        !read(&framebuffer_width,  sizeof(framebuffer_width) )              ||
+        !read(&framebuffer_height, sizeof(framebuffer_height) )             ||
+        magic       != GL_CAPTURE_MAGIC                                     ||
+        version     != GL_CAPTURE_VERSION                                   ||
+        n_functions != static_cast<uint32_t>(GLFunctionID::COUNT) )
+    {
+        Framework::report_error("[%s] is not a supported GL capture.",
+                                m_filename);
+
+        goto end;
+    }
+
+    m_framebuffer_height = static_cast<int>(framebuffer_height);
+    m_framebuffer_width  = static_cast<int>(framebuffer_width);
+
+    #define FRAMEWORK_GL_REPLAY_FUNCTION(name, pfn)                                                                              \
+        m_gl_function_ptrs     [static_cast<uint32_t>(GLFunctionID::name)] = reinterpret_cast<PFNGLGENERICPROC>(glad_gl##name); \
+        m_replay_call_func_ptrs[static_cast<uint32_t>(GLFunctionID::name)] = &GLReplayCall<GLFunctionID::name, pfn>::replay;
+
+    FRAMEWORK_GL_FUNCTIONS(FRAMEWORK_GL_REPLAY_FUNCTION)
+
+    #undef FRAMEWORK_GL_REPLAY_FUNCTION
+
+    m_output_payload_u8_vecs.resize(N_MAX_GL_FUNCTION_ARGS);
+    m_string_array_ptr_vecs.resize (N_MAX_GL_FUNCTION_ARGS);
+
+    result = true;
+end:
+    if (file_handle != nullptr)
+    {
+        ::fclose(file_handle);
+    }
+
+    return result;
+}
+
+void Framework::GLReplayer::on_after_call(const GLFunctionID& in_id,
+                                          const uint64_t*     in_arg_slots_ptr,
+                                          const uint64_t&     in_captured_result_slot,
+                                          const uint64_t&     in_result_slot)
+{
+    switch (in_id)
+    {
+        case GLFunctionID::CreateProgram:
+        case GLFunctionID::CreateShader:
+        {
+            const GLuint captured_name = unpack_gl_capture_slot<GLuint>(in_captured_result_slot);
+
+            if (captured_name != 0)
+            {
+                m_object_name_maps[static_cast<uint32_t>(ObjectNamespace::PROGRAM)][captured_name] = unpack_gl_capture_slot<GLuint>(in_result_slot);
+            }
+
+            break;
+        }
+
+        case GLFunctionID::FenceSync:
+        {
+            m_sync_map[in_captured_result_slot] = unpack_gl_capture_slot<GLsync>(in_result_slot);
+
+            break;
+        }
+
+        case GLFunctionID::GetUniformLocation:
+        {
+            const GLint captured_location = unpack_gl_capture_slot<GLint>(in_captured_result_slot);
+
+            if (captured_location != -1)
+            {
+                const uint64_t key = (in_arg_slots_ptr[0] << 32) | static_cast<uint32_t>(captured_location);
+
+                m_uniform_location_map[key] = unpack_gl_capture_slot<GLint>(in_result_slot);
+            }
+
+            break;
+        }
+
+        case GLFunctionID::UseProgram:
+        {
+            m_current_program = unpack_gl_capture_slot<GLuint>(in_arg_slots_ptr[0]);
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+void Framework::GLReplayer::on_before_call(const GLFunctionID& in_id,
+                                           uint64_t*           inout_arg_slots_ptr,
+                                           Payload*            inout_payloads_ptr)
+{
+    switch (in_id)
+    {
+        case GLFunctionID::BindVertexArray:
+        {
+            translate_object_name_arg(ObjectNamespace::VERTEX_ARRAY,
+                                      inout_arg_slots_ptr + 0);
+
+            break;
+        }
+
+        case GLFunctionID::BindBuffer:
+        {
+            translate_object_name_arg(ObjectNamespace::BUFFER,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::BindBufferBase:
+        case GLFunctionID::BindBufferRange:
+        {
+            translate_object_name_arg(ObjectNamespace::BUFFER,
+                                      inout_arg_slots_ptr + 2);
+
+            break;
+        }
+
+        case GLFunctionID::BindFramebuffer:
+        {
+            translate_object_name_arg(ObjectNamespace::FRAMEBUFFER,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::BeginQuery:
+        {
+            translate_object_name_arg(ObjectNamespace::QUERY,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::GetQueryObjectuiv:
+        {
+            translate_object_name_arg(ObjectNamespace::QUERY,
+                                      inout_arg_slots_ptr + 0);
+
+            break;
+        }
+
+        case GLFunctionID::BindRenderbuffer:
+        {
+            translate_object_name_arg(ObjectNamespace::RENDERBUFFER,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::FramebufferRenderbuffer:
+        {
+            translate_object_name_arg(ObjectNamespace::RENDERBUFFER,
+                                      inout_arg_slots_ptr + 3);
+
+            break;
+        }
+
+        case GLFunctionID::BindSampler:
+        {
+            translate_object_name_arg(ObjectNamespace::SAMPLER,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::SamplerParameterf:
+        case GLFunctionID::SamplerParameteri:
+        {
+            translate_object_name_arg(ObjectNamespace::SAMPLER,
+                                      inout_arg_slots_ptr + 0);
+
+            break;
+        }
+
+        case GLFunctionID::BindTexture:
+        {
+            translate_object_name_arg(ObjectNamespace::TEXTURE,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::FramebufferTexture2D:
+        {
+            translate_object_name_arg(ObjectNamespace::TEXTURE,
+                                      inout_arg_slots_ptr + 3);
+
+            break;
+        }
+
+        case GLFunctionID::FramebufferTextureLayer:
+        {
+            translate_object_name_arg(ObjectNamespace::TEXTURE,
+                                      inout_arg_slots_ptr + 2);
+
+            break;
+        }
+
+        case GLFunctionID::BindTransformFeedback:
+        {
+            translate_object_name_arg(ObjectNamespace::TRANSFORM_FEEDBACK,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::AttachShader:
+        case GLFunctionID::DetachShader:
+        {
+            translate_object_name_arg(ObjectNamespace::PROGRAM,
+                                      inout_arg_slots_ptr + 0);
+            translate_object_name_arg(ObjectNamespace::PROGRAM,
+                                      inout_arg_slots_ptr + 1);
+
+            break;
+        }
+
+        case GLFunctionID::BindAttribLocation:
+        case GLFunctionID::CompileShader:
+        case GLFunctionID::GetActiveUniform:
+        case GLFunctionID::GetAttribLocation:
+        case GLFunctionID::GetProgramInfoLog:
+        case GLFunctionID::GetProgramiv:
+        case GLFunctionID::GetShaderInfoLog:
+        case GLFunctionID::GetShaderiv:
+        case GLFunctionID::GetUniformBlockIndex:
+        case GLFunctionID::GetUniformLocation:
+        case GLFunctionID::LinkProgram:
+        case GLFunctionID::ShaderSource:
+        case GLFunctionID::TransformFeedbackVaryings:
+        case GLFunctionID::UniformBlockBinding:
+        case GLFunctionID::UseProgram:
+        {
+            translate_object_name_arg(ObjectNamespace::PROGRAM,
+                                      inout_arg_slots_ptr + 0);
+
+            break;
+        }
+
+        case GLFunctionID::DeleteProgram:
+        case GLFunctionID::DeleteShader:
+        {
+            const GLuint captured_name = unpack_gl_capture_slot<GLuint>(inout_arg_slots_ptr[0]);
+
+            translate_object_name_arg(ObjectNamespace::PROGRAM,
+                                      inout_arg_slots_ptr + 0);
+
+            m_object_name_maps[static_cast<uint32_t>(ObjectNamespace::PROGRAM)].erase(captured_name);
+
+            break;
+        }
+
+        case GLFunctionID::DeleteBuffers:
+        case GLFunctionID::DeleteFramebuffers:
+        case GLFunctionID::DeleteQueries:
+        case GLFunctionID::DeleteRenderbuffers:
+        case GLFunctionID::DeleteSamplers:
+        case GLFunctionID::DeleteTextures:
+        case GLFunctionID::DeleteTransformFeedbacks:
+        case GLFunctionID::DeleteVertexArrays:
+        {
+            auto&           names_payload = inout_payloads_ptr[1];
+            ObjectNamespace name_namespace;
+
+            if (names_payload.type != GLCapturePayloadType::INPUT     ||
+                !get_object_name_array_namespace(in_id,
+                                                 &name_namespace) )
+            {
+                break;
+            }
+
+            /* The payload points into the capture, so names are translated into a separate array. */
+            m_translated_name_vec.resize(names_payload.size / sizeof(GLuint) );
+
+            memcpy(m_translated_name_vec.data(),
+                   names_payload.data_ptr,
+                   m_translated_name_vec.size() * sizeof(GLuint) );
+
+            for (auto& current_name : m_translated_name_vec)
+            {
+                const GLuint captured_name = current_name;
+
+                current_name = translate_object_name(name_namespace,
+                                                     captured_name);
+
+                m_object_name_maps[static_cast<uint32_t>(name_namespace)].erase(captured_name);
+            }
+
+            names_payload.data_ptr = m_translated_name_vec.data();
+
+            break;
+        }
+
+        case GLFunctionID::ClientWaitSync:
+        case GLFunctionID::DeleteSync:
+        case GLFunctionID::WaitSync:
+        {
+            auto sync_iterator = m_sync_map.find(inout_arg_slots_ptr[0]);
+
+            /* Syncs which were not created during capture are replaced with 0, which GL rejects safely. */
+            inout_arg_slots_ptr[0] = (sync_iterator != m_sync_map.end() ) ? pack_gl_capture_slot(sync_iterator->second)
+                                                                          : 0;
+
+            if (in_id         == GLFunctionID::DeleteSync &&
+                sync_iterator != m_sync_map.end() )
+            {
+                m_sync_map.erase(sync_iterator);
+            }
+
+            break;
+        }
+
+        case GLFunctionID::Uniform1f:
+        case GLFunctionID::Uniform1fv:
+        case GLFunctionID::Uniform1i:
+        case GLFunctionID::Uniform1iv:
+        case GLFunctionID::Uniform1ui:
+        case GLFunctionID::Uniform1uiv:
+        case GLFunctionID::Uniform2f:
+        case GLFunctionID::Uniform2fv:
+        case GLFunctionID::Uniform2i:
+        case GLFunctionID::Uniform2iv:
+        case GLFunctionID::Uniform3f:
+        case GLFunctionID::Uniform3fv:
+        case GLFunctionID::Uniform3i:
+        case GLFunctionID::Uniform3iv:
+        case GLFunctionID::Uniform4f:
+        case GLFunctionID::Uniform4fv:
+        case GLFunctionID::Uniform4i:
+        case GLFunctionID::Uniform4iv:
+        case GLFunctionID::UniformMatrix3fv:
+        case GLFunctionID::UniformMatrix4fv:
+        {
+            const GLint    captured_location = unpack_gl_capture_slot<GLint>(inout_arg_slots_ptr[0]);
+            const uint64_t key               = (static_cast<uint64_t>(m_current_program) << 32) | static_cast<uint32_t>(captured_location);
+            const auto     location_iterator = m_uniform_location_map.find(key);
+
+            if (location_iterator != m_uniform_location_map.end() )
+            {
+                inout_arg_slots_ptr[0] = pack_gl_capture_slot(location_iterator->second);
+            }
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+void Framework::GLReplayer::on_call_timed(const GLFunctionID& in_id,
+                                          const double&       in_call_time_ms)
+{
+    auto& function_stats = m_function_stats[static_cast<uint32_t>(in_id)];
+
+    function_stats.max_call_time_ms    = std::max(function_stats.max_call_time_ms,
+                                                  in_call_time_ms);
+    function_stats.n_calls            += 1;
+    function_stats.total_call_time_ms += in_call_time_ms;
+
+    m_frame_stats_ptr->call_time_ms += in_call_time_ms;
+    m_frame_stats_ptr->n_calls      += 1;
+}
+
+bool Framework::GLReplayer::read(void*         out_data_ptr,
+                                 const size_t& in_size)
+{
+    bool result = false;
+
+    if (m_read_offset + in_size > m_data_u8_vec.size() )
+    {
+        Framework::report_error("GL capture [%s] is truncated.",
+                                m_filename);
+
+        goto end;
+    }
+
+    if (in_size > 0)
+    {
+        memcpy(out_data_ptr,
+               m_data_u8_vec.data() + m_read_offset,
+               in_size);
+    }
+
+    m_read_offset += in_size;
+    result         = true;
+end:
+    return result;
+}
+
+bool Framework::GLReplayer::read_output_payloads(const GLFunctionID& in_id,
+                                                 const Payload*      in_payloads_ptr,
+                                                 const bool*         in_is_payload_arg_ptr,
+                                                 const uint32_t&     in_n_args)
+{
+    ObjectNamespace name_namespace    = ObjectNamespace::COUNT;
+    const bool      is_name_generator = get_object_name_array_namespace(in_id,
+                                                                        &name_namespace);
+    bool            result            = false;
+
+    for (uint32_t n_arg = 0;
+                  n_arg < in_n_args;
+                ++n_arg)
+    {
+        const auto& current_payload = in_payloads_ptr[n_arg];
+
+        if (!in_is_payload_arg_ptr[n_arg]                         ||
+            current_payload.type != GLCapturePayloadType::OUTPUT)
+        {
+            continue;
+        }
+
+        if (m_read_offset + current_payload.size > m_data_u8_vec.size() )
+        {
+            Framework::report_error("GL capture [%s] is truncated.",
+                                    m_filename);
+
+            goto end;
+        }
+
+        /* Other outputs (eg. query results) may legitimately differ between runs and are skipped. */
+        if (is_name_generator)
+        {
+            auto&          name_map     = m_object_name_maps[static_cast<uint32_t>(name_namespace)];
+            const uint32_t n_names      = current_payload.size / sizeof(GLuint);
+            const auto     names_u8_ptr = static_cast<const uint8_t*>(current_payload.data_ptr);
+
+            for (uint32_t n_name = 0;
+                          n_name < n_names;
+                        ++n_name)
+            {
+                GLuint captured_name = 0;
+                GLuint replayed_name = 0;
+
+                memcpy(&captured_name,
+                       m_data_u8_vec.data() + m_read_offset + n_name * sizeof(GLuint),
+                       sizeof(GLuint) );
+                memcpy(&replayed_name,
+                       names_u8_ptr + n_name * sizeof(GLuint),
+                       sizeof(GLuint) );
+
+                name_map[captured_name] = replayed_name;
+            }
+        }
+
+        m_read_offset += current_payload.size;
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+bool Framework::GLReplayer::read_payload(const uint32_t& in_n_arg,
+                                         Payload*        out_payload_ptr)
+{
+    uint32_t n_strings = 0;
+    bool     result    = false;
+    uint32_t size      = 0;
+    uint8_t  type      = 0;
+
+    if (!read(&type, sizeof(type) ) ||
+        !read(&size, sizeof(size) ))
+    {
+        goto end;
+    }
+
+    out_payload_ptr->data_ptr = nullptr;
+    out_payload_ptr->size     = size;
+    out_payload_ptr->type     = static_cast<GLCapturePayloadType>(type);
+
+    switch (out_payload_ptr->type)
+    {
+        case GLCapturePayloadType::NONE:
+        case GLCapturePayloadType::NULL_POINTER:
+        {
+            break;
+        }
+
+        case GLCapturePayloadType::INPUT:
+        case GLCapturePayloadType::STRING_ARRAY:
+        {
+            if (out_payload_ptr->type == GLCapturePayloadType::STRING_ARRAY &&
+                !read(&n_strings,
+                      sizeof(n_strings) ))
+            {
+                goto end;
+            }
+
+            /* Payload data starts at an 8-byte aligned offset. */
+            m_read_offset = (m_read_offset + 7) / 8 * 8;
+
+            if (m_read_offset + size > m_data_u8_vec.size() )
+            {
+                Framework::report_error("GL capture [%s] is truncated.",
+                                        m_filename);
+
+                goto end;
+            }
+
+            if (out_payload_ptr->type == GLCapturePayloadType::INPUT)
+            {
+                out_payload_ptr->data_ptr = m_data_u8_vec.data() + m_read_offset;
+            }
+            else
+            {
+                auto&       string_ptr_vec  = m_string_array_ptr_vecs.at(in_n_arg);
+                const char* string_ptr      = reinterpret_cast<const char*>(m_data_u8_vec.data() + m_read_offset);
+                const char* strings_end_ptr = string_ptr + size;
+
+                string_ptr_vec.clear();
+
+                for (uint32_t n_string = 0;
+                              n_string < n_strings;
+                            ++n_string)
+                {
+                    const char* terminator_ptr = static_cast<const char*>(memchr(string_ptr,
+                                                                                 '\0',
+                                                                                 static_cast<size_t>(strings_end_ptr - string_ptr) ));
+
+                    if (terminator_ptr == nullptr)
+                    {
+                        Framework::report_error("GL capture [%s] holds a malformed string array.",
+                                                m_filename);
+
+                        goto end;
+                    }
+
+                    string_ptr_vec.push_back(string_ptr);
+
+                    string_ptr = terminator_ptr + 1;
+                }
+
+                out_payload_ptr->data_ptr = string_ptr_vec.data();
+            }
+
+            m_read_offset += size;
+
+            break;
+        }
+
+        case GLCapturePayloadType::OUTPUT:
+        {
+            auto& output_u8_vec = m_output_payload_u8_vecs.at(in_n_arg);
+
+            output_u8_vec.assign(size,
+                                 0);
+
+            out_payload_ptr->data_ptr = output_u8_vec.data();
+
+            break;
+        }
+
+        default:
+        {
+            Framework::report_error("GL capture [%s] holds an unrecognized payload type.",
+                                    m_filename);
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+GLuint Framework::GLReplayer::translate_object_name(const ObjectNamespace& in_namespace,
+                                                    const GLuint&          in_captured_name)
+{
+    const auto& name_map      = m_object_name_maps[static_cast<uint32_t>(in_namespace)];
+    const auto  name_iterator = name_map.find(in_captured_name);
+    GLuint      result        = in_captured_name;
+
+    if (name_iterator != name_map.end() )
+    {
+        result = name_iterator->second;
+    }
+    else if (in_captured_name != 0)
+    {
+        ++m_n_unknown_object_names;
+    }
+
+    return result;
+}
+
+void Framework::GLReplayer::translate_object_name_arg(const ObjectNamespace& in_namespace,
+                                                      uint64_t*              inout_arg_slot_ptr)
+{
+    *inout_arg_slot_ptr = pack_gl_capture_slot(translate_object_name(in_namespace,
+                                                                     unpack_gl_capture_slot<GLuint>(*inout_arg_slot_ptr) ));
+}
+
+bool Framework::GLReplayer::replay_frame(GLReplayFrameStats* out_stats_ptr)
+{
+    uint32_t record_id = 0;
+    bool     result    = false;
+
+    *out_stats_ptr    = GLReplayFrameStats();
+    m_frame_stats_ptr = out_stats_ptr;
+
+    while (true)
+    {
+        if (!read(&record_id,
+                  sizeof(record_id) ))
+        {
+            goto end;
+        }
+
+        if (record_id == GL_CAPTURE_RECORD_END_OF_FRAME)
+        {
+            break;
+        }
+        else if (record_id == GL_CAPTURE_RECORD_END_OF_STREAM)
+        {
+            goto end;
+        }
+        else if (record_id >= static_cast<uint32_t>(GLFunctionID::COUNT) )
+        {
+            Framework::report_error("GL capture [%s] holds an unrecognized record.",
+                                    m_filename);
+
+            goto end;
+        }
+
+        if (!m_replay_call_func_ptrs[record_id](this) )
+        {
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    m_frame_stats_ptr = nullptr;
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,566 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "golden_image.h"
+#include "file_io.h"
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FRAMEWORK_USE_SSE2
+    #include <emmintrin.h>
+#endif
+
+/* Private variables */
+static const uint32_t ALPHA_CHANNEL_MASK = 0xFF000000; /* RGBA8 pixels loaded as little-endian uint32s. */
+
+#if defined(FRAMEWORK_USE_SSE2)
+    /* Number of bits set in each 4-bit value. */
+    static const uint32_t N_BITS_SET[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+    /* Each iteration adds at most 2 * 2 * 255^2 to each 32-bit lane of the squared difference accumulator, so it
+     * needs to be flushed to 64-bit storage every this many iterations. */
+    static const uint32_t N_ITERATIONS_PER_SQUARED_DIFF_FLUSH = 4096;
+#endif
+
+static void diff_pixel(const uint8_t*  in_pixel1_ptr,
+                       const uint8_t*  in_pixel2_ptr,
+                       const uint32_t& in_tolerance,
+                       uint32_t*       inout_max_channel_difference_ptr,
+                       uint32_t*       inout_n_differing_pixels_ptr,
+                       uint64_t*       inout_sum_squared_difference_ptr)
+{
+    bool is_differing = false;
+
+    /* Skips alpha. */
+    for (uint32_t n_channel = 0;
+                  n_channel < 3;
+                ++n_channel)
+    {
+        const uint32_t difference = static_cast<uint32_t>(std::abs(static_cast<int>(in_pixel1_ptr[n_channel]) - static_cast<int>(in_pixel2_ptr[n_channel]) ));
+
+        *inout_max_channel_difference_ptr  = std::max(*inout_max_channel_difference_ptr,
+                                                      difference);
+        *inout_sum_squared_difference_ptr += difference * difference;
+
+        is_differing |= (difference > in_tolerance);
+    }
+
+    if (is_differing)
+    {
+        ++(*inout_n_differing_pixels_ptr);
+    }
+}
+
+Framework::ImageDiff Framework::diff_images(const Image&    in_image1,
+                                            const Image&    in_image2,
+                                            const uint32_t& in_tolerance)
+{
+    const uint32_t n_pixels               = in_image1.width * in_image1.height;
+    uint32_t       n_pixel                = 0;
+    const uint8_t* pixels1_ptr            = in_image1.rgba_u8_vec.data();
+    const uint8_t* pixels2_ptr            = in_image2.rgba_u8_vec.data();
+    ImageDiff      result;
+    uint64_t       sum_squared_difference = 0;
+
+    assert(in_image1.width              == in_image2.width);
+    assert(in_image1.height             == in_image2.height);
+    assert(in_image1.rgba_u8_vec.size() == n_pixels * 4);
+    assert(in_image2.rgba_u8_vec.size() == n_pixels * 4);
+
+    #if defined(FRAMEWORK_USE_SSE2)
+    {
+        /* Processes 4 pixels per iteration. */
+        const __m128i color_mask     = _mm_set1_epi32  (static_cast<int>(~ALPHA_CHANNEL_MASK) );
+        const __m128i tolerance      = _mm_set1_epi8   (static_cast<char>(std::min(in_tolerance, 255u) ));
+        const __m128i zero           = _mm_setzero_si128();
+        __m128i       max_difference = _mm_setzero_si128();
+        __m128i       squared_sum    = _mm_setzero_si128();
+        uint32_t      n_iterations   = 0;
+
+        for (;
+             n_pixel + 4 <= n_pixels;
+             n_pixel += 4)
+        {
+            const __m128i pixels1    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels1_ptr + n_pixel * 4) );
+            const __m128i pixels2    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels2_ptr + n_pixel * 4) );
+            const __m128i difference = _mm_and_si128  (_mm_or_si128(_mm_subs_epu8(pixels1, pixels2),
+                                                                    _mm_subs_epu8(pixels2, pixels1) ),
+                                                       color_mask);
+
+            /* A pixel is within tolerance if none of its channels exceeds it. */
+            {
+                const __m128i excess         = _mm_subs_epu8   (difference, tolerance);
+                const __m128i is_within_mask = _mm_cmpeq_epi32 (excess,     zero);
+                const int     within_bits    = _mm_movemask_ps(_mm_castsi128_ps(is_within_mask) );
+
+                result.n_differing_pixels += 4 - N_BITS_SET[within_bits];
+            }
+
+            max_difference = _mm_max_epu8 (max_difference,
+                                           difference);
+            squared_sum    = _mm_add_epi32(squared_sum,
+                                           _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(difference, zero), _mm_unpacklo_epi8(difference, zero) ),
+                                                         _mm_madd_epi16(_mm_unpackhi_epi8(difference, zero), _mm_unpackhi_epi8(difference, zero) )));
+
+            if (++n_iterations == N_ITERATIONS_PER_SQUARED_DIFF_FLUSH)
+            {
+                uint32_t squared_sum_lanes[4];
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(squared_sum_lanes),
+                                 squared_sum);
+
+                sum_squared_difference += static_cast<uint64_t>(squared_sum_lanes[0]) + squared_sum_lanes[1] + squared_sum_lanes[2] + squared_sum_lanes[3];
+                squared_sum             = _mm_setzero_si128();
+                n_iterations            = 0;
+            }
+        }
+
+        {
+            uint8_t  max_difference_bytes[16];
+            uint32_t squared_sum_lanes   [4];
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(max_difference_bytes),
+                             max_difference);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(squared_sum_lanes),
+                             squared_sum);
+
+            result.max_channel_difference = *std::max_element(max_difference_bytes,
+                                                              max_difference_bytes + 16);
+            sum_squared_difference       += static_cast<uint64_t>(squared_sum_lanes[0]) + squared_sum_lanes[1] + squared_sum_lanes[2] + squared_sum_lanes[3];
+        }
+    }
+    #endif
+
+    /* Remaining pixels, or all of them if SSE2 is not available. */
+    for (;
+         n_pixel < n_pixels;
+       ++n_pixel)
+    {
+        diff_pixel(pixels1_ptr + n_pixel * 4,
+                   pixels2_ptr + n_pixel * 4,
+                   in_tolerance,
+                  &result.max_channel_difference,
+                  &result.n_differing_pixels,
+                  &sum_squared_difference);
+    }
+
+    if (sum_squared_difference == 0)
+    {
+        result.psnr_db = INFINITY;
+    }
+    else
+    {
+        const double mse = static_cast<double>(sum_squared_difference) / (3.0 * static_cast<double>(n_pixels) );
+
+        result.psnr_db = 10.0 * log10(255.0 * 255.0 / mse);
+    }
+
+    return result;
+}
+
+bool Framework::load_image(const std::string& in_filename,
+                           Image*             out_image_ptr)
+{
+    const char* data_ptr        = nullptr;
+    auto        data_u8_vec_ptr = Framework::read_file(in_filename);
+    uint32_t    depth           = 0;
+    uint32_t    height          = 0;
+    uint32_t    max_value       = 0;
+    uint32_t    n_header_bytes  = 0;
+    bool        result          = false;
+    uint32_t    width           = 0;
+
+    if (data_u8_vec_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    data_ptr = reinterpret_cast<const char*>(data_u8_vec_ptr->data() );
+
+    /* Parse the header, one "<token> <value>" line at a time. */
+    while (true)
+    {
+        const char* line_end_ptr = static_cast<const char*>(memchr(data_ptr + n_header_bytes,
+                                                                   '\n',
+                                                                   data_u8_vec_ptr->size() - n_header_bytes) );
+        std::string line;
+
+        if (line_end_ptr == nullptr)
+        {
+            Framework::report_error("[%s] is not a valid PAM file.",
+                                    in_filename);
+
+            goto end;
+        }
+
+        line           = std::string(data_ptr + n_header_bytes,
+                                     line_end_ptr);
+        n_header_bytes = static_cast<uint32_t>(line_end_ptr - data_ptr) + 1;
+
+        if (line == "ENDHDR")
+        {
+            break;
+        }
+
+        sscanf(line.c_str(), "WIDTH %u",  &width);
+        sscanf(line.c_str(), "HEIGHT %u", &height);
+        sscanf(line.c_str(), "DEPTH %u",  &depth);
+        sscanf(line.c_str(), "MAXVAL %u", &max_value);
+    }
+
+    if (strncmp(data_ptr, "P7\n", 3) != 0 ||
+        depth                        != 4 ||
+        max_value                    != 255)
+    {
+        Framework::report_error("[%s] is not an 8-bit RGBA PAM file.",
+                                in_filename);
+
+        goto end;
+    }
+
+    if (data_u8_vec_ptr->size() - n_header_bytes != static_cast<size_t>(width) * height * 4)
+    {
+        Framework::report_error("[%s] is truncated.",
+                                in_filename);
+
+        goto end;
+    }
+
+    out_image_ptr->height = height;
+    out_image_ptr->width  = width;
+
+    out_image_ptr->rgba_u8_vec.assign(data_u8_vec_ptr->begin() + n_header_bytes,
+                                      data_u8_vec_ptr->end  () );
+
+    result = true;
+end:
+    return result;
+}
+
+bool Framework::save_image(const std::string& in_filename,
+                           const Image&       in_image)
+{
+    FILE* file_ptr = ::fopen(in_filename.c_str(),
+                             "wb");
+    bool  result   = false;
+
+    if (file_ptr == nullptr)
+    {
+        Framework::report_error("Could not open [%s] for writing.",
+                                in_filename);
+
+        goto end;
+    }
+
+    fprintf(file_ptr,
+            "P7\nWIDTH %u\nHEIGHT %u\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n",
+            in_image.width,
+            in_image.height);
+
+    result = in_image.rgba_u8_vec.empty() || (::fwrite(in_image.rgba_u8_vec.data(),
+                                                       in_image.rgba_u8_vec.size(),
+                                                       1u,
+                                                       file_ptr) == 1);
+
+    ::fclose(file_ptr);
+
+    if (!result)
+    {
+        Framework::report_error("Could not write [%s].",
+                                in_filename);
+    }
+
+end:
+    return result;
+}
+
+Framework::GoldenImageTest::GoldenImageTest(const std::string&     in_filename,
+                                            const uint32_t&        in_n_frames,
+                                            const GoldenImageMode& in_mode,
+                                            const uint32_t&        in_tolerance,
+                                            const double&          in_min_psnr_db)
+    :m_filename           (in_filename),
+     m_min_psnr_db        (in_min_psnr_db),
+     m_mode               (in_mode),
+     m_n_frames           (in_n_frames),
+     m_tolerance          (in_tolerance),
+     m_max_frame_time_ms  (0.0),
+     m_min_frame_time_ms  (0.0),
+     m_has_failed         (false),
+     m_n_frames_rendered  (0),
+     m_total_frame_time_ms(0.0)
+{
+    /* Stub */
+}
+
+Framework::GoldenImageTest::~GoldenImageTest()
+{
+    /* Stub */
+}
+
+bool Framework::GoldenImageTest::check_frame(const Image& in_frame)
+{
+    ImageDiff diff;
+    Image     diff_image;
+    Image     reference_image;
+    bool      result          = false;
+
+    if (!load_image(m_filename,
+                   &reference_image) )
+    {
+        goto end;
+    }
+
+    if (reference_image.width  != in_frame.width ||
+        reference_image.height != in_frame.height)
+    {
+        Framework::log_message(LogSeverity::ERROR,
+                               "GoldenImage",
+                               "Frame size (%ux%u) does not match size of the reference image [%s] (%ux%u).",
+                               in_frame.width,
+                               in_frame.height,
+                               m_filename,
+                               reference_image.width,
+                               reference_image.height);
+
+        save_image(m_filename + ".actual.pam",
+                   in_frame);
+
+        goto end;
+    }
+
+    diff   = diff_images(reference_image,
+                         in_frame,
+                         m_tolerance);
+    result = (diff.n_differing_pixels == 0) && (diff.psnr_db >= m_min_psnr_db);
+
+    if (result)
+    {
+        printf("Golden image [%s] matched: PSNR %.2f dB, max channel difference %u.\n",
+               m_filename.c_str(),
+               diff.psnr_db,
+               diff.max_channel_difference);
+
+        goto end;
+    }
+
+    Framework::log_message(LogSeverity::ERROR,
+                           "GoldenImage",
+                           "Frame does not match [%s]: %u pixel(s) differ by more than %u, PSNR %.2f dB (min %.2f dB), max channel difference %u.",
+                           m_filename,
+                           diff.n_differing_pixels,
+                           m_tolerance,
+                           diff.psnr_db,
+                           m_min_psnr_db,
+                           diff.max_channel_difference);
+
+    /* Differing pixels are marked red. Others are shown as a dimmed grayscale version of the reference. */
+    diff_image = reference_image;
+
+    for (uint32_t n_pixel = 0;
+                  n_pixel < in_frame.width * in_frame.height;
+                ++n_pixel)
+    {
+        const uint8_t* frame_pixel_ptr     = in_frame.rgba_u8_vec.data()        + n_pixel * 4;
+        uint8_t*       diff_pixel_ptr      = diff_image.rgba_u8_vec.data()      + n_pixel * 4;
+        const uint8_t* reference_pixel_ptr = reference_image.rgba_u8_vec.data() + n_pixel * 4;
+        uint32_t       max_difference      = 0;
+
+        for (uint32_t n_channel = 0;
+                      n_channel < 3;
+                    ++n_channel)
+        {
+            max_difference = std::max(max_difference,
+                                      static_cast<uint32_t>(std::abs(static_cast<int>(frame_pixel_ptr[n_channel]) - static_cast<int>(reference_pixel_ptr[n_channel]) )));
+        }
+
+        if (max_difference > m_tolerance)
+        {
+            diff_pixel_ptr[0] = static_cast<uint8_t>(std::min(128u + max_difference, 255u) );
+            diff_pixel_ptr[1] = 0;
+            diff_pixel_ptr[2] = 0;
+        }
+        else
+        {
+            const uint8_t luminance = static_cast<uint8_t>( (static_cast<uint32_t>(reference_pixel_ptr[0]) + reference_pixel_ptr[1] + reference_pixel_ptr[2]) / 12);
+
+            diff_pixel_ptr[0] = luminance;
+            diff_pixel_ptr[1] = luminance;
+            diff_pixel_ptr[2] = luminance;
+        }
+
+        diff_pixel_ptr[3] = 255;
+    }
+
+    save_image(m_filename + ".actual.pam",
+               in_frame);
+    save_image(m_filename + ".diff.pam",
+               diff_image);
+
+end:
+    return result;
+}
+
+Framework::GoldenImageTestUniquePtr Framework::GoldenImageTest::create(const std::string&     in_filename,
+                                                                       const uint32_t&        in_n_frames,
+                                                                       const GoldenImageMode& in_mode,
+                                                                       const uint32_t&        in_tolerance,
+                                                                       const double&          in_min_psnr_db)
+{
+    GoldenImageTestUniquePtr result_ptr;
+
+    if (in_n_frames == 0)
+    {
+        Framework::report_error("At least one frame needs to be rendered for a golden image test.");
+
+        goto end;
+    }
+
+    result_ptr.reset(new GoldenImageTest(in_filename,
+                                         in_n_frames,
+                                         in_mode,
+                                         in_tolerance,
+                                         in_min_psnr_db) );
+
+end:
+    return result_ptr;
+}
+
+bool Framework::GoldenImageTest::on_frame_end(const int& in_framebuffer_width,
+                                              const int& in_framebuffer_height)
+{
+    const auto current_time = std::chrono::steady_clock::now();
+    bool       result       = false;
+
+    if (m_n_frames_rendered >= m_n_frames)
+    {
+        /* Already done. */
+        result = true;
+
+        goto end;
+    }
+
+    /* The first frame also accounts for app initialization, so it is left out of the timings. */
+    if (m_n_frames_rendered > 0)
+    {
+        const double frame_time_ms = std::chrono::duration<double, std::milli>(current_time - m_last_frame_end_time).count();
+
+        m_max_frame_time_ms    = (m_n_frames_rendered == 1) ? frame_time_ms : std::max(m_max_frame_time_ms, frame_time_ms);
+        m_min_frame_time_ms    = (m_n_frames_rendered == 1) ? frame_time_ms : std::min(m_min_frame_time_ms, frame_time_ms);
+        m_total_frame_time_ms += frame_time_ms;
+    }
+
+    m_last_frame_end_time = current_time;
+
+    if (++m_n_frames_rendered < m_n_frames)
+    {
+        goto end;
+    }
+
+    {
+        Image frame;
+
+        frame.height = static_cast<uint32_t>(std::max(in_framebuffer_height, 0) );
+        frame.width  = static_cast<uint32_t>(std::max(in_framebuffer_width,  0) );
+
+        frame.rgba_u8_vec.resize(frame.width * frame.height * 4);
+
+        if (frame.rgba_u8_vec.size() > 0)
+        {
+            const uint32_t       row_size = frame.width * 4;
+            std::vector<uint8_t> row_u8_vec(row_size);
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                              0);
+            glReadBuffer     (GL_BACK);
+            glPixelStorei    (GL_PACK_ALIGNMENT,
+                              1);
+            glReadPixels     (0, /* x */
+                              0, /* y */
+                              in_framebuffer_width,
+                              in_framebuffer_height,
+                              GL_RGBA,
+                              GL_UNSIGNED_BYTE,
+                              frame.rgba_u8_vec.data() );
+
+            /* GL returns the bottom row first. */
+            for (uint32_t n_row = 0;
+                          n_row < frame.height / 2;
+                        ++n_row)
+            {
+                uint8_t* top_row_ptr    = frame.rgba_u8_vec.data() + n_row                      * row_size;
+                uint8_t* bottom_row_ptr = frame.rgba_u8_vec.data() + (frame.height - 1 - n_row) * row_size;
+
+                memcpy(row_u8_vec.data(), top_row_ptr,       row_size);
+                memcpy(top_row_ptr,       bottom_row_ptr,    row_size);
+                memcpy(bottom_row_ptr,    row_u8_vec.data(), row_size);
+            }
+        }
+
+        if (m_mode == GoldenImageMode::UPDATE)
+        {
+            m_has_failed = !save_image(m_filename,
+                                       frame);
+
+            if (!m_has_failed)
+            {
+                printf("Golden image [%s] updated (%ux%u).\n",
+                       m_filename.c_str(),
+                       frame.width,
+                       frame.height);
+            }
+        }
+        else
+        {
+            m_has_failed = !check_frame(frame);
+        }
+    }
+
+    if (!m_has_failed)
+    {
+        print_timings();
+    }
+
+    fflush(stdout);
+
+    result = true;
+end:
+    return result;
+}
+
+void Framework::GoldenImageTest::print_timings() const
+{
+    const uint32_t n_timed_frames = m_n_frames_rendered - 1;
+
+    printf("Rendered %u frame(s): avg %.3f ms, min %.3f ms, max %.3f ms (first frame excluded).\n",
+           m_n_frames_rendered,
+           (n_timed_frames > 0) ? m_total_frame_time_ms / static_cast<double>(n_timed_frames) : 0.0,
+           m_min_frame_time_ms,
+           m_max_frame_time_ms);
+}
\ No newline at end of file
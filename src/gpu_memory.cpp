@@ -0,0 +1,425 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gpu_memory.h"
+#include "imgui.h"
+#include "log.h"
+#include <algorithm>
+#include <assert.h>
+#include <float.h>
+#include <map>
+#include <mutex>
+#include <stdio.h>
+#include <unordered_map>
+
+namespace
+{
+    struct TagTotals
+    {
+        uint32_t n_allocations;
+        uint64_t n_bytes;
+    };
+
+    /* Type defs */
+    typedef std::map<std::pair<Framework::GPUMemoryType, std::string>, TagTotals> TagTotalsMap;
+
+    struct Allocation
+    {
+        uint64_t               n_bytes;
+        TagTotalsMap::iterator tag_totals_iterator;
+    };
+}
+
+/* All guarded by g_mutex */
+static std::unordered_map<Framework::GPUMemoryAllocationID, Allocation> g_allocation_map;
+static uint64_t                                                         g_budget_n_bytes    = 0;
+static bool                                                             g_is_over_budget    = false;
+static std::mutex                                                       g_mutex;
+static uint32_t                                                         g_n_budget_overruns = 0;
+static Framework::GPUMemoryTypeSizeArray                                g_n_bytes_per_type  = {};
+static Framework::GPUMemoryAllocationID                                 g_next_id           = 1;
+static uint64_t                                                         g_peak_n_bytes      = 0;
+static TagTotalsMap                                                     g_tag_totals_map;
+static uint64_t                                                         g_total_n_bytes     = 0;
+
+static void format_size(const uint64_t& in_n_bytes,
+                        const size_t&   in_n_max_chars,
+                        char*           out_text_ptr)
+{
+    if (in_n_bytes >= 1024 * 1024)
+    {
+        snprintf(out_text_ptr,
+                 in_n_max_chars,
+                 "%.2f MiB",
+                 static_cast<double>(in_n_bytes) / (1024.0 * 1024.0) );
+    }
+    else
+    if (in_n_bytes >= 1024)
+    {
+        snprintf(out_text_ptr,
+                 in_n_max_chars,
+                 "%.2f KiB",
+                 static_cast<double>(in_n_bytes) / 1024.0);
+    }
+    else
+    {
+        snprintf(out_text_ptr,
+                 in_n_max_chars,
+                 "%u B",
+                 static_cast<uint32_t>(in_n_bytes) );
+    }
+}
+
+/* Must be called with g_mutex held. */
+static std::vector<Framework::GPUMemoryTagStats> get_tag_stats()
+{
+    std::vector<Framework::GPUMemoryTagStats> result_vec;
+
+    result_vec.reserve(g_tag_totals_map.size() );
+
+    for (const auto& current_tag_totals : g_tag_totals_map)
+    {
+        Framework::GPUMemoryTagStats tag_stats;
+
+        tag_stats.n_allocations = current_tag_totals.second.n_allocations;
+        tag_stats.n_bytes       = current_tag_totals.second.n_bytes;
+        tag_stats.tag           = current_tag_totals.first.second;
+        tag_stats.type          = current_tag_totals.first.first;
+
+        result_vec.push_back(tag_stats);
+    }
+
+    std::stable_sort(result_vec.begin(),
+                     result_vec.end  (),
+                     [](const Framework::GPUMemoryTagStats& in_tag_stats1,
+                        const Framework::GPUMemoryTagStats& in_tag_stats2)
+                     {
+                         return in_tag_stats1.n_bytes > in_tag_stats2.n_bytes;
+                     });
+
+    return result_vec;
+}
+
+/* Must be called with g_mutex held. */
+static void release_tag_totals(const TagTotalsMap::iterator& in_tag_totals_iterator,
+                               const uint64_t&               in_n_bytes)
+{
+    const auto type_index = static_cast<uint32_t>(in_tag_totals_iterator->first.first);
+
+    assert(in_tag_totals_iterator->second.n_allocations >  0);
+    assert(in_tag_totals_iterator->second.n_bytes       >= in_n_bytes);
+
+    in_tag_totals_iterator->second.n_allocations--;
+
+    in_tag_totals_iterator->second.n_bytes -= in_n_bytes;
+    g_n_bytes_per_type.at(type_index)      -= in_n_bytes;
+
+    if (in_tag_totals_iterator->second.n_allocations == 0)
+    {
+        g_tag_totals_map.erase(in_tag_totals_iterator);
+    }
+}
+
+/* Must be called with g_mutex held. */
+static TagTotalsMap::iterator reserve_tag_totals(const Framework::GPUMemoryType& in_type,
+                                                 const std::string&              in_tag,
+                                                 const uint64_t&                 in_n_bytes)
+{
+    auto result_iterator = g_tag_totals_map.emplace(std::make_pair(in_type, in_tag),
+                                                    TagTotals{0, 0}).first;
+
+    result_iterator->second.n_allocations++;
+
+    result_iterator->second.n_bytes                        += in_n_bytes;
+    g_n_bytes_per_type.at(static_cast<uint32_t>(in_type) ) += in_n_bytes;
+
+    return result_iterator;
+}
+
+/* Must be called with g_mutex held, after the total has changed. Warns once each time the total crosses the budget. */
+static void update_budget_state()
+{
+    const bool is_over_budget = (g_budget_n_bytes > 0                &&
+                                 g_total_n_bytes  > g_budget_n_bytes);
+
+    if (is_over_budget && !g_is_over_budget)
+    {
+        static const uint32_t n_max_tags_listed = 8;
+
+        const auto tag_stats_vec = get_tag_stats();
+        char       budget_text[32];
+        char       total_text [32];
+
+        format_size(g_budget_n_bytes,
+                    sizeof(budget_text),
+                    budget_text);
+        format_size(g_total_n_bytes,
+                    sizeof(total_text),
+                    total_text);
+
+        Framework::log_message(Framework::LogSeverity::WARNING,
+                               "GPUMemory",
+                               "GPU memory budget exceeded: %s in use, budget is %s. Largest tags:",
+                               total_text,
+                               budget_text);
+
+        for (uint32_t n_tag = 0;
+                      n_tag < std::min(n_max_tags_listed, static_cast<uint32_t>(tag_stats_vec.size() ) );
+                    ++n_tag)
+        {
+            const auto& current_tag_stats = tag_stats_vec.at(n_tag);
+            char        size_text[32];
+
+            format_size(current_tag_stats.n_bytes,
+                        sizeof(size_text),
+                        size_text);
+
+            Framework::log_message(Framework::LogSeverity::WARNING,
+                                   "GPUMemory",
+                                   "    %s / %s: %s in %u allocation(s)",
+                                   Framework::get_gpu_memory_type_name(current_tag_stats.type),
+                                   current_tag_stats.tag.c_str        (),
+                                   size_text,
+                                   current_tag_stats.n_allocations);
+        }
+
+        g_n_budget_overruns++;
+    }
+
+    g_is_over_budget = is_over_budget;
+}
+
+void Framework::draw_gpu_memory_window(bool* inout_opt_is_open_ptr)
+{
+    const auto stats = Framework::get_gpu_memory_stats();
+    char       text[64];
+
+    if (ImGui::Begin("GPU memory",
+                     inout_opt_is_open_ptr) )
+    {
+        char peak_text [32];
+        char total_text[32];
+
+        format_size(stats.peak_n_bytes,
+                    sizeof(peak_text),
+                    peak_text);
+        format_size(stats.total_n_bytes,
+                    sizeof(total_text),
+                    total_text);
+
+        if (stats.budget_n_bytes > 0)
+        {
+            char budget_text[32];
+
+            format_size(stats.budget_n_bytes,
+                        sizeof(budget_text),
+                        budget_text);
+            snprintf   (text,
+                        sizeof(text),
+                        "%s / %s",
+                        total_text,
+                        budget_text);
+
+            ImGui::ProgressBar(static_cast<float>(static_cast<double>(stats.total_n_bytes) / static_cast<double>(stats.budget_n_bytes) ),
+                               ImVec2(-FLT_MIN, 0.0f),
+                               text);
+
+            if (stats.total_n_bytes > stats.budget_n_bytes)
+            {
+                ImGui::TextColored(ImVec4{1.0f, 0.3f, 0.3f, 1.0f},
+                                   "Over budget!");
+            }
+
+            ImGui::Text("Peak: %s, budget crossed %u time(s)",
+                        peak_text,
+                        stats.n_budget_overruns);
+        }
+        else
+        {
+            ImGui::Text("Total: %s (peak: %s), no budget set",
+                        total_text,
+                        peak_text);
+        }
+
+        for (uint32_t n_type = 0;
+                      n_type < static_cast<uint32_t>(GPUMemoryType::COUNT);
+                    ++n_type)
+        {
+            format_size(stats.n_bytes_per_type.at(n_type),
+                        sizeof(text),
+                        text);
+
+            ImGui::Text("%s: %s",
+                        get_gpu_memory_type_name(static_cast<GPUMemoryType>(n_type) ),
+                        text);
+        }
+
+        ImGui::Separator();
+
+        if (ImGui::BeginTable("Tags",
+                              4, /* columns */
+                              ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable) )
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Allocations");
+            ImGui::TableSetupColumn("Size");
+            ImGui::TableHeadersRow ();
+
+            for (const auto& current_tag_stats : stats.tag_stats_vec)
+            {
+                format_size(current_tag_stats.n_bytes,
+                            sizeof(text),
+                            text);
+
+                ImGui::TableNextRow   ();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(current_tag_stats.tag.c_str() );
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(get_gpu_memory_type_name(current_tag_stats.type) );
+                ImGui::TableNextColumn();
+                ImGui::Text           ("%u",
+                                       current_tag_stats.n_allocations);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(text);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    ImGui::End();
+}
+
+Framework::GPUMemoryStats Framework::get_gpu_memory_stats()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    GPUMemoryStats              result;
+
+    result.budget_n_bytes    = g_budget_n_bytes;
+    result.n_budget_overruns = g_n_budget_overruns;
+    result.n_bytes_per_type  = g_n_bytes_per_type;
+    result.peak_n_bytes      = g_peak_n_bytes;
+    result.tag_stats_vec     = get_tag_stats();
+    result.total_n_bytes     = g_total_n_bytes;
+
+    return result;
+}
+
+const char* Framework::get_gpu_memory_type_name(const GPUMemoryType& in_type)
+{
+    switch (in_type)
+    {
+        case GPUMemoryType::BUFFER:        return "Buffer";
+        case GPUMemoryType::RENDER_TARGET: return "Render target";
+        case GPUMemoryType::TEXTURE:       return "Texture";
+
+        default:
+        {
+            assert(false);
+        }
+    }
+
+    return "?";
+}
+
+Framework::GPUMemoryAllocationID Framework::register_gpu_memory(const GPUMemoryType& in_type,
+                                                                const std::string&   in_tag,
+                                                                const uint64_t&      in_n_bytes)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    const GPUMemoryAllocationID result_id = g_next_id++;
+    Allocation                  allocation;
+
+    allocation.n_bytes             = in_n_bytes;
+    allocation.tag_totals_iterator = reserve_tag_totals(in_type,
+                                                        in_tag,
+                                                        in_n_bytes);
+
+    g_allocation_map.emplace(result_id,
+                             allocation);
+
+    g_total_n_bytes += in_n_bytes;
+    g_peak_n_bytes   = std::max(g_peak_n_bytes,
+                                g_total_n_bytes);
+
+    update_budget_state();
+
+    return result_id;
+}
+
+void Framework::retag_gpu_memory(const GPUMemoryAllocationID& in_id,
+                                 const GPUMemoryType&         in_type,
+                                 const std::string&           in_tag)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto                        allocation_iterator = g_allocation_map.find(in_id);
+
+    if (allocation_iterator != g_allocation_map.end() )
+    {
+        release_tag_totals(allocation_iterator->second.tag_totals_iterator,
+                           allocation_iterator->second.n_bytes);
+
+        allocation_iterator->second.tag_totals_iterator = reserve_tag_totals(in_type,
+                                                                             in_tag,
+                                                                             allocation_iterator->second.n_bytes);
+    }
+    else
+    {
+        assert(false);
+    }
+}
+
+void Framework::set_gpu_memory_budget(const uint64_t& in_n_bytes)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    g_budget_n_bytes = in_n_bytes;
+
+    update_budget_state();
+}
+
+void Framework::unregister_gpu_memory(const GPUMemoryAllocationID& in_id)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto                        allocation_iterator = g_allocation_map.find(in_id);
+
+    if (allocation_iterator != g_allocation_map.end() )
+    {
+        release_tag_totals(allocation_iterator->second.tag_totals_iterator,
+                           allocation_iterator->second.n_bytes);
+
+        g_total_n_bytes -= allocation_iterator->second.n_bytes;
+
+        g_allocation_map.erase(allocation_iterator);
+
+        update_budget_state();
+    }
+    else
+    {
+        /* 0 is accepted so that owners do not need to check whether they have registered their storage. */
+        assert(in_id == 0);
+    }
+}
\ No newline at end of file
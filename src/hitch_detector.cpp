@@ -0,0 +1,340 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "hitch_detector.h"
+#include <algorithm>
+#include <stdio.h>
+
+Framework::HitchDetector::HitchDetector(const double&   in_threshold_ms,
+                                        const uint32_t& in_n_history_frames)
+    :m_frame_start_ns             (0),
+     m_n_frames_recorded          (0),
+     m_n_frames_to_next_dump      (0),
+     m_n_hitches                  (0),
+     m_is_zone_callback_registered(false),
+     m_n_history_frames           (in_n_history_frames),
+     m_threshold_ms               (in_threshold_ms)
+{
+    /* Stub */
+}
+
+Framework::HitchDetector::~HitchDetector()
+{
+    if (m_is_zone_callback_registered)
+    {
+        Framework::set_trace_zone_callback(nullptr,  /* in_func_ptr */
+                                           nullptr); /* in_user_arg */
+    }
+}
+
+void Framework::HitchDetector::begin_frame()
+{
+    m_frame_start_ns = Framework::get_trace_time_ns();
+}
+
+Framework::HitchDetectorUniquePtr Framework::HitchDetector::create(const double&   in_threshold_ms,
+                                                                   const uint32_t& in_n_history_frames)
+{
+    HitchDetectorUniquePtr result_ptr(
+        new HitchDetector(in_threshold_ms,
+                          in_n_history_frames)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+void Framework::HitchDetector::end_frame()
+{
+    const uint32_t n_frame_records = static_cast<uint32_t>(m_frame_record_vec.size() );
+    auto&          frame_record    = m_frame_record_vec[m_n_frames_recorded % n_frame_records];
+    double         frame_time_ms   = 0.0;
+
+    frame_record.end_ns   = Framework::get_trace_time_ns();
+    frame_record.n_frame  = m_n_frames_recorded;
+    frame_record.start_ns = m_frame_start_ns;
+
+    Framework::fetch_and_reset_frame_counters(&frame_record.counters);
+
+    #if defined(FRAMEWORK_GL_INSTRUMENTATION)
+    {
+        frame_record.gl_call_stats = Framework::get_gl_call_stats(true); /* in_last_frame_only */
+    }
+    #endif
+
+    /* Recycle the storage of the record being overwritten, so that no allocations are made in steady state. */
+    {
+        std::lock_guard<std::mutex> lock(m_pending_zone_vec_mutex);
+
+        std::swap(frame_record.zone_vec,
+                  m_pending_zone_vec);
+
+        m_pending_zone_vec.clear();
+    }
+
+    frame_time_ms = static_cast<double>(frame_record.end_ns - frame_record.start_ns) / 1000000.0;
+
+    m_n_frames_recorded++;
+
+    if (m_n_frames_to_next_dump > 0)
+    {
+        m_n_frames_to_next_dump--;
+    }
+
+    if (frame_time_ms > m_threshold_ms)
+    {
+        m_n_hitches++;
+
+        if (m_n_frames_to_next_dump == 0)
+        {
+            write_breakdowns(frame_record);
+
+            m_n_frames_to_next_dump = n_frame_records;
+        }
+    }
+}
+
+bool Framework::HitchDetector::init()
+{
+    bool result = false;
+
+    if (m_threshold_ms <= 0.0)
+    {
+        Framework::report_error("Hitch threshold must be larger than 0.");
+
+        goto end;
+    }
+
+    /* Previous frames + the offending one. */
+    m_frame_record_vec.resize(m_n_history_frames + 1);
+
+    for (auto& current_frame_record : m_frame_record_vec)
+    {
+        current_frame_record.zone_vec.reserve(64);
+    }
+
+    m_pending_zone_vec.reserve(64);
+
+    Framework::set_trace_zone_callback(on_zone_recorded,
+                                       this);
+
+    m_is_zone_callback_registered = true;
+    result                        = true;
+end:
+    return result;
+}
+
+void Framework::HitchDetector::on_zone_recorded(const char*     in_name_ptr,
+                                                const uint32_t& in_thread_index,
+                                                const uint64_t& in_start_ns,
+                                                const uint64_t& in_end_ns,
+                                                const uint64_t& in_n_allocations,
+                                                const uint64_t& in_n_allocated_bytes,
+                                                void*           in_user_arg)
+{
+    auto                        detector_ptr = reinterpret_cast<HitchDetector*>(in_user_arg);
+    std::lock_guard<std::mutex> lock        (detector_ptr->m_pending_zone_vec_mutex);
+
+    detector_ptr->m_pending_zone_vec.push_back(Zone{in_end_ns, in_n_allocated_bytes, in_n_allocations, in_name_ptr, in_start_ns, in_thread_index});
+}
+
+void Framework::HitchDetector::write_breakdowns(const FrameRecord& in_hitch_frame_record)
+{
+    const uint32_t    n_frame_records = static_cast<uint32_t>(m_frame_record_vec.size() );
+    const uint32_t    n_first_frame   = (m_n_frames_recorded > n_frame_records) ? m_n_frames_recorded - n_frame_records
+                                                                                : 0;
+    FILE*             file_ptr        = nullptr;
+    std::vector<Zone> sorted_zone_vec;
+
+    #if defined(__EMSCRIPTEN__)
+    {
+        file_ptr = stdout;
+    }
+    #else
+    {
+        const std::string filename = "hitch_" + std::to_string(in_hitch_frame_record.n_frame) + ".txt";
+
+        file_ptr = ::fopen(filename.c_str(),
+                           "wt");
+
+        if (file_ptr == nullptr)
+        {
+            Framework::report_error("Failed to open [%s] for writing.",
+                                    filename);
+
+            return;
+        }
+    }
+    #endif
+
+    fprintf(file_ptr,
+            "Hitch: frame %u took %.3f ms (threshold: %.3f ms).\n",
+            in_hitch_frame_record.n_frame,
+            static_cast<double>(in_hitch_frame_record.end_ns - in_hitch_frame_record.start_ns) / 1000000.0,
+            m_threshold_ms);
+
+    for (uint32_t n_frame = n_first_frame;
+                  n_frame < m_n_frames_recorded;
+                ++n_frame)
+    {
+        const auto& current_frame_record = m_frame_record_vec[n_frame % n_frame_records];
+
+        fprintf(file_ptr,
+                "\nFrame %u: %.3f ms%s\n",
+                current_frame_record.n_frame,
+                static_cast<double>(current_frame_record.end_ns - current_frame_record.start_ns) / 1000000.0,
+                (n_frame == in_hitch_frame_record.n_frame) ? " [hitch]" : "");
+
+        for (uint32_t n_counter = 0;
+                      n_counter < static_cast<uint32_t>(FrameCounter::COUNT);
+                    ++n_counter)
+        {
+            fprintf(file_ptr,
+                    "  %s: %llu\n",
+                    Framework::get_frame_counter_name(static_cast<FrameCounter>(n_counter) ),
+                    static_cast<unsigned long long>(current_frame_record.counters[n_counter]) );
+        }
+
+        /* Zones are listed per thread, in start order. Nested zones are indented. */
+        {
+            std::vector<uint64_t> zone_end_ns_stack;
+            uint32_t              n_current_thread = UINT32_MAX;
+
+            sorted_zone_vec = current_frame_record.zone_vec;
+
+            std::sort(sorted_zone_vec.begin(),
+                      sorted_zone_vec.end  (),
+                      [](const Zone& in_zone1,
+                         const Zone& in_zone2)
+                      {
+                          if (in_zone1.thread_index != in_zone2.thread_index)
+                          {
+                              return in_zone1.thread_index < in_zone2.thread_index;
+                          }
+
+                          if (in_zone1.start_ns != in_zone2.start_ns)
+                          {
+                              return in_zone1.start_ns < in_zone2.start_ns;
+                          }
+
+                          return in_zone1.end_ns > in_zone2.end_ns;
+                      });
+
+            fprintf(file_ptr,
+                    "  Zones (start relative to frame start, duration):\n");
+
+            for (const auto& current_zone : sorted_zone_vec)
+            {
+                if (current_zone.thread_index != n_current_thread)
+                {
+                    n_current_thread = current_zone.thread_index;
+
+                    zone_end_ns_stack.clear();
+
+                    fprintf(file_ptr,
+                            "    Thread %u:\n",
+                            n_current_thread);
+                }
+
+                while (!zone_end_ns_stack.empty()                      &&
+                        zone_end_ns_stack.back() <= current_zone.start_ns)
+                {
+                    zone_end_ns_stack.pop_back();
+                }
+
+                fprintf(file_ptr,
+                        "      %*s%+10.3f ms %10.3f ms  %s",
+                        static_cast<int>(zone_end_ns_stack.size() * 2),
+                        "",
+                        (static_cast<double>(current_zone.start_ns) - static_cast<double>(current_frame_record.start_ns) ) / 1000000.0,
+                        static_cast<double>(current_zone.end_ns - current_zone.start_ns)                                   / 1000000.0,
+                        current_zone.name_ptr);
+
+                if (current_zone.n_allocations > 0)
+                {
+                    fprintf(file_ptr,
+                            " (%llu allocation(s), %llu byte(s))",
+                            static_cast<unsigned long long>(current_zone.n_allocations),
+                            static_cast<unsigned long long>(current_zone.n_allocated_bytes) );
+                }
+
+                fputc('\n',
+                      file_ptr);
+
+                zone_end_ns_stack.push_back(current_zone.end_ns);
+            }
+        }
+
+        #if defined(FRAMEWORK_GL_INSTRUMENTATION)
+        {
+            std::vector<uint32_t> function_index_vec;
+
+            for (uint32_t n_function = 0;
+                          n_function < static_cast<uint32_t>(GLFunctionID::COUNT);
+                        ++n_function)
+            {
+                if (current_frame_record.gl_call_stats[n_function].n_calls > 0)
+                {
+                    function_index_vec.push_back(n_function);
+                }
+            }
+
+            std::sort(function_index_vec.begin(),
+                      function_index_vec.end  (),
+                      [&current_frame_record](const uint32_t& in_function1,
+                                              const uint32_t& in_function2)
+                      {
+                          return current_frame_record.gl_call_stats[in_function1].cpu_time_ms > current_frame_record.gl_call_stats[in_function2].cpu_time_ms;
+                      });
+
+            fprintf(file_ptr,
+                    "  GL calls (count, total time):\n");
+
+            for (const auto& current_function : function_index_vec)
+            {
+                fprintf(file_ptr,
+                        "    %-32s %8u %10.3f ms\n",
+                        Framework::get_gl_function_name(static_cast<GLFunctionID>(current_function) ),
+                        current_frame_record.gl_call_stats[current_function].n_calls,
+                        current_frame_record.gl_call_stats[current_function].cpu_time_ms);
+            }
+        }
+        #endif
+    }
+
+    #if defined(__EMSCRIPTEN__)
+    {
+        fflush(file_ptr);
+    }
+    #else
+    {
+        ::fclose(file_ptr);
+    }
+    #endif
+}
\ No newline at end of file
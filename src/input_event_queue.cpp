@@ -0,0 +1,179 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "input_event_queue.h"
+#include <algorithm>
+#include <assert.h>
+
+Framework::InputEventQueue::InputEventQueue(const uint32_t& in_capacity,
+                                            const bool&     in_keep_mouse_motion_history)
+    :m_event_vec                            (in_capacity),
+     m_mouse_motion_history_vec             ( (in_keep_mouse_motion_history) ? in_capacity : 0),
+     m_n_events                             (0),
+     m_n_events_dropped                     (0),
+     m_n_mouse_motion_history_events        (0),
+     m_n_mouse_motion_history_events_dropped(0),
+     m_keep_mouse_motion_history            (in_keep_mouse_motion_history)
+{
+    assert(in_capacity > 0);
+}
+
+Framework::InputEventQueueUniquePtr Framework::InputEventQueue::create(const uint32_t& in_capacity,
+                                                                       const bool&     in_keep_mouse_motion_history)
+{
+    InputEventQueueUniquePtr result_ptr(
+        new InputEventQueue(in_capacity,
+                            in_keep_mouse_motion_history)
+    );
+
+    return result_ptr;
+}
+
+InputEventBatch Framework::InputEventQueue::get_batch() const
+{
+    InputEventBatch result;
+
+    result.events_ptr       = m_event_vec.data();
+    result.n_events         = m_n_events;
+    result.n_events_dropped = m_n_events_dropped;
+
+    if (m_keep_mouse_motion_history)
+    {
+        result.mouse_motion_history_ptr              = m_mouse_motion_history_vec.data();
+        result.n_mouse_motion_history_events         = m_n_mouse_motion_history_events;
+        result.n_mouse_motion_history_events_dropped = m_n_mouse_motion_history_events_dropped;
+    }
+
+    return result;
+}
+
+bool Framework::InputEventQueue::make_room_for_event()
+{
+    const auto events_end_iterator = m_event_vec.begin() + m_n_events;
+    const auto event_iterator      = std::find_if(m_event_vec.begin(),
+                                                  events_end_iterator,
+                                                  [](const InputEvent& in_event)
+                                                  {
+                                                      return (in_event.type == InputEventType::MOUSE_POS ||
+                                                              in_event.type == InputEventType::SCROLL);
+                                                  });
+    bool       result              = false;
+
+    if (event_iterator != events_end_iterator)
+    {
+        const auto next_event_iterator = std::find_if(event_iterator + 1,
+                                                      events_end_iterator,
+                                                      [event_iterator](const InputEvent& in_event)
+                                                      {
+                                                          return (in_event.type == event_iterator->type);
+                                                      });
+
+        if (next_event_iterator != events_end_iterator)
+        {
+            /* Positions are absolute, so a MOUSE_POS event is superseded by the next one. Scroll offsets are
+             * summed up. */
+            if (next_event_iterator->type == InputEventType::SCROLL)
+            {
+                next_event_iterator->x += event_iterator->x;
+                next_event_iterator->y += event_iterator->y;
+            }
+        }
+        else
+        {
+            m_n_events_dropped++;
+        }
+
+        std::move(event_iterator + 1,
+                  events_end_iterator,
+                  event_iterator);
+
+        m_n_events--;
+
+        result = true;
+    }
+
+    return result;
+}
+
+void Framework::InputEventQueue::push(const InputEvent& in_event)
+{
+    InputEvent* last_event_ptr = (m_n_events > 0) ? &m_event_vec[m_n_events - 1]
+                                                   : nullptr;
+
+    if (in_event.type == InputEventType::MOUSE_POS)
+    {
+        if (m_keep_mouse_motion_history)
+        {
+            if (m_n_mouse_motion_history_events < m_mouse_motion_history_vec.size() )
+            {
+                m_mouse_motion_history_vec[m_n_mouse_motion_history_events++] = in_event;
+            }
+            else
+            {
+                m_n_mouse_motion_history_events_dropped++;
+            }
+        }
+
+        if (last_event_ptr       != nullptr                   &&
+            last_event_ptr->type == InputEventType::MOUSE_POS)
+        {
+            /* Keep the time of the oldest event, as for SCROLL events below. */
+            last_event_ptr->x = in_event.x;
+            last_event_ptr->y = in_event.y;
+
+            goto end;
+        }
+    }
+    else if (in_event.type == InputEventType::SCROLL)
+    {
+        if (last_event_ptr       != nullptr                &&
+            last_event_ptr->type == InputEventType::SCROLL)
+        {
+            /* Keep the time of the oldest event, so that latency measurements are not skewed. */
+            last_event_ptr->x += in_event.x;
+            last_event_ptr->y += in_event.y;
+
+            goto end;
+        }
+    }
+
+    if (m_n_events == m_event_vec.size() )
+    {
+        /* MOUSE_POS & SCROLL events are never let in at the expense of others. */
+        if (in_event.type == InputEventType::MOUSE_POS ||
+            in_event.type == InputEventType::SCROLL    ||
+            !make_room_for_event() )
+        {
+            m_n_events_dropped++;
+
+            goto end;
+        }
+    }
+
+    m_event_vec[m_n_events++] = in_event;
+
+end:
+    ;
+}
\ No newline at end of file
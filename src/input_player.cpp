@@ -0,0 +1,359 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "input_player.h"
+#include <stdio.h>
+#include <string.h>
+
+Framework::InputPlayer::InputPlayer(const std::string& in_filename)
+    :m_framebuffer_height(0),
+     m_framebuffer_width (0),
+     m_n_frames          (0),
+     m_read_offset       (0),
+     m_filename          (in_filename)
+{
+    /* Stub */
+}
+
+Framework::InputPlayerUniquePtr Framework::InputPlayer::create(const std::string& in_filename)
+{
+    InputPlayerUniquePtr result_ptr(
+        new InputPlayer(in_filename)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+bool Framework::InputPlayer::init()
+{
+    FILE*    file_handle = ::fopen(m_filename.c_str(),
+                                   "rb");
+    long     file_size   = 0;
+    uint32_t magic       = 0;
+    bool     result      = false;
+    uint32_t version     = 0;
+
+    if (file_handle == nullptr)
+    {
+        Framework::report_error("Could not open input recording [%s].",
+                                m_filename);
+
+        goto end;
+    }
+
+    ::fseek(file_handle,
+            0L,
+            SEEK_END);
+
+    file_size = ::ftell(file_handle);
+
+    ::fseek(file_handle,
+            0L,
+            SEEK_SET);
+
+    if (file_size <= 0)
+    {
+        Framework::report_error("Input recording [%s] is empty.",
+                                m_filename);
+
+        goto end;
+    }
+
+    m_data_u8_vec.resize(static_cast<size_t>(file_size) );
+
+    if (::fread(m_data_u8_vec.data(),
+                m_data_u8_vec.size(),
+                1, /* count */
+                file_handle) != 1)
+    {
+        Framework::report_error("Failed to read input recording [%s].",
+                                m_filename);
+
+        goto end;
+    }
+
+    if (!read(&magic,   sizeof(magic) )   ||
+        !read(&version, sizeof(version) ) ||
+        magic   != INPUT_RECORDING_MAGIC  ||
+        version != INPUT_RECORDING_VERSION)
+    {
+        Framework::report_error("[%s] is not a supported input recording.",
+                                m_filename);
+
+        goto end;
+    }
+
+    /* Find out how many frames the recording holds. The end-of-stream record is the last one in the file. */
+    {
+        const size_t end_of_stream_record_size = sizeof(uint8_t) + sizeof(uint32_t);
+        uint8_t      type                      = 0;
+
+        if (m_data_u8_vec.size() < m_read_offset + end_of_stream_record_size)
+        {
+            Framework::report_error("Input recording [%s] is truncated.",
+                                    m_filename);
+
+            goto end;
+        }
+
+        memcpy(&type,
+               m_data_u8_vec.data() + m_data_u8_vec.size() - end_of_stream_record_size,
+               sizeof(type) );
+        memcpy(&m_n_frames,
+               m_data_u8_vec.data() + m_data_u8_vec.size() - end_of_stream_record_size + sizeof(type),
+               sizeof(m_n_frames) );
+
+        if (type != static_cast<uint8_t>(InputRecordType::END_OF_STREAM) )
+        {
+            Framework::report_error("Input recording [%s] is truncated.",
+                                    m_filename);
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    if (file_handle != nullptr)
+    {
+        ::fclose(file_handle);
+    }
+
+    return result;
+}
+
+bool Framework::InputPlayer::play_frame(const uint32_t&                in_n_frame,
+                                        InputEventQueue*               in_input_event_queue_ptr,
+                                        int*                           inout_framebuffer_width_ptr,
+                                        int*                           inout_framebuffer_height_ptr,
+                                        std::vector<ReplayedFileDrop>* out_file_drop_vec_ptr)
+{
+    bool result = false;
+
+    while (true)
+    {
+        const size_t record_start_offset = m_read_offset;
+        uint32_t     n_frame             = 0;
+        uint8_t      type                = 0;
+
+        if (!read(&type,    sizeof(type) )   ||
+            !read(&n_frame, sizeof(n_frame) ))
+        {
+            goto end;
+        }
+
+        if (n_frame                              > in_n_frame ||
+            static_cast<InputRecordType>(type) == InputRecordType::END_OF_STREAM)
+        {
+            /* Belongs to a later frame. */
+            m_read_offset = record_start_offset;
+
+            break;
+        }
+
+        switch (static_cast<InputRecordType>(type) )
+        {
+            case InputRecordType::CHAR:
+            {
+                InputEvent new_event;
+
+                if (!read(&new_event.codepoint,
+                          sizeof(new_event.codepoint) ))
+                {
+                    goto end;
+                }
+
+                new_event.time = std::chrono::steady_clock::now();
+                new_event.type = InputEventType::CHAR;
+
+                in_input_event_queue_ptr->push(new_event);
+
+                break;
+            }
+
+            case InputRecordType::FILE_DROP:
+            {
+                ReplayedFileDrop file_drop;
+                uint32_t         data_size     = 0;
+                uint32_t         filename_size = 0;
+
+                if (!read(&filename_size,
+                          sizeof(filename_size) ))
+                {
+                    goto end;
+                }
+
+                file_drop.filename.resize(filename_size);
+
+                if (!read(&file_drop.filename[0], filename_size)     ||
+                    !read(&data_size,             sizeof(data_size) ))
+                {
+                    goto end;
+                }
+
+                file_drop.data_u8_vec_ptr.reset(new std::vector<uint8_t>(data_size) );
+
+                if (!read(file_drop.data_u8_vec_ptr->data(),
+                          data_size) )
+                {
+                    goto end;
+                }
+
+                out_file_drop_vec_ptr->push_back(std::move(file_drop) );
+
+                break;
+            }
+
+            case InputRecordType::FRAMEBUFFER_SIZE:
+            {
+                int32_t height = 0;
+                int32_t width  = 0;
+
+                if (!read(&width,  sizeof(width) )  ||
+                    !read(&height, sizeof(height) ))
+                {
+                    goto end;
+                }
+
+                m_framebuffer_height = static_cast<int>(height);
+                m_framebuffer_width  = static_cast<int>(width);
+
+                break;
+            }
+
+            case InputRecordType::KEY:
+            {
+                int32_t    action = 0;
+                int32_t    key    = 0;
+                int32_t    mods   = 0;
+                InputEvent new_event;
+
+                if (!read(&key,    sizeof(key) )    ||
+                    !read(&action, sizeof(action) ) ||
+                    !read(&mods,   sizeof(mods) ))
+                {
+                    goto end;
+                }
+
+                new_event.key        = static_cast<int>(key);
+                new_event.key_action = static_cast<int>(action);
+                new_event.key_mods   = static_cast<int>(mods);
+                new_event.time       = std::chrono::steady_clock::now();
+                new_event.type       = InputEventType::KEY;
+
+                in_input_event_queue_ptr->push(new_event);
+
+                break;
+            }
+
+            case InputRecordType::MOUSE_BUTTON:
+            case InputRecordType::MOUSE_POS:
+            case InputRecordType::SCROLL:
+            {
+                InputEvent new_event;
+
+                if (!read(&new_event.x, sizeof(new_event.x) ) ||
+                    !read(&new_event.y, sizeof(new_event.y) ))
+                {
+                    goto end;
+                }
+
+                new_event.time = std::chrono::steady_clock::now();
+                new_event.type = (static_cast<InputRecordType>(type) == InputRecordType::MOUSE_BUTTON) ? InputEventType::MOUSE_BUTTON
+                               : (static_cast<InputRecordType>(type) == InputRecordType::MOUSE_POS)    ? InputEventType::MOUSE_POS
+                                                                                                       : InputEventType::SCROLL;
+
+                if (new_event.type == InputEventType::MOUSE_BUTTON)
+                {
+                    uint8_t is_pressed   = 0;
+                    uint8_t mouse_button = 0;
+
+                    if (!read(&mouse_button, sizeof(mouse_button) ) ||
+                        !read(&is_pressed,   sizeof(is_pressed) ))
+                    {
+                        goto end;
+                    }
+
+                    new_event.is_pressed   = (is_pressed != 0);
+                    new_event.mouse_button = static_cast<MouseButton>(mouse_button);
+                }
+
+                in_input_event_queue_ptr->push(new_event);
+
+                break;
+            }
+
+            default:
+            {
+                goto end;
+            }
+        }
+    }
+
+    if (m_framebuffer_width  > 0 &&
+        m_framebuffer_height > 0)
+    {
+        *inout_framebuffer_height_ptr = m_framebuffer_height;
+        *inout_framebuffer_width_ptr  = m_framebuffer_width;
+    }
+
+    result = true;
+end:
+    if (!result)
+    {
+        Framework::report_error("Input recording [%s] is malformed.",
+                                m_filename);
+    }
+
+    return result;
+}
+
+bool Framework::InputPlayer::read(void*         out_data_ptr,
+                                  const size_t& in_size)
+{
+    bool result = false;
+
+    if (m_read_offset + in_size > m_data_u8_vec.size() )
+    {
+        goto end;
+    }
+
+    if (in_size > 0)
+    {
+        memcpy(out_data_ptr,
+               m_data_u8_vec.data() + m_read_offset,
+               in_size);
+    }
+
+    m_read_offset += in_size;
+    result         = true;
+end:
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "input_recorder.h"
+
+Framework::InputRecorder::InputRecorder(const std::string& in_filename)
+    :m_file_ptr               (nullptr),
+     m_last_framebuffer_height(-1),
+     m_last_framebuffer_width (-1),
+     m_n_last_frame           (0),
+     m_filename               (in_filename)
+{
+    /* Stub */
+}
+
+Framework::InputRecorder::~InputRecorder()
+{
+    if (m_file_ptr != nullptr)
+    {
+        write_header(InputRecordType::END_OF_STREAM,
+                     m_n_last_frame + 1);
+
+        ::fclose(m_file_ptr);
+    }
+}
+
+Framework::InputRecorderUniquePtr Framework::InputRecorder::create(const std::string& in_filename)
+{
+    InputRecorderUniquePtr result_ptr(
+        new InputRecorder(in_filename)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+bool Framework::InputRecorder::init()
+{
+    bool result = false;
+
+    m_file_ptr = ::fopen(m_filename.c_str(),
+                         "wb");
+
+    if (m_file_ptr == nullptr)
+    {
+        Framework::report_error("Could not open [%s] for writing.",
+                                m_filename);
+
+        goto end;
+    }
+
+    write(&INPUT_RECORDING_MAGIC,
+          sizeof(INPUT_RECORDING_MAGIC) );
+    write(&INPUT_RECORDING_VERSION,
+          sizeof(INPUT_RECORDING_VERSION) );
+
+    result = true;
+end:
+    return result;
+}
+
+void Framework::InputRecorder::record_file_drop(const uint32_t&             in_n_frame,
+                                                const std::string&          in_filename,
+                                                const std::vector<uint8_t>& in_data_u8_vec)
+{
+    const uint32_t data_size     = static_cast<uint32_t>(in_data_u8_vec.size() );
+    const uint32_t filename_size = static_cast<uint32_t>(in_filename.size   () );
+
+    write_header(InputRecordType::FILE_DROP,
+                 in_n_frame);
+
+    write(&filename_size,
+          sizeof(filename_size) );
+    write(in_filename.data(),
+          filename_size);
+    write(&data_size,
+          sizeof(data_size) );
+    write(in_data_u8_vec.data(),
+          data_size);
+}
+
+void Framework::InputRecorder::record_framebuffer_size(const uint32_t& in_n_frame,
+                                                       const int&      in_width,
+                                                       const int&      in_height)
+{
+    if (in_width  != m_last_framebuffer_width  ||
+        in_height != m_last_framebuffer_height)
+    {
+        const int32_t height = static_cast<int32_t>(in_height);
+        const int32_t width  = static_cast<int32_t>(in_width);
+
+        write_header(InputRecordType::FRAMEBUFFER_SIZE,
+                     in_n_frame);
+
+        write(&width,
+              sizeof(width) );
+        write(&height,
+              sizeof(height) );
+
+        m_last_framebuffer_height = in_height;
+        m_last_framebuffer_width  = in_width;
+    }
+
+    m_n_last_frame = in_n_frame;
+}
+
+void Framework::InputRecorder::record_input_event(const uint32_t&   in_n_frame,
+                                                  const InputEvent& in_event)
+{
+    switch (in_event.type)
+    {
+        case InputEventType::CHAR:
+        {
+            write_header(InputRecordType::CHAR,
+                         in_n_frame);
+
+            write(&in_event.codepoint,
+                  sizeof(in_event.codepoint) );
+
+            break;
+        }
+
+        case InputEventType::KEY:
+        {
+            const int32_t action = static_cast<int32_t>(in_event.key_action);
+            const int32_t key    = static_cast<int32_t>(in_event.key);
+            const int32_t mods   = static_cast<int32_t>(in_event.key_mods);
+
+            write_header(InputRecordType::KEY,
+                         in_n_frame);
+
+            write(&key,
+                  sizeof(key) );
+            write(&action,
+                  sizeof(action) );
+            write(&mods,
+                  sizeof(mods) );
+
+            break;
+        }
+
+        case InputEventType::MOUSE_BUTTON:
+        {
+            const uint8_t is_pressed   = (in_event.is_pressed) ? 1 : 0;
+            const uint8_t mouse_button = static_cast<uint8_t>(in_event.mouse_button);
+
+            write_header(InputRecordType::MOUSE_BUTTON,
+                         in_n_frame);
+
+            write(&in_event.x,
+                  sizeof(in_event.x) );
+            write(&in_event.y,
+                  sizeof(in_event.y) );
+            write(&mouse_button,
+                  sizeof(mouse_button) );
+            write(&is_pressed,
+                  sizeof(is_pressed) );
+
+            break;
+        }
+
+        case InputEventType::MOUSE_POS:
+        case InputEventType::SCROLL:
+        {
+            write_header( (in_event.type == InputEventType::MOUSE_POS) ? InputRecordType::MOUSE_POS
+                                                                       : InputRecordType::SCROLL,
+                         in_n_frame);
+
+            write(&in_event.x,
+                  sizeof(in_event.x) );
+            write(&in_event.y,
+                  sizeof(in_event.y) );
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+void Framework::InputRecorder::write(const void*   in_data_ptr,
+                                     const size_t& in_size)
+{
+    if (in_size == 0)
+    {
+        goto end;
+    }
+
+    if (::fwrite(in_data_ptr,
+                 in_size,
+                 1, /* count */
+                 m_file_ptr) != 1)
+    {
+        Framework::report_error("Failed to write to input recording [%s].",
+                                m_filename);
+    }
+
+end:
+    ;
+}
+
+void Framework::InputRecorder::write_header(const InputRecordType& in_type,
+                                            const uint32_t&        in_n_frame)
+{
+    const uint8_t type = static_cast<uint8_t>(in_type);
+
+    write(&type,
+          sizeof(type) );
+    write(&in_n_frame,
+          sizeof(in_n_frame) );
+}
\ No newline at end of file
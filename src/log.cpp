@@ -0,0 +1,723 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "log.h"
+#include "trace.h"
+#include "imgui.h"
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+    /* Cell of a bounded MPSC ring, based on Dmitry Vyukov's bounded MPMC queue.
+     *
+     * The sequence is stored relative to the cell's index, so that zero-initialized cells are valid. A cell is free
+     * to be written at enqueue position P if its sequence equals P, and holds a record which can be consumed at
+     * dequeue position P if its sequence equals P + 1. */
+    struct LogRingCell
+    {
+        Framework::LogRecord  record;
+        std::atomic<uint64_t> relative_sequence;
+    };
+}
+
+static const uint32_t N_HISTORY_RECORDS = 4096;
+static const uint32_t N_RING_CELLS      = 1024; /* Must be a power of two. */
+
+static uint64_t                           g_dequeue_position          = 0; /* Guarded by g_history_mutex */
+static std::atomic<uint64_t>              g_enqueue_position          (0);
+static std::atomic<bool>                  g_has_reported_error        (false);
+static std::mutex                         g_history_mutex;
+static std::vector<Framework::LogRecord>  g_history_record_vec;            /* Guarded by g_history_mutex */
+static bool                               g_is_severity_shown[static_cast<uint32_t>(Framework::LogSeverity::COUNT)] = {true, true, true, true};
+static std::atomic<bool>                  g_is_reported_error_claimed (false);
+static std::atomic<uint32_t>              g_n_dropped_records         (0);
+static uint64_t                           g_n_history_records_written = 0; /* Guarded by g_history_mutex */
+static std::string                        g_reported_error_heap_string_data; /* Only written by the thread which latched the error. */
+static Framework::LogRecord               g_reported_error_record;         /* Immutable once g_has_reported_error is set. */
+static LogRingCell                        g_ring_cells[N_RING_CELLS];
+static std::vector<uint32_t>              g_shown_record_index_vec;        /* Only used by draw_log_window() */
+
+static void append_text(const char*   in_text_ptr,
+                        const size_t& in_n_text_chars,
+                        const size_t& in_n_max_chars,
+                        char*         out_text_ptr,
+                        size_t*       inout_n_chars_ptr)
+{
+    if (*inout_n_chars_ptr + 1 < in_n_max_chars)
+    {
+        memcpy(out_text_ptr + *inout_n_chars_ptr,
+               in_text_ptr,
+               std::min(in_n_text_chars,
+                        in_n_max_chars - *inout_n_chars_ptr - 1) );
+    }
+
+    *inout_n_chars_ptr += in_n_text_chars;
+}
+
+static size_t format_log_line(const Framework::LogRecord& in_record,
+                              const size_t&               in_n_max_chars,
+                              char*                       out_text_ptr)
+{
+    int n_prefix_chars = snprintf(out_text_ptr,
+                                  in_n_max_chars,
+                                  "[%10.3f] [%s] [%s] [thread %u] ",
+                                  static_cast<double>(in_record.time_ns) / 1e9,
+                                  Framework::get_log_severity_name(in_record.severity),
+                                  in_record.source_ptr,
+                                  in_record.thread_index);
+
+    n_prefix_chars = std::max(0,
+                              std::min(n_prefix_chars,
+                                       static_cast<int>(in_n_max_chars) - 1) );
+
+    return static_cast<size_t>(n_prefix_chars) + Framework::format_log_record(in_record,
+                                                                             in_n_max_chars - static_cast<size_t>(n_prefix_chars),
+                                                                             out_text_ptr   + n_prefix_chars);
+}
+
+static ImVec4 get_log_severity_color(const Framework::LogSeverity& in_severity)
+{
+    switch (in_severity)
+    {
+        case Framework::LogSeverity::DEBUG:   return ImVec4{0.6f, 0.6f, 0.6f, 1.0f};
+        case Framework::LogSeverity::WARNING: return ImVec4{1.0f, 0.8f, 0.3f, 1.0f};
+        case Framework::LogSeverity::ERROR:   return ImVec4{1.0f, 0.3f, 0.3f, 1.0f};
+
+        default:
+        {
+            return ImVec4{1.0f, 1.0f, 1.0f, 1.0f};
+        }
+    }
+}
+
+void Framework::add_log_argument(LogRecord*  inout_record_ptr,
+                                 const char* in_value_ptr)
+{
+    if (inout_record_ptr->n_arguments < LogRecord::MAX_ARGUMENTS)
+    {
+        auto&     argument     = inout_record_ptr->arguments[inout_record_ptr->n_arguments++];
+        uint32_t& n_bytes_used = inout_record_ptr->n_string_data_bytes_used;
+
+        const size_t n_value_bytes = strlen(in_value_ptr);
+
+        argument.type = LogArgumentType::STRING;
+
+        if (inout_record_ptr->heap_string_data_ptr != nullptr &&
+            n_bytes_used + n_value_bytes + 1 > LogRecord::MAX_STRING_DATA)
+        {
+            auto& heap_string_data = *inout_record_ptr->heap_string_data_ptr;
+
+            argument.string_offset = static_cast<uint32_t>(heap_string_data.size() );
+            argument.type          = LogArgumentType::HEAP_STRING;
+
+            heap_string_data.append(in_value_ptr,
+                                    n_value_bytes + 1);
+        }
+        else
+        if (n_bytes_used < LogRecord::MAX_STRING_DATA)
+        {
+            const size_t n_copied_bytes = std::min(n_value_bytes,
+                                                   static_cast<size_t>(LogRecord::MAX_STRING_DATA - n_bytes_used - 1) );
+
+            memcpy(inout_record_ptr->string_data + n_bytes_used,
+                   in_value_ptr,
+                   n_copied_bytes);
+
+            inout_record_ptr->string_data[n_bytes_used + n_copied_bytes] = 0;
+
+            argument.string_offset = n_bytes_used;
+            n_bytes_used          += static_cast<uint32_t>(n_copied_bytes) + 1;
+        }
+        else
+        {
+            /* Out of space. The last byte always terminates the most recently copied string, so use it as an empty one. */
+            argument.string_offset = LogRecord::MAX_STRING_DATA - 1;
+        }
+    }
+}
+
+void Framework::add_log_argument(LogRecord*         inout_record_ptr,
+                                 const std::string& in_value)
+{
+    add_log_argument(inout_record_ptr,
+                     in_value.c_str() );
+}
+
+void Framework::add_log_argument(LogRecord*    inout_record_ptr,
+                                 const double& in_value)
+{
+    if (inout_record_ptr->n_arguments < LogRecord::MAX_ARGUMENTS)
+    {
+        auto& argument = inout_record_ptr->arguments[inout_record_ptr->n_arguments++];
+
+        argument.double_value = in_value;
+        argument.type         = LogArgumentType::DOUBLE;
+    }
+}
+
+void Framework::begin_log_record(LogRecord*         out_record_ptr,
+                                 const LogSeverity& in_severity,
+                                 const char*        in_source_ptr,
+                                 const char*        in_format_ptr)
+{
+    out_record_ptr->format_ptr               = in_format_ptr;
+    out_record_ptr->heap_string_data_ptr     = nullptr;
+    out_record_ptr->n_arguments              = 0;
+    out_record_ptr->n_string_data_bytes_used = 0;
+    out_record_ptr->severity                 = in_severity;
+    out_record_ptr->source_ptr               = in_source_ptr;
+    out_record_ptr->thread_index             = Framework::get_trace_thread_index();
+    out_record_ptr->time_ns                  = Framework::get_trace_time_ns     ();
+}
+
+void Framework::drain_log()
+{
+    std::lock_guard<std::mutex> lock(g_history_mutex);
+
+    if (g_history_record_vec.empty() )
+    {
+        g_history_record_vec.resize(N_HISTORY_RECORDS);
+    }
+
+    while (true)
+    {
+        const uint32_t n_cell = static_cast<uint32_t>(g_dequeue_position & (N_RING_CELLS - 1) );
+        auto&          cell   = g_ring_cells[n_cell];
+
+        if (cell.relative_sequence.load(std::memory_order_acquire) + n_cell != g_dequeue_position + 1)
+        {
+            /* Ring is empty, or the next record is still being written. */
+            break;
+        }
+
+        auto& record = g_history_record_vec.at(g_n_history_records_written % N_HISTORY_RECORDS);
+
+        record = cell.record;
+
+        cell.relative_sequence.store(g_dequeue_position + N_RING_CELLS - n_cell,
+                                     std::memory_order_release);
+
+        g_dequeue_position++;
+        g_n_history_records_written++;
+
+        if (record.severity >= LogSeverity::WARNING)
+        {
+            char line[1024];
+
+            format_log_line(record,
+                            sizeof(line),
+                            line);
+
+            fprintf(stderr,
+                    "%s\n",
+                    line);
+        }
+    }
+}
+
+void Framework::draw_log_window(bool* inout_opt_is_open_ptr)
+{
+    Framework::drain_log();
+
+    if (ImGui::Begin("Log",
+                     inout_opt_is_open_ptr) )
+    {
+        const uint32_t n_dropped_records = g_n_dropped_records.load(std::memory_order_relaxed);
+
+        for (uint32_t n_severity = 0;
+                      n_severity < static_cast<uint32_t>(LogSeverity::COUNT);
+                    ++n_severity)
+        {
+            if (n_severity > 0)
+            {
+                ImGui::SameLine();
+            }
+
+            ImGui::Checkbox(get_log_severity_name(static_cast<LogSeverity>(n_severity) ),
+                            g_is_severity_shown + n_severity);
+        }
+
+        #if !defined(__EMSCRIPTEN__)
+        {
+            ImGui::SameLine();
+
+            if (ImGui::Button("Save to log.txt") )
+            {
+                Framework::save_log("log.txt");
+            }
+        }
+        #endif
+
+        if (n_dropped_records > 0)
+        {
+            ImGui::TextColored(get_log_severity_color(LogSeverity::WARNING),
+                               "%u record(s) dropped due to the log ring being full.",
+                               n_dropped_records);
+        }
+
+        ImGui::Separator();
+
+        if (ImGui::BeginChild("Records") )
+        {
+            std::lock_guard<std::mutex> lock(g_history_mutex);
+            const uint64_t              n_first_record = (g_n_history_records_written > N_HISTORY_RECORDS) ? g_n_history_records_written - N_HISTORY_RECORDS
+                                                                                                            : 0;
+            ImGuiListClipper            clipper;
+
+            g_shown_record_index_vec.clear();
+
+            for (uint64_t n_record = n_first_record;
+                          n_record < g_n_history_records_written;
+                        ++n_record)
+            {
+                const uint32_t n_history_record = static_cast<uint32_t>(n_record % N_HISTORY_RECORDS);
+
+                if (g_is_severity_shown[static_cast<uint32_t>(g_history_record_vec.at(n_history_record).severity)])
+                {
+                    g_shown_record_index_vec.push_back(n_history_record);
+                }
+            }
+
+            clipper.Begin(static_cast<int>(g_shown_record_index_vec.size() ) );
+
+            while (clipper.Step() )
+            {
+                for (int n_shown_record = clipper.DisplayStart;
+                         n_shown_record < clipper.DisplayEnd;
+                       ++n_shown_record)
+                {
+                    const auto& current_record = g_history_record_vec.at(g_shown_record_index_vec.at(n_shown_record) );
+                    char        line[1024];
+
+                    format_log_line(current_record,
+                                    sizeof(line),
+                                    line);
+
+                    ImGui::PushStyleColor (ImGuiCol_Text,
+                                           get_log_severity_color(current_record.severity) );
+                    ImGui::TextUnformatted(line);
+                    ImGui::PopStyleColor  ();
+                }
+            }
+
+            clipper.End();
+
+            /* Keep following new records, unless the user has scrolled up. */
+            if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY() )
+            {
+                ImGui::SetScrollHereY(1.0f);
+            }
+        }
+
+        ImGui::EndChild();
+    }
+
+    ImGui::End();
+}
+
+size_t Framework::format_log_record(const LogRecord& in_record,
+                                    const size_t&    in_n_max_chars,
+                                    char*            out_text_ptr)
+{
+    const char* format_ptr = in_record.format_ptr;
+    uint32_t    n_argument = 0;
+    size_t      result     = 0;
+
+    while (*format_ptr != 0)
+    {
+        if (format_ptr[0] != '%' ||
+            format_ptr[1] == '%')
+        {
+            const char* text_end_ptr = (format_ptr[0] == '%') ? format_ptr + 1
+                                                              : strchr(format_ptr, '%');
+
+            if (text_end_ptr == nullptr)
+            {
+                text_end_ptr = format_ptr + strlen(format_ptr);
+            }
+
+            append_text(format_ptr,
+                        static_cast<size_t>(text_end_ptr - format_ptr),
+                        in_n_max_chars,
+                        out_text_ptr,
+                       &result);
+
+            format_ptr = (format_ptr[0] == '%') ? format_ptr + 2
+                                                : text_end_ptr;
+
+            continue;
+        }
+
+        /* Parse the conversion specification. Flags, width & precision are kept, length modifiers are replaced with ones
+         * matching the argument's type. */
+        {
+            const char* spec_start_ptr      = format_ptr++;
+            const char* argument_string_ptr = nullptr;
+            char        argument_text[256];
+            int         n_argument_chars = 0;
+            char        spec[32];
+            size_t      spec_length      = 0;
+
+            while (*format_ptr != 0 && strchr("-+ #0123456789.", *format_ptr) != nullptr)
+            {
+                format_ptr++;
+            }
+
+            spec_length = std::min(static_cast<size_t>(format_ptr - spec_start_ptr),
+                                   sizeof(spec) - 8);
+
+            memcpy(spec,
+                   spec_start_ptr,
+                   spec_length);
+
+            while (*format_ptr != 0 && strchr("hlLqjzt", *format_ptr) != nullptr)
+            {
+                format_ptr++;
+            }
+
+            if (*format_ptr == 0)
+            {
+                break;
+            }
+
+            if (n_argument >= in_record.n_arguments)
+            {
+                n_argument_chars = snprintf(argument_text,
+                                            sizeof(argument_text),
+                                            "<missing>");
+            }
+            else
+            {
+                const auto& argument            = in_record.arguments[n_argument++];
+                const char  conversion          = *format_ptr;
+                const bool  is_float_conversion = (strchr("aAeEfFgG", conversion) != nullptr);
+                const bool  is_uint_conversion  = (strchr("oxXu",     conversion) != nullptr);
+
+                switch (argument.type)
+                {
+                    case LogArgumentType::DOUBLE:
+                    {
+                        snprintf(spec + spec_length,
+                                 sizeof(spec) - spec_length,
+                                 "%c",
+                                 is_float_conversion ? conversion : 'g');
+
+                        n_argument_chars = snprintf(argument_text,
+                                                    sizeof(argument_text),
+                                                    spec,
+                                                    argument.double_value);
+
+                        break;
+                    }
+
+                    case LogArgumentType::INT:
+                    case LogArgumentType::UINT:
+                    {
+                        const bool is_signed = (argument.type == LogArgumentType::INT);
+
+                        if (conversion == 'c')
+                        {
+                            snprintf(spec + spec_length,
+                                     sizeof(spec) - spec_length,
+                                     "c");
+
+                            n_argument_chars = snprintf(argument_text,
+                                                        sizeof(argument_text),
+                                                        spec,
+                                                        is_signed ? static_cast<int>(argument.int_value)
+                                                                  : static_cast<int>(argument.uint_value) );
+                        }
+                        else
+                        if (is_uint_conversion || !is_signed)
+                        {
+                            snprintf(spec + spec_length,
+                                     sizeof(spec) - spec_length,
+                                     "ll%c",
+                                     is_uint_conversion ? conversion : 'u');
+
+                            n_argument_chars = snprintf(argument_text,
+                                                        sizeof(argument_text),
+                                                        spec,
+                                                        is_signed ? static_cast<unsigned long long>(argument.int_value)
+                                                                  : static_cast<unsigned long long>(argument.uint_value) );
+                        }
+                        else
+                        {
+                            snprintf(spec + spec_length,
+                                     sizeof(spec) - spec_length,
+                                     "lld");
+
+                            n_argument_chars = snprintf(argument_text,
+                                                        sizeof(argument_text),
+                                                        spec,
+                                                        static_cast<long long>(argument.int_value) );
+                        }
+
+                        break;
+                    }
+
+                    case LogArgumentType::HEAP_STRING:
+                    case LogArgumentType::STRING:
+                    {
+                        const char* string_ptr = (argument.type == LogArgumentType::HEAP_STRING) ? in_record.heap_string_data_ptr->c_str() + argument.string_offset
+                                                                                                 : in_record.string_data                    + argument.string_offset;
+
+                        if (spec_length == 1)
+                        {
+                            /* Plain %s. Append the string directly, so that it is not limited by the size of argument_text. */
+                            argument_string_ptr = string_ptr;
+                            n_argument_chars    = static_cast<int>(strlen(string_ptr) );
+
+                            break;
+                        }
+
+                        snprintf(spec + spec_length,
+                                 sizeof(spec) - spec_length,
+                                 "s");
+
+                        n_argument_chars = snprintf(argument_text,
+                                                    sizeof(argument_text),
+                                                    spec,
+                                                    string_ptr);
+
+                        break;
+                    }
+                }
+            }
+
+            if (argument_string_ptr != nullptr)
+            {
+                append_text(argument_string_ptr,
+                            static_cast<size_t>(n_argument_chars),
+                            in_n_max_chars,
+                            out_text_ptr,
+                           &result);
+            }
+            else
+            {
+                append_text(argument_text,
+                            std::min(static_cast<size_t>(std::max(n_argument_chars, 0) ),
+                                     sizeof(argument_text) - 1),
+                            in_n_max_chars,
+                            out_text_ptr,
+                           &result);
+            }
+
+            format_ptr++;
+        }
+    }
+
+    if (in_n_max_chars > 0)
+    {
+        out_text_ptr[std::min(result, in_n_max_chars - 1)] = 0;
+    }
+
+    return result;
+}
+
+const char* Framework::get_log_severity_name(const LogSeverity& in_severity)
+{
+    switch (in_severity)
+    {
+        case LogSeverity::DEBUG:   return "Debug";
+        case LogSeverity::ERROR:   return "Error";
+        case LogSeverity::INFO:    return "Info";
+        case LogSeverity::WARNING: return "Warning";
+
+        default:
+        {
+            assert(false);
+        }
+    }
+
+    return "?";
+}
+
+uint32_t Framework::get_n_dropped_log_records()
+{
+    return g_n_dropped_records.load(std::memory_order_relaxed);
+}
+
+std::string Framework::get_reported_error()
+{
+    std::string result;
+
+    if (has_reported_error() )
+    {
+        result.resize(format_log_record(g_reported_error_record,
+                                        0,        /* in_n_max_chars */
+                                        nullptr) /* out_text_ptr   */
+                      + 1);
+
+        format_log_record(g_reported_error_record,
+                          result.size(),
+                         &result[0]);
+
+        result.pop_back();
+    }
+
+    return result;
+}
+
+bool Framework::latch_log_record(LogRecord* inout_record_ptr)
+{
+    bool is_claimed = false;
+    bool result     = false;
+
+    if (g_is_reported_error_claimed.compare_exchange_strong(is_claimed,
+                                                            true) )
+    {
+        inout_record_ptr->heap_string_data_ptr = &g_reported_error_heap_string_data;
+
+        result = true;
+    }
+
+    return result;
+}
+
+bool Framework::has_reported_error()
+{
+    return g_has_reported_error.load(std::memory_order_acquire);
+}
+
+void Framework::push_log_record(const LogRecord& in_record,
+                                const bool&      in_is_latched_error)
+{
+    uint64_t position = g_enqueue_position.load(std::memory_order_relaxed);
+
+    if (in_is_latched_error)
+    {
+        g_reported_error_record = in_record;
+
+        g_has_reported_error.store(true,
+                                   std::memory_order_release);
+    }
+
+    while (true)
+    {
+        const uint32_t n_cell   = static_cast<uint32_t>(position & (N_RING_CELLS - 1) );
+        auto&          cell     = g_ring_cells[n_cell];
+        const int64_t  distance = static_cast<int64_t>(cell.relative_sequence.load(std::memory_order_acquire) + n_cell - position);
+
+        if (distance == 0)
+        {
+            if (g_enqueue_position.compare_exchange_weak(position,
+                                                         position + 1,
+                                                         std::memory_order_relaxed) )
+            {
+                cell.record = in_record;
+
+                cell.relative_sequence.store(position + 1 - n_cell,
+                                             std::memory_order_release);
+
+                break;
+            }
+        }
+        else
+        if (distance < 0)
+        {
+            /* The ring is full. Drop the record rather than wait for the consumer. */
+            g_n_dropped_records.fetch_add(1,
+                                          std::memory_order_relaxed);
+
+            break;
+        }
+        else
+        {
+            position = g_enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Framework::log_message(const LogSeverity& in_severity,
+                            const char*        in_source_ptr,
+                            const char*        in_message_ptr)
+{
+    Framework::log_message(in_severity,
+                           in_source_ptr,
+                           "%s",
+                           in_message_ptr);
+}
+
+void Framework::report_error(const char* in_error_ptr)
+{
+    Framework::report_error("%s",
+                            in_error_ptr);
+}
+
+void Framework::report_error(const std::string& in_error)
+{
+    Framework::report_error("%s",
+                            in_error);
+}
+
+bool Framework::save_log(const std::string& in_filename)
+{
+    FILE* file_ptr = nullptr;
+    bool  result   = false;
+
+    Framework::drain_log();
+
+    file_ptr = fopen(in_filename.c_str(),
+                     "w");
+
+    if (file_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_history_mutex);
+        const uint64_t              n_first_record = (g_n_history_records_written > N_HISTORY_RECORDS) ? g_n_history_records_written - N_HISTORY_RECORDS
+                                                                                                        : 0;
+
+        for (uint64_t n_record = n_first_record;
+                      n_record < g_n_history_records_written;
+                    ++n_record)
+        {
+            char line[1024];
+
+            format_log_line(g_history_record_vec.at(n_record % N_HISTORY_RECORDS),
+                            sizeof(line),
+                            line);
+
+            fprintf(file_ptr,
+                    "%s\n",
+                    line);
+        }
+    }
+
+    fclose(file_ptr);
+
+    result = true;
+end:
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "occlusion_query_pool.h"
+#include <assert.h>
+
+Framework::OcclusionQueryPool::OcclusionQueryPool(const uint32_t& in_n_objects,
+                                                  const uint32_t& in_n_queries_per_object)
+    :m_n_active_object     (UINT32_MAX),
+     m_n_current_frame     (0),
+     m_n_objects           (in_n_objects),
+     m_n_queries_per_object(in_n_queries_per_object)
+{
+    assert(in_n_objects            > 0);
+    assert(in_n_queries_per_object > 0);
+}
+
+Framework::OcclusionQueryPool::~OcclusionQueryPool()
+{
+    if (m_query_id_vec.size() > 0)
+    {
+        glDeleteQueries(static_cast<GLsizei>(m_query_id_vec.size() ),
+                        m_query_id_vec.data() );
+    }
+}
+
+bool Framework::OcclusionQueryPool::begin_query(const uint32_t& in_n_object)
+{
+    bool result = false;
+
+    if (in_n_object >= m_n_objects)
+    {
+        Framework::report_error("Invalid object index specified for Framework::OcclusionQueryPool::begin_query()");
+
+        goto end;
+    }
+
+    if (m_n_active_object != UINT32_MAX)
+    {
+        Framework::report_error("Framework::OcclusionQueryPool::begin_query() called while another query is active.");
+
+        goto end;
+    }
+
+    {
+        auto& ring = m_object_ring_vec.at(in_n_object);
+
+        if (ring.n_pending_queries == m_n_queries_per_object)
+        {
+            /* All queries for this object are still in flight. Rather than waiting for the oldest one to
+             * complete, skip the query for this frame. */
+            goto end;
+        }
+
+        {
+            const uint32_t n_query = in_n_object * m_n_queries_per_object
+                                   + (ring.n_oldest_query + ring.n_pending_queries) % m_n_queries_per_object;
+
+            glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE,
+                         m_query_id_vec.at(n_query) );
+
+            m_query_frame_vec.at(n_query) = m_n_current_frame;
+        }
+
+        ring.n_pending_queries++;
+    }
+
+    m_n_active_object = in_n_object;
+    result            = true;
+end:
+    return result;
+}
+
+Framework::OcclusionQueryPoolUniquePtr Framework::OcclusionQueryPool::create(const uint32_t& in_n_objects,
+                                                                             const uint32_t& in_n_queries_per_object)
+{
+    OcclusionQueryPoolUniquePtr result_ptr(
+        new OcclusionQueryPool(in_n_objects,
+                               in_n_queries_per_object)
+    );
+
+    if (!result_ptr->init() )
+    {
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+void Framework::OcclusionQueryPool::end_query()
+{
+    if (m_n_active_object == UINT32_MAX)
+    {
+        Framework::report_error("Framework::OcclusionQueryPool::end_query() called without a matching begin_query() call.");
+
+        goto end;
+    }
+
+    glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+
+    m_n_active_object = UINT32_MAX;
+end:
+    ;
+}
+
+uint32_t Framework::OcclusionQueryPool::get_result_age(const uint32_t& in_n_object) const
+{
+    uint32_t result = UINT32_MAX;
+
+    if (in_n_object < m_n_objects)
+    {
+        const auto& ring = m_object_ring_vec.at(in_n_object);
+
+        if (ring.n_frame_last_result_issued != UINT32_MAX)
+        {
+            result = m_n_current_frame - ring.n_frame_last_result_issued;
+        }
+    }
+    else
+    {
+        Framework::report_error("Invalid object index specified for Framework::OcclusionQueryPool::get_result_age()");
+    }
+
+    return result;
+}
+
+bool Framework::OcclusionQueryPool::init()
+{
+    bool result = false;
+
+    m_object_ring_vec.resize(m_n_objects);
+    m_query_frame_vec.resize(m_n_objects * m_n_queries_per_object,
+                             0);
+    m_query_id_vec.resize   (m_n_objects * m_n_queries_per_object,
+                             0);
+
+    glGenQueries(static_cast<GLsizei>(m_query_id_vec.size() ),
+                 m_query_id_vec.data() );
+
+    for (const auto& current_query_id : m_query_id_vec)
+    {
+        if (current_query_id == 0)
+        {
+            Framework::report_error("glGenQueries() returned a zeroed out ID.");
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+bool Framework::OcclusionQueryPool::is_visible(const uint32_t& in_n_object) const
+{
+    bool result = true;
+
+    if (in_n_object < m_n_objects)
+    {
+        result = m_object_ring_vec.at(in_n_object).visible;
+    }
+    else
+    {
+        Framework::report_error("Invalid object index specified for Framework::OcclusionQueryPool::is_visible()");
+    }
+
+    return result;
+}
+
+void Framework::OcclusionQueryPool::poll_results()
+{
+    if (m_n_active_object != UINT32_MAX)
+    {
+        Framework::report_error("Framework::OcclusionQueryPool::poll_results() called while a query is active.");
+
+        goto end;
+    }
+
+    m_n_current_frame++;
+
+    for (uint32_t n_object = 0;
+                  n_object < m_n_objects;
+                ++n_object)
+    {
+        auto& ring = m_object_ring_vec.at(n_object);
+
+        /* Queries complete in order they were issued in, so stop at the first one which is not ready yet. */
+        while (ring.n_pending_queries > 0)
+        {
+            const uint32_t n_query          = n_object * m_n_queries_per_object + ring.n_oldest_query;
+            const GLuint   query_id         = m_query_id_vec.at(n_query);
+            GLuint         result_available = GL_FALSE;
+            GLuint         samples_passed   = GL_TRUE;
+
+            glGetQueryObjectuiv(query_id,
+                                GL_QUERY_RESULT_AVAILABLE,
+                               &result_available);
+
+            if (result_available == GL_FALSE)
+            {
+                break;
+            }
+
+            glGetQueryObjectuiv(query_id,
+                                GL_QUERY_RESULT,
+                               &samples_passed);
+
+            ring.n_frame_last_result_issued = m_query_frame_vec.at(n_query);
+            ring.n_oldest_query             = (ring.n_oldest_query + 1) % m_n_queries_per_object;
+            ring.visible                    = (samples_passed != GL_FALSE);
+
+            ring.n_pending_queries--;
+        }
+    }
+
+end:
+    ;
+}
\ No newline at end of file
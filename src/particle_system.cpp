@@ -0,0 +1,430 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "particle_system.h"
+#include <algorithm>
+#include <assert.h>
+
+static const char* g_particle_render_fs_glsl =
+    "#version 300 es\n"
+    "\n"
+    "precision mediump float;\n"
+    "\n"
+    "in float fs_life_fraction;\n"
+    "\n"
+    "out vec4 out_color;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    vec2  coord  = gl_PointCoord * 2.0 - 1.0;\n"
+    "    float radius = dot(coord, coord);\n"
+    "\n"
+    "    if (radius > 1.0)\n"
+    "    {\n"
+    "        discard;\n"
+    "    }\n"
+    "\n"
+    "    out_color = vec4(mix(vec3(1.0, 0.8, 0.3), vec3(0.8, 0.2, 0.1), fs_life_fraction),\n"
+    "                     (1.0 - fs_life_fraction) * (1.0 - radius) );\n"
+    "}\n";
+
+static const char* g_particle_render_vs_glsl =
+    "#version 300 es\n"
+    "\n"
+    "layout(location = 0) in vec4 in_position_age;\n"
+    "layout(location = 1) in vec4 in_velocity_life;\n"
+    "\n"
+    "uniform mat4  u_view_projection;\n"
+    "uniform float u_point_size;\n"
+    "\n"
+    "out float fs_life_fraction;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    if (in_position_age.w >= in_velocity_life.w)\n"
+    "    {\n"
+    "        /* Dead particle - move it outside the clip volume. */\n"
+    "        fs_life_fraction = 1.0;\n"
+    "        gl_PointSize     = 1.0;\n"
+    "        gl_Position      = vec4(2.0, 2.0, 2.0, 1.0);\n"
+    "\n"
+    "        return;\n"
+    "    }\n"
+    "\n"
+    "    fs_life_fraction = in_position_age.w / in_velocity_life.w;\n"
+    "    gl_PointSize     = u_point_size;\n"
+    "    gl_Position      = u_view_projection * vec4(in_position_age.xyz, 1.0);\n"
+    "}\n";
+
+static const char* g_particle_update_fs_glsl =
+    "#version 300 es\n"
+    "\n"
+    "precision mediump float;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "}\n";
+
+static const char* g_particle_update_vs_glsl =
+    "#version 300 es\n"
+    "\n"
+    "layout(location = 0) in vec4 in_position_age;\n"
+    "layout(location = 1) in vec4 in_velocity_life;\n"
+    "\n"
+    "uniform float u_delta_time;\n"
+    "uniform uint  u_emit_count;\n"
+    "uniform uint  u_emit_start;\n"
+    "uniform float u_emitter_lifetime;\n"
+    "uniform vec3  u_emitter_position;\n"
+    "uniform vec3  u_emitter_velocity;\n"
+    "uniform float u_emitter_velocity_spread;\n"
+    "uniform vec3  u_gravity;\n"
+    "uniform uint  u_n_max_particles;\n"
+    "uniform uint  u_seed;\n"
+    "\n"
+    "out vec4 out_position_age;\n"
+    "out vec4 out_velocity_life;\n"
+    "\n"
+    "uint hash(uint x)\n"
+    "{\n"
+    "    x ^= x >> 16;\n"
+    "    x *= 0x7feb352du;\n"
+    "    x ^= x >> 15;\n"
+    "    x *= 0x846ca68bu;\n"
+    "    x ^= x >> 16;\n"
+    "\n"
+    "    return x;\n"
+    "}\n"
+    "\n"
+    "float rand(inout uint state)\n"
+    "{\n"
+    "    state = hash(state);\n"
+    "\n"
+    "    return float(state >> 8) * (1.0 / 16777216.0);\n"
+    "}\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    uint n_particle            = uint(gl_VertexID);\n"
+    "    uint n_particle_rel_cursor = (n_particle + u_n_max_particles - u_emit_start) % u_n_max_particles;\n"
+    "\n"
+    "    if (n_particle_rel_cursor < u_emit_count)\n"
+    "    {\n"
+    "        uint state     = hash(n_particle ^ hash(u_seed) );\n"
+    "        vec3 direction = vec3(rand(state), rand(state), rand(state) ) * 2.0 - 1.0;\n"
+    "\n"
+    "        out_position_age  = vec4(u_emitter_position, 0.0);\n"
+    "        out_velocity_life = vec4(u_emitter_velocity + direction * u_emitter_velocity_spread,\n"
+    "                                 u_emitter_lifetime);\n"
+    "    }\n"
+    "    else\n"
+    "    if (in_position_age.w >= in_velocity_life.w)\n"
+    "    {\n"
+    "        out_position_age  = in_position_age;\n"
+    "        out_velocity_life = in_velocity_life;\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "        vec3 velocity = in_velocity_life.xyz + u_gravity * u_delta_time;\n"
+    "\n"
+    "        out_position_age  = vec4(in_position_age.xyz + velocity * u_delta_time,\n"
+    "                                 in_position_age.w   + u_delta_time);\n"
+    "        out_velocity_life = vec4(velocity,\n"
+    "                                 in_velocity_life.w);\n"
+    "    }\n"
+    "}\n";
+
+
+Framework::ParticleSystem::ParticleSystem(const uint32_t& in_n_max_particles,
+                                          const Program*  in_opt_render_program_ptr)
+    :m_buffer_ids             ({0, 0}),
+     m_tf_ids                 ({0, 0}),
+     m_vao_ids                ({0, 0}),
+     m_emitter_position       ({0.0f, 0.0f, 0.0f}),
+     m_emitter_velocity       ({0.0f, 1.0f, 0.0f}),
+     m_emitter_lifetime       (1.0f),
+     m_emitter_velocity_spread(0.5f),
+     m_gravity                ({0.0f, -9.81f, 0.0f}),
+     m_gpu_memory_id          (0),
+     m_n_current_buffer       (0),
+     m_n_emit_cursor          (0),
+     m_n_updates              (0),
+     m_n_max_particles        (in_n_max_particles),
+     m_render_program_ptr     (in_opt_render_program_ptr)
+{
+    assert(in_n_max_particles > 0);
+}
+
+Framework::ParticleSystem::~ParticleSystem()
+{
+    Framework::unregister_gpu_memory(m_gpu_memory_id);
+
+    glDeleteVertexArrays      (static_cast<GLsizei>(m_vao_ids.size() ),
+                               m_vao_ids.data() );
+    glDeleteTransformFeedbacks(static_cast<GLsizei>(m_tf_ids.size() ),
+                               m_tf_ids.data() );
+    glDeleteBuffers           (static_cast<GLsizei>(m_buffer_ids.size() ),
+                               m_buffer_ids.data() );
+}
+
+Framework::ParticleSystemUniquePtr Framework::ParticleSystem::create(const uint32_t& in_n_max_particles,
+                                                                     const Program*  in_opt_render_program_ptr)
+{
+    ParticleSystemUniquePtr result_ptr(
+        new ParticleSystem(in_n_max_particles,
+                           in_opt_render_program_ptr)
+    );
+
+    if (!result_ptr->init() )
+    {
+        Framework::report_error("Particle system initialization failed.");
+
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
+
+bool Framework::ParticleSystem::init()
+{
+    bool result = false;
+
+    /* Set up programs for both the update & the render stages. */
+    m_update_fs_ptr = Framework::Shader::create(Framework::ShaderStage::FRAGMENT,
+                                                g_particle_update_fs_glsl);
+    m_update_vs_ptr = Framework::Shader::create(Framework::ShaderStage::VERTEX,
+                                                g_particle_update_vs_glsl);
+
+    if (m_update_fs_ptr == nullptr ||
+        m_update_vs_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    m_update_program_ptr = Framework::Program::create(m_update_vs_ptr.get(),
+                                                      m_update_fs_ptr.get(),
+                                                      {"out_position_age", "out_velocity_life"},
+                                                      GL_INTERLEAVED_ATTRIBS);
+
+    if (m_update_program_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (m_render_program_ptr == nullptr)
+    {
+        m_default_render_fs_ptr = Framework::Shader::create(Framework::ShaderStage::FRAGMENT,
+                                                            g_particle_render_fs_glsl);
+        m_default_render_vs_ptr = Framework::Shader::create(Framework::ShaderStage::VERTEX,
+                                                            g_particle_render_vs_glsl);
+
+        if (m_default_render_fs_ptr == nullptr ||
+            m_default_render_vs_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        m_default_render_program_ptr = Framework::Program::create(m_default_render_vs_ptr.get(),
+                                                                  m_default_render_fs_ptr.get() );
+
+        if (m_default_render_program_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        m_render_program_ptr = m_default_render_program_ptr.get();
+    }
+
+    m_render_uniform_locations.point_size      = m_render_program_ptr->get_uniform_location("u_point_size");
+    m_render_uniform_locations.view_projection = m_render_program_ptr->get_uniform_location("u_view_projection");
+
+    m_update_uniform_locations.delta_time              = m_update_program_ptr->get_uniform_location("u_delta_time");
+    m_update_uniform_locations.emit_count              = m_update_program_ptr->get_uniform_location("u_emit_count");
+    m_update_uniform_locations.emit_start              = m_update_program_ptr->get_uniform_location("u_emit_start");
+    m_update_uniform_locations.emitter_lifetime        = m_update_program_ptr->get_uniform_location("u_emitter_lifetime");
+    m_update_uniform_locations.emitter_position        = m_update_program_ptr->get_uniform_location("u_emitter_position");
+    m_update_uniform_locations.emitter_velocity        = m_update_program_ptr->get_uniform_location("u_emitter_velocity");
+    m_update_uniform_locations.emitter_velocity_spread = m_update_program_ptr->get_uniform_location("u_emitter_velocity_spread");
+    m_update_uniform_locations.gravity                 = m_update_program_ptr->get_uniform_location("u_gravity");
+    m_update_uniform_locations.n_max_particles         = m_update_program_ptr->get_uniform_location("u_n_max_particles");
+    m_update_uniform_locations.seed                    = m_update_program_ptr->get_uniform_location("u_seed");
+
+    /* Set up ping-pong buffers. All particles start dead (age == lifetime == 0). The same VAO is used to source
+     * data from a buffer, both when updating and when rendering particles. */
+    glGenBuffers           (static_cast<GLsizei>(m_buffer_ids.size() ),
+                            m_buffer_ids.data() );
+    glGenTransformFeedbacks(static_cast<GLsizei>(m_tf_ids.size() ),
+                            m_tf_ids.data() );
+    glGenVertexArrays      (static_cast<GLsizei>(m_vao_ids.size() ),
+                            m_vao_ids.data() );
+
+    {
+        const GLsizeiptr     buffer_size = static_cast<GLsizeiptr>(m_n_max_particles) * sizeof(float) * 8;
+        std::vector<uint8_t> zero_data_u8_vec(static_cast<size_t>(buffer_size),
+                                              0);
+
+        for (uint32_t n_buffer = 0;
+                      n_buffer < 2;
+                    ++n_buffer)
+        {
+            if (m_buffer_ids.at(n_buffer) == 0 ||
+                m_tf_ids.at    (n_buffer) == 0 ||
+                m_vao_ids.at   (n_buffer) == 0)
+            {
+                Framework::report_error("Failed to generate IDs for particle system objects.");
+
+                goto end;
+            }
+
+            glBindVertexArray(m_vao_ids.at   (n_buffer) );
+            glBindBuffer     (GL_ARRAY_BUFFER,
+                              m_buffer_ids.at(n_buffer) );
+            glBufferData     (GL_ARRAY_BUFFER,
+                              buffer_size,
+                              zero_data_u8_vec.data(),
+                              GL_DYNAMIC_COPY);
+
+            glEnableVertexAttribArray(0);
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer    (0,                               /* index      */
+                                      4,                               /* size       */
+                                      GL_FLOAT,
+                                      GL_FALSE,                        /* normalized */
+                                      sizeof(float) * 8,               /* stride     */
+                                      nullptr);                        /* pointer    */
+            glVertexAttribPointer    (1,                               /* index      */
+                                      4,                               /* size       */
+                                      GL_FLOAT,
+                                      GL_FALSE,                        /* normalized */
+                                      sizeof(float) * 8,               /* stride     */
+                                      reinterpret_cast<const void*>(sizeof(float) * 4) );
+
+            glBindTransformFeedback(GL_TRANSFORM_FEEDBACK,
+                                    m_tf_ids.at(n_buffer) );
+            glBindBufferBase       (GL_TRANSFORM_FEEDBACK_BUFFER,
+                                    0, /* index */
+                                    m_buffer_ids.at(n_buffer) );
+        }
+
+        /* WebGL2 disallows a buffer to be bound for transform feedback and to any other binding point at the same time,
+         * so make sure none of the buffers is left attached to a generic binding. */
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK,
+                                0);
+        glBindBuffer           (GL_TRANSFORM_FEEDBACK_BUFFER,
+                                0);
+        glBindBuffer           (GL_ARRAY_BUFFER,
+                                0);
+        glBindVertexArray      (0);
+
+        m_gpu_memory_id = Framework::register_gpu_memory(GPUMemoryType::BUFFER,
+                                                         "ParticleSystem",
+                                                         static_cast<uint64_t>(buffer_size) * m_buffer_ids.size() );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+void Framework::ParticleSystem::render(const std::array<float, 16>& in_view_projection_matrix,
+                                       const float&                 in_point_size)
+{
+    glUseProgram(m_render_program_ptr->get_id() );
+
+    glUniform1f       (m_render_uniform_locations.point_size,
+                       in_point_size);
+    glUniformMatrix4fv(m_render_uniform_locations.view_projection,
+                       1,        /* count     */
+                       GL_FALSE, /* transpose */
+                       in_view_projection_matrix.data() );
+
+    glBindVertexArray(m_vao_ids.at(m_n_current_buffer) );
+    glDrawArrays     (GL_POINTS,
+                      0, /* first */
+                      static_cast<GLsizei>(m_n_max_particles) );
+    glBindVertexArray(0);
+}
+
+void Framework::ParticleSystem::set_emitter(const std::array<float, 3>& in_position,
+                                            const std::array<float, 3>& in_velocity,
+                                            const float&                in_velocity_spread,
+                                            const float&                in_lifetime)
+{
+    m_emitter_lifetime        = in_lifetime;
+    m_emitter_position        = in_position;
+    m_emitter_velocity        = in_velocity;
+    m_emitter_velocity_spread = in_velocity_spread;
+}
+
+void Framework::ParticleSystem::set_gravity(const std::array<float, 3>& in_gravity)
+{
+    m_gravity = in_gravity;
+}
+
+void Framework::ParticleSystem::update(const float&    in_delta_time,
+                                       const uint32_t& in_n_particles_to_emit)
+{
+    const uint32_t n_dst_buffer = (m_n_current_buffer + 1) % 2;
+    const uint32_t n_emit_count = std::min(in_n_particles_to_emit,
+                                           m_n_max_particles);
+    const auto     program_ptr  = m_update_program_ptr.get();
+
+    glUseProgram(program_ptr->get_id() );
+
+    glUniform1f (m_update_uniform_locations.delta_time,              in_delta_time);
+    glUniform1ui(m_update_uniform_locations.emit_count,              n_emit_count);
+    glUniform1ui(m_update_uniform_locations.emit_start,              m_n_emit_cursor);
+    glUniform1f (m_update_uniform_locations.emitter_lifetime,        m_emitter_lifetime);
+    glUniform3fv(m_update_uniform_locations.emitter_position,        1, m_emitter_position.data() );
+    glUniform3fv(m_update_uniform_locations.emitter_velocity,        1, m_emitter_velocity.data() );
+    glUniform1f (m_update_uniform_locations.emitter_velocity_spread, m_emitter_velocity_spread);
+    glUniform3fv(m_update_uniform_locations.gravity,                 1, m_gravity.data() );
+    glUniform1ui(m_update_uniform_locations.n_max_particles,         m_n_max_particles);
+    glUniform1ui(m_update_uniform_locations.seed,                    m_n_updates);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    {
+        glBindVertexArray      (m_vao_ids.at(m_n_current_buffer) );
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK,
+                                m_tf_ids.at(n_dst_buffer) );
+
+        glBeginTransformFeedback(GL_POINTS);
+        {
+            glDrawArrays(GL_POINTS,
+                         0, /* first */
+                         static_cast<GLsizei>(m_n_max_particles) );
+        }
+        glEndTransformFeedback();
+
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK,
+                                0);
+        glBindVertexArray      (0);
+    }
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    m_n_current_buffer = n_dst_buffer;
+    m_n_emit_cursor    = (m_n_emit_cursor + n_emit_count) % m_n_max_particles;
+    m_n_updates++;
+}
\ No newline at end of file
@@ -24,13 +24,20 @@
 
 */
 #include "program.h"
+#include "gl_check.h"
+#include <algorithm>
 #include <assert.h>
-
-Framework::Program::Program(const Shader* in_vs_ptr,
-                            const Shader* in_fs_ptr)
-    :m_fs_ptr(in_fs_ptr),
-     m_id    (0),
-     m_vs_ptr(in_vs_ptr)
+#include <cstring>
+
+Framework::Program::Program(const Shader*                   in_vs_ptr,
+                            const Shader*                   in_fs_ptr,
+                            const std::vector<std::string>& in_tf_varyings,
+                            const GLenum&                   in_tf_buffer_mode)
+    :m_id            (0),
+     m_fs_ptr        (in_fs_ptr),
+     m_vs_ptr        (in_vs_ptr),
+     m_tf_buffer_mode(in_tf_buffer_mode),
+     m_tf_varyings   (in_tf_varyings)
 {
     assert(in_fs_ptr != nullptr);
     assert(in_vs_ptr != nullptr);
@@ -40,15 +47,28 @@ Framework::Program::~Program()
 {
     if (m_id != 0)
     {
-        glDeleteProgram(m_id);
+        FRAMEWORK_GL_CHECK(glDeleteProgram(m_id) );
     }
 }
 
 Framework::ProgramUniquePtr Framework::Program::create(const Shader* in_vs_ptr,
                                                        const Shader* in_fs_ptr)
+{
+    return create(in_vs_ptr,
+                  in_fs_ptr,
+                  std::vector<std::string>(),
+                  GL_INTERLEAVED_ATTRIBS);
+}
+
+Framework::ProgramUniquePtr Framework::Program::create(const Shader*                   in_vs_ptr,
+                                                       const Shader*                   in_fs_ptr,
+                                                       const std::vector<std::string>& in_tf_varyings,
+                                                       const GLenum&                   in_tf_buffer_mode)
 {
     ProgramUniquePtr result_ptr(new Program(in_vs_ptr,
-                                            in_fs_ptr) );
+                                            in_fs_ptr,
+                                            in_tf_varyings,
+                                            in_tf_buffer_mode) );
 
     if (!result_ptr->init() )
     {
@@ -63,11 +83,15 @@ GLint Framework::Program::get_uniform_location(const char* in_uniform_name_ptr)
     GLint result = -1;
 
     {
-        auto map_iterator = m_uniform_name_to_id_map.find(in_uniform_name_ptr);
+        const auto uniform_iterator = std::lower_bound(m_uniform_vec.begin(),
+                                                       m_uniform_vec.end  (),
+                                                       in_uniform_name_ptr,
+                                                       is_less);
 
-        if (map_iterator != m_uniform_name_to_id_map.end() )
+        if (uniform_iterator                                            != m_uniform_vec.end() &&
+            strcmp(uniform_iterator->name.c_str(), in_uniform_name_ptr) == 0)
         {
-            result = map_iterator->second;
+            result = uniform_iterator->location;
         }
     }
 
@@ -79,7 +103,7 @@ bool Framework::Program::init()
     bool result = false;
 
     /* Bake the program first. */
-    m_id = glCreateProgram();
+    m_id = FRAMEWORK_GL_CHECK(glCreateProgram() );
 
     if (m_id == 0)
     {
@@ -88,17 +112,33 @@ bool Framework::Program::init()
         goto end;
     }
 
-    glAttachShader(m_id, m_vs_ptr->get_id() );
-    glAttachShader(m_id, m_fs_ptr->get_id() );
+    FRAMEWORK_GL_CHECK(glAttachShader(m_id, m_vs_ptr->get_id() ) );
+    FRAMEWORK_GL_CHECK(glAttachShader(m_id, m_fs_ptr->get_id() ) );
 
-    glLinkProgram(m_id);
+    /* Transform feedback varyings need to be specified prior to linking. */
+    if (m_tf_varyings.size() > 0)
+    {
+        std::vector<const GLchar*> tf_varying_ptr_vec;
+
+        for (const auto& current_tf_varying : m_tf_varyings)
+        {
+            tf_varying_ptr_vec.push_back(current_tf_varying.c_str() );
+        }
+
+        FRAMEWORK_GL_CHECK(glTransformFeedbackVaryings(m_id,
+                                                       static_cast<GLsizei>(tf_varying_ptr_vec.size() ),
+                                                       tf_varying_ptr_vec.data(),
+                                                       m_tf_buffer_mode) );
+    }
+
+    FRAMEWORK_GL_CHECK(glLinkProgram(m_id) );
 
     {
         GLint link_status = 0;
 
-        glGetProgramiv(m_id,
-                      GL_LINK_STATUS,
-                     &link_status);
+        FRAMEWORK_GL_CHECK(glGetProgramiv(m_id,
+                                         GL_LINK_STATUS,
+                                        &link_status) );
 
         if (link_status != GL_TRUE)
         {
@@ -114,15 +154,15 @@ bool Framework::Program::init()
         GLint                uniform_name_max_length_incl_terminator = 0;
         std::vector<uint8_t> uniform_name_u8_vec;
 
-        glGetProgramiv(m_id,
-                       GL_ACTIVE_UNIFORMS,
-                      &n_active_uniforms);
+        FRAMEWORK_GL_CHECK(glGetProgramiv(m_id,
+                                          GL_ACTIVE_UNIFORMS,
+                                         &n_active_uniforms) );
 
         {
 
-            glGetProgramiv(m_id,
-                           GL_ACTIVE_UNIFORM_MAX_LENGTH,
-                          &uniform_name_max_length_incl_terminator);
+            FRAMEWORK_GL_CHECK(glGetProgramiv(m_id,
+                                              GL_ACTIVE_UNIFORM_MAX_LENGTH,
+                                             &uniform_name_max_length_incl_terminator) );
 
             uniform_name_u8_vec.resize(uniform_name_max_length_incl_terminator);
         }
@@ -139,40 +179,51 @@ bool Framework::Program::init()
                 GLint  uniform_size = 0;
                 GLenum uniform_type = GL_NONE;
 
-                glGetActiveUniform(m_id,
-                                   n_active_uniform,
-                                   uniform_name_max_length_incl_terminator,
-                                   nullptr, /* length */
-                                  &uniform_size,
-                                  &uniform_type,
-                                   reinterpret_cast<GLchar*>(uniform_name_u8_vec.data() ));
+                FRAMEWORK_GL_CHECK(glGetActiveUniform(m_id,
+                                                      n_active_uniform,
+                                                      uniform_name_max_length_incl_terminator,
+                                                      nullptr, /* length */
+                                                     &uniform_size,
+                                                     &uniform_type,
+                                                      reinterpret_cast<GLchar*>(uniform_name_u8_vec.data() )) );
             }
 
             if (uniform_name_u8_vec.size() > 0)
             {
                 const char* uniform_name_ptr = reinterpret_cast<GLchar*>(uniform_name_u8_vec.data() );
-                const auto  uniform_location = glGetUniformLocation     (m_id,
-                                                                         uniform_name_ptr);
+                const auto  uniform_location = FRAMEWORK_GL_CHECK(glGetUniformLocation(m_id,
+                                                                                       uniform_name_ptr) );
 
                 if (uniform_location == -1)
                 {
-                    Framework::report_error(std::string("Invalid uniform location reported for an active uniform [") + std::string(uniform_name_ptr) + "].");
+                    Framework::report_error("Invalid uniform location reported for an active uniform [%s].",
+                                            uniform_name_ptr);
 
                     goto end;
                 }
 
-                if (m_uniform_name_to_id_map.find(uniform_name_ptr) != m_uniform_name_to_id_map.end())
+                if (get_uniform_location(uniform_name_ptr) != -1)
                 {
-                    Framework::report_error("Uniform [" + std::string(uniform_name_ptr) + "] reported more than once.");
+                    Framework::report_error("Uniform [%s] reported more than once.",
+                                            uniform_name_ptr);
 
                     goto end;
                 }
 
-                m_uniform_name_to_id_map[uniform_name_ptr] = uniform_location;
+                {
+                    const auto insert_iterator = std::lower_bound(m_uniform_vec.begin(),
+                                                                  m_uniform_vec.end  (),
+                                                                  uniform_name_ptr,
+                                                                  is_less);
+
+                    m_uniform_vec.insert(insert_iterator,
+                                         Uniform{uniform_location, uniform_name_ptr});
+                }
             }
             else
             {
-                Framework::report_error(std::string("Zero-sized uniform name was reported for index [") + std::to_string(n_active_uniform) + "].");
+                Framework::report_error("Zero-sized uniform name was reported for index [%u].",
+                                        n_active_uniform);
 
                 goto end;
             }
@@ -182,4 +233,11 @@ bool Framework::Program::init()
     result = true;
 end:
     return result;
+}
+
+bool Framework::Program::is_less(const Uniform& in_uniform,
+                                 const char*    in_name_ptr)
+{
+    return strcmp(in_uniform.name.c_str(),
+                  in_name_ptr) < 0;
 }
\ No newline at end of file
@@ -0,0 +1,243 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "render_queue.h"
+#include <algorithm>
+#include <chrono>
+
+Framework::RenderQueue::RenderQueue(const uint32_t& in_n_draws_to_preallocate)
+{
+    m_draw_vec.reserve             (in_n_draws_to_preallocate);
+    m_sorted_draw_index_vec.reserve(in_n_draws_to_preallocate);
+    m_sort_item_temp_vec.reserve   (in_n_draws_to_preallocate);
+    m_sort_item_vec.reserve        (in_n_draws_to_preallocate);
+}
+
+Framework::RenderQueueUniquePtr Framework::RenderQueue::create(const uint32_t& in_n_draws_to_preallocate)
+{
+    RenderQueueUniquePtr result_ptr(
+        new RenderQueue(in_n_draws_to_preallocate)
+    );
+
+    return result_ptr;
+}
+
+void Framework::RenderQueue::execute()
+{
+    const auto& sorted_draw_index_vec = sort();
+
+    std::array<GLuint, QueuedDraw::N_MAX_TEXTURES> bound_texture_ids;
+    const Program*                                 bound_program_ptr = nullptr;
+    GLuint                                         bound_vao_id      = 0;
+    bool                                           is_vao_bound      = false;
+
+    bound_texture_ids.fill(0);
+
+    for (const auto& current_n_draw : sorted_draw_index_vec)
+    {
+        const auto& current_draw = m_draw_vec[current_n_draw];
+
+        if (current_draw.program_ptr != bound_program_ptr)
+        {
+            bound_program_ptr = current_draw.program_ptr;
+
+            glUseProgram(bound_program_ptr->get_id() );
+
+            m_stats.n_program_changes++;
+        }
+
+        if (!is_vao_bound                       ||
+            current_draw.vao_id != bound_vao_id)
+        {
+            bound_vao_id = current_draw.vao_id;
+            is_vao_bound = true;
+
+            glBindVertexArray(bound_vao_id);
+
+            m_stats.n_vao_changes++;
+        }
+
+        for (uint32_t n_texture = 0;
+                      n_texture < QueuedDraw::N_MAX_TEXTURES;
+                    ++n_texture)
+        {
+            const auto texture_ptr = current_draw.texture_ptrs[n_texture];
+
+            if (texture_ptr           != nullptr &&
+                texture_ptr->get_id() != bound_texture_ids[n_texture])
+            {
+                bound_texture_ids[n_texture] = texture_ptr->get_id();
+
+                glActiveTexture(GL_TEXTURE0 + n_texture);
+                glBindTexture  (texture_ptr->get_target(),
+                                bound_texture_ids[n_texture]);
+
+                m_stats.n_texture_changes++;
+            }
+        }
+
+        if (current_draw.uniform_setter_func_ptr != nullptr)
+        {
+            current_draw.uniform_setter_func_ptr(current_draw.program_ptr,
+                                                 current_draw.uniform_setter_user_arg);
+        }
+
+        if (current_draw.index_type != GL_NONE)
+        {
+            const uint32_t index_size = (current_draw.index_type == GL_UNSIGNED_BYTE)  ? 1
+                                      : (current_draw.index_type == GL_UNSIGNED_SHORT) ? 2
+                                                                                       : 4;
+
+            glDrawElements(current_draw.mode,
+                           static_cast<GLsizei>(current_draw.n_elements),
+                           current_draw.index_type,
+                           reinterpret_cast<const void*>(static_cast<uintptr_t>(current_draw.first * index_size) ));
+        }
+        else
+        {
+            glDrawArrays(current_draw.mode,
+                         static_cast<GLint>  (current_draw.first),
+                         static_cast<GLsizei>(current_draw.n_elements) );
+        }
+    }
+
+    if (is_vao_bound)
+    {
+        glBindVertexArray(0);
+    }
+
+    clear();
+}
+
+uint64_t Framework::RenderQueue::make_sort_key(const uint8_t&  in_layer,
+                                               const uint32_t& in_program_index,
+                                               const uint32_t& in_material_index,
+                                               const float&    in_normalized_depth,
+                                               const bool&     in_back_to_front)
+{
+    const float clamped_depth   = std::min(std::max(in_normalized_depth, 0.0f),
+                                           1.0f);
+    uint32_t    quantized_depth = static_cast<uint32_t>(clamped_depth * static_cast<float>(0xFFFFFF) );
+
+    if (in_back_to_front)
+    {
+        quantized_depth = 0xFFFFFF - quantized_depth;
+    }
+
+    return (static_cast<uint64_t>(in_layer)                      << 56) |
+           (static_cast<uint64_t>(in_program_index  & 0xFFF)     << 44) |
+           (static_cast<uint64_t>(in_material_index & 0xFFFFF)   << 24) |
+            static_cast<uint64_t>(quantized_depth   & 0xFFFFFF);
+}
+
+const std::vector<uint32_t>& Framework::RenderQueue::sort()
+{
+    const auto     sort_start_time = std::chrono::high_resolution_clock::now();
+    const uint32_t n_draws         = static_cast<uint32_t>(m_draw_vec.size() );
+
+    m_stats         = RenderQueueStats();
+    m_stats.n_draws = n_draws;
+
+    m_sort_item_temp_vec.resize   (n_draws);
+    m_sorted_draw_index_vec.resize(n_draws);
+
+    /* Build histograms for all 8 digits in a single pass. */
+    uint32_t histograms[8][256] = {};
+
+    for (uint32_t n_draw = 0;
+                  n_draw < n_draws;
+                ++n_draw)
+    {
+        const uint64_t key = m_sort_item_vec[n_draw].key;
+
+        for (uint32_t n_digit = 0;
+                      n_digit < 8;
+                    ++n_digit)
+        {
+            histograms[n_digit][(key >> (n_digit * 8)) & 0xFF]++;
+        }
+    }
+
+    /* Scatter, one digit at a time, starting with the least significant one. */
+    {
+        SortItem* src_ptr = m_sort_item_vec.data     ();
+        SortItem* dst_ptr = m_sort_item_temp_vec.data();
+
+        for (uint32_t n_digit = 0;
+                      n_digit < 8;
+                    ++n_digit)
+        {
+            uint32_t* histogram_ptr = histograms[n_digit];
+            const int shift         = static_cast<int>(n_digit * 8);
+
+            if (n_draws                                         == 0 ||
+                histogram_ptr[(src_ptr[0].key >> shift) & 0xFF] == n_draws)
+            {
+                /* All keys share this digit - the pass would not change the order. */
+                continue;
+            }
+
+            /* Turn the histogram into exclusive prefix sums. */
+            {
+                uint32_t n_items_so_far = 0;
+
+                for (uint32_t n_bucket = 0;
+                              n_bucket < 256;
+                            ++n_bucket)
+                {
+                    const uint32_t n_bucket_items = histogram_ptr[n_bucket];
+
+                    histogram_ptr[n_bucket] = n_items_so_far;
+                    n_items_so_far         += n_bucket_items;
+                }
+            }
+
+            for (uint32_t n_item = 0;
+                          n_item < n_draws;
+                        ++n_item)
+            {
+                const auto& current_item = src_ptr[n_item];
+
+                dst_ptr[histogram_ptr[(current_item.key >> shift) & 0xFF]++] = current_item;
+            }
+
+            std::swap(src_ptr,
+                      dst_ptr);
+
+            m_stats.n_radix_passes++;
+        }
+
+        for (uint32_t n_item = 0;
+                      n_item < n_draws;
+                    ++n_item)
+        {
+            m_sorted_draw_index_vec[n_item] = src_ptr[n_item].n_draw;
+        }
+    }
+
+    m_stats.sort_time_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - sort_start_time).count();
+
+    return m_sorted_draw_index_vec;
+}
\ No newline at end of file
@@ -24,6 +24,7 @@
 
 */
 #include "sampler.h"
+#include "gl_check.h"
 
 Framework::Sampler::Sampler(const WrapMode&           in_wrap_s,
                             const WrapMode&           in_wrap_t,
@@ -50,8 +51,8 @@ Framework::Sampler::~Sampler()
 {
     if (m_id != 0)
     {
-        glDeleteSamplers(1,
-                        &m_id);
+        FRAMEWORK_GL_CHECK(glDeleteSamplers(1,
+                                           &m_id) );
 
         m_id = 0;
     }
@@ -182,8 +183,8 @@ bool Framework::Sampler::init()
 {
     bool result = false;
 
-    glGenSamplers(1,
-                 &m_id);
+    FRAMEWORK_GL_CHECK(glGenSamplers(1,
+                                    &m_id) );
 
     if (m_id == 0)
     {
@@ -199,25 +200,25 @@ bool Framework::Sampler::init()
         const auto wrap_s_gl     = get_gl_int_for_wrap_mode(m_wrap_s);
         const auto wrap_t_gl     = get_gl_int_for_wrap_mode(m_wrap_t);
 
-        glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, min_filter_gl);
-        glSamplerParameteri(m_id, GL_TEXTURE_MAG_FILTER, mag_filter_gl);
-        glSamplerParameterf(m_id, GL_TEXTURE_MIN_LOD,    m_min_lod);
-        glSamplerParameterf(m_id, GL_TEXTURE_MAX_LOD,    m_max_lod);
-        glSamplerParameteri(m_id, GL_TEXTURE_WRAP_R,     wrap_r_gl);
-        glSamplerParameteri(m_id, GL_TEXTURE_WRAP_S,     wrap_t_gl);
-        glSamplerParameteri(m_id, GL_TEXTURE_WRAP_T,     wrap_t_gl);
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, min_filter_gl) );
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_MAG_FILTER, mag_filter_gl) );
+        FRAMEWORK_GL_CHECK(glSamplerParameterf(m_id, GL_TEXTURE_MIN_LOD,    m_min_lod) );
+        FRAMEWORK_GL_CHECK(glSamplerParameterf(m_id, GL_TEXTURE_MAX_LOD,    m_max_lod) );
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_WRAP_R,     wrap_r_gl) );
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_WRAP_S,     wrap_t_gl) );
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_WRAP_T,     wrap_t_gl) );
     }
 
     if (m_compare_func != TextureCompareFunc::DISABLED)
     {
         const auto texture_compare_func_gl = get_gl_int_for_texture_compare_func(m_compare_func);
 
-        glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-        glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_FUNC, texture_compare_func_gl);
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE) );
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_FUNC, texture_compare_func_gl) );
     }
     else
     {
-        glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        FRAMEWORK_GL_CHECK(glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_MODE, GL_NONE) );
     }
 
     result = true;
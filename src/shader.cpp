@@ -24,6 +24,7 @@
 
 */
 #include "shader.h"
+#include "gl_check.h"
 #include <assert.h>
 #include <vector>
 
@@ -40,7 +41,7 @@ Framework::Shader::~Shader()
 {
     if (m_id != 0)
     {
-        glDeleteShader(m_id);
+        FRAMEWORK_GL_CHECK(glDeleteShader(m_id) );
     }
 }
 
@@ -65,7 +66,7 @@ bool Framework::Shader::init()
                                : (m_shader_stage == ShaderStage::VERTEX)   ? GL_VERTEX_SHADER
                                                                            : UINT32_MAX;
 
-    m_id = glCreateShader(shader_stage_gl);
+    m_id = FRAMEWORK_GL_CHECK(glCreateShader(shader_stage_gl) );
 
     if (m_id == 0)
     {
@@ -77,20 +78,20 @@ bool Framework::Shader::init()
     {
         const char* glsl_raw_ptr = m_glsl.c_str();
 
-        glShaderSource(m_id,
-                       1,               /* count */
-                      &glsl_raw_ptr,
-                       nullptr);        /* length */
+        FRAMEWORK_GL_CHECK(glShaderSource(m_id,
+                                          1,               /* count */
+                                         &glsl_raw_ptr,
+                                          nullptr) );      /* length */
     }
 
-    glCompileShader(m_id);
+    FRAMEWORK_GL_CHECK(glCompileShader(m_id) );
 
     {
         GLint compile_status = 0;
 
-        glGetShaderiv(m_id,
-                      GL_COMPILE_STATUS,
-                     &compile_status);
+        FRAMEWORK_GL_CHECK(glGetShaderiv(m_id,
+                                         GL_COMPILE_STATUS,
+                                        &compile_status) );
 
         if (compile_status != GL_TRUE)
         {
@@ -99,21 +100,21 @@ bool Framework::Shader::init()
             GLint                info_log_incl_terminator_size = 0;
             std::vector<uint8_t> info_log_u8_vec;
 
-            glGetShaderiv(m_id,
-                          GL_INFO_LOG_LENGTH,
-                         &info_log_incl_terminator_size);
+            FRAMEWORK_GL_CHECK(glGetShaderiv(m_id,
+                                             GL_INFO_LOG_LENGTH,
+                                            &info_log_incl_terminator_size) );
 
             info_log_u8_vec.resize(info_log_incl_terminator_size);
 
             info_log_data_ptr = reinterpret_cast<const char*>(info_log_u8_vec.data() );
 
-            glGetShaderInfoLog(m_id,
-                               info_log_incl_terminator_size,
-                              &info_log_excl_terminator,
-                               reinterpret_cast<GLchar*>(info_log_u8_vec.data() ));
+            FRAMEWORK_GL_CHECK(glGetShaderInfoLog(m_id,
+                                                  info_log_incl_terminator_size,
+                                                 &info_log_excl_terminator,
+                                                  reinterpret_cast<GLchar*>(info_log_u8_vec.data() )) );
 
-            report_error("Shader failed to compile due to the following error:\n\n" +
-                         std::string(info_log_data_ptr) );
+            report_error("Shader failed to compile due to the following error:\n\n%s",
+                         info_log_data_ptr);
 
             goto end;
         }
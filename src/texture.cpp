@@ -24,17 +24,21 @@
 
 */
 #include "texture.h"
+#include "gl_check.h"
 #include <algorithm>
+#include <assert.h>
 
 Framework::Texture::Texture(const TextureType&             in_type,
                             const std::array<uint32_t, 3>& in_extents,
                             const TextureFormat&           in_format,
                             const uint32_t*                in_opt_n_mips_ptr)
-    :m_extents(in_extents),
-     m_format (in_format),
-     m_id     (0),
-     m_n_mips (UINT32_MAX),
-     m_type   (in_type)
+    :m_extents      (in_extents),
+     m_format       (in_format),
+     m_type         (in_type),
+     m_gpu_memory_id(0),
+     m_id           (0),
+     m_n_mips       (UINT32_MAX),
+     m_target       (GL_NONE)
 {
     if (in_opt_n_mips_ptr != nullptr)
     {
@@ -44,10 +48,12 @@ Framework::Texture::Texture(const TextureType&             in_type,
 
 Framework::Texture::~Texture()
 {
+    Framework::unregister_gpu_memory(m_gpu_memory_id);
+
     if (m_id != 0)
     {
-        glDeleteTextures(1,
-                        &m_id);
+        FRAMEWORK_GL_CHECK(glDeleteTextures(1,
+                                           &m_id) );
 
         m_id = 0;
     }
@@ -61,7 +67,7 @@ Framework::TextureUniquePtr Framework::Texture::create_immutable_2d(const bool&
 {
     TextureUniquePtr result_ptr(
         new Texture(TextureType::_2D,
-                    {in_extents.at(0), in_extents.at(1), 1},
+                    {in_extents.at(0), in_extents.at(1), in_n_layers},
                     in_format,
                     in_opt_n_mips_ptr)
     );
@@ -101,7 +107,7 @@ Framework::TextureUniquePtr Framework::Texture::create_immutable_3d(const bool&
 Framework::TextureUniquePtr Framework::Texture::create_immutable_cube(const bool&          in_single_mip,
                                                                       const TextureFormat& in_format,
                                                                       const uint32_t&      in_extents,
-                                                                    const uint32_t*                in_opt_n_mips_ptr)
+                                                                      const uint32_t*      in_opt_n_mips_ptr)
 {
     TextureUniquePtr result_ptr(
         new Texture(TextureType::CUBE,
@@ -146,15 +152,32 @@ std::array<uint32_t, 3> Framework::Texture::get_mip_size(const uint32_t& in_n_mi
     return result;
 }
 
+uint64_t Framework::Texture::get_n_bytes() const
+{
+    const auto format_info = Framework::get_texture_format_info(m_format);
+    uint64_t   result      = 0;
+
+    for (const auto& current_mip_size : m_mip_size_vec)
+    {
+        const uint64_t n_blocks_x = (current_mip_size.at(0) + format_info.block_width  - 1) / format_info.block_width;
+        const uint64_t n_blocks_y = (current_mip_size.at(1) + format_info.block_height - 1) / format_info.block_height;
+
+        result += n_blocks_x * n_blocks_y * current_mip_size.at(2) * format_info.n_bytes_per_block;
+    }
+
+    return result;
+}
+
 bool Framework::Texture::init(const bool& in_mipped)
 {
-    uint32_t n_mips            = 0;
-    bool     result            = false;
-    GLenum   texture_target_gl = GL_NONE;
+    const bool is_3d_texture     = (m_type == TextureType::_3D);
+    uint32_t   n_mips            = 0;
+    bool       result            = false;
+    GLenum     texture_target_gl = GL_NONE;
 
     /* Allocate an ID */
-    glGenTextures(1,
-                 &m_id);
+    FRAMEWORK_GL_CHECK(glGenTextures(1,
+                                    &m_id) );
 
     if (m_id == 0)
     {
@@ -163,10 +186,20 @@ bool Framework::Texture::init(const bool& in_mipped)
         goto end;
     }
 
-    /* Determine how many mips we're going to need. */
+    if (Framework::get_texture_format_info(m_format).n_bytes_per_block == 0)
+    {
+        Framework::report_error("Unsupported texture format requested.");
+
+        goto end;
+    }
+
+    /* Determine how many mips we're going to need. Only 3D textures shrink along the third axis, which holds
+     * layers (or cube faces) for the other types. */
     m_mip_size_vec.push_back(m_extents);
 
-    while (m_mip_size_vec.back() != std::array<uint32_t, 3>{1, 1, 1})
+    while ( m_mip_size_vec.back().at(0) > 1              ||
+            m_mip_size_vec.back().at(1) > 1              ||
+           (m_mip_size_vec.back().at(2) > 1 && is_3d_texture) )
     {
         std::array<uint32_t, 3> new_mip_size{};
 
@@ -174,19 +207,26 @@ bool Framework::Texture::init(const bool& in_mipped)
         {
             std::max(1u, m_mip_size_vec.back().at(0) / 2),
             std::max(1u, m_mip_size_vec.back().at(1) / 2),
-            std::max(1u, m_mip_size_vec.back().at(2) / 2),
+            (is_3d_texture) ? std::max(1u, m_mip_size_vec.back().at(2) / 2)
+                            : m_mip_size_vec.back().at(2),
         };
 
         m_mip_size_vec.emplace_back(new_mip_size);
     }
 
-    if (m_n_mips != UINT32_MAX)
+    if (!in_mipped)
+    {
+        n_mips = 1;
+    }
+    else
+    if (m_n_mips == UINT32_MAX)
     {
         n_mips = static_cast<uint32_t>(m_mip_size_vec.size() );
     }
     else
     {
-        if (m_n_mips > n_mips)
+        if (m_n_mips == 0                                             ||
+            m_n_mips >  static_cast<uint32_t>(m_mip_size_vec.size() ) )
         {
             Framework::report_error("Invalid number of mips specified for a texture.");
 
@@ -196,6 +236,10 @@ bool Framework::Texture::init(const bool& in_mipped)
         n_mips = m_n_mips;
     }
 
+    /* Only keep the mips which are going to be allocated, so that get_mip_size() & get_n_bytes() reflect them. */
+    m_mip_size_vec.resize(n_mips);
+    m_n_mips = n_mips;
+
     /* Set up immutable storage */
     switch (m_type)
     {
@@ -203,28 +247,28 @@ bool Framework::Texture::init(const bool& in_mipped)
         {
             if (m_extents.at(2) == 1)
             {
-                glBindTexture(GL_TEXTURE_2D,
-                              m_id);
+                FRAMEWORK_GL_CHECK(glBindTexture(GL_TEXTURE_2D,
+                                                 m_id) );
 
-                glTexStorage2D(GL_TEXTURE_2D,
-                               n_mips,
-                               static_cast<GLenum>(m_format),
-                               m_extents.at(0),
-                               m_extents.at(1) );
+                FRAMEWORK_GL_CHECK(glTexStorage2D(GL_TEXTURE_2D,
+                                                  n_mips,
+                                                  static_cast<GLenum>(m_format),
+                                                  m_extents.at(0),
+                                                  m_extents.at(1) ) );
 
                 texture_target_gl = GL_TEXTURE_2D;
             }
             else
             {
-                glBindTexture(GL_TEXTURE_2D_ARRAY,
-                              m_id);
+                FRAMEWORK_GL_CHECK(glBindTexture(GL_TEXTURE_2D_ARRAY,
+                                                 m_id) );
 
-                glTexStorage3D(GL_TEXTURE_2D_ARRAY,
-                               n_mips,
-                               static_cast<GLenum>(m_format),
-                               m_extents.at(0),
-                               m_extents.at(1),
-                               m_extents.at(2) );
+                FRAMEWORK_GL_CHECK(glTexStorage3D(GL_TEXTURE_2D_ARRAY,
+                                                  n_mips,
+                                                  static_cast<GLenum>(m_format),
+                                                  m_extents.at(0),
+                                                  m_extents.at(1),
+                                                  m_extents.at(2) ) );
 
                 texture_target_gl = GL_TEXTURE_2D_ARRAY;
             }
@@ -234,15 +278,15 @@ bool Framework::Texture::init(const bool& in_mipped)
 
         case TextureType::_3D:
         {
-            glBindTexture(GL_TEXTURE_3D,
-                          m_id);
+            FRAMEWORK_GL_CHECK(glBindTexture(GL_TEXTURE_3D,
+                                             m_id) );
 
-            glTexStorage3D(GL_TEXTURE_3D,
-                           n_mips,
-                           static_cast<GLenum>(m_format),
-                           m_extents.at(0),
-                           m_extents.at(1),
-                           m_extents.at(2) );
+            FRAMEWORK_GL_CHECK(glTexStorage3D(GL_TEXTURE_3D,
+                                              n_mips,
+                                              static_cast<GLenum>(m_format),
+                                              m_extents.at(0),
+                                              m_extents.at(1),
+                                              m_extents.at(2) ) );
 
             texture_target_gl = GL_TEXTURE_3D;
             break;
@@ -250,14 +294,14 @@ bool Framework::Texture::init(const bool& in_mipped)
 
         case TextureType::CUBE:
         {
-            glBindTexture(GL_TEXTURE_CUBE_MAP,
-                          m_id);
+            FRAMEWORK_GL_CHECK(glBindTexture(GL_TEXTURE_CUBE_MAP,
+                                             m_id) );
 
-            glTexStorage2D(GL_TEXTURE_CUBE_MAP,
-                           n_mips,
-                           static_cast<GLenum>(m_format),
-                           m_extents.at(0),
-                           m_extents.at(1) );
+            FRAMEWORK_GL_CHECK(glTexStorage2D(GL_TEXTURE_CUBE_MAP,
+                                              n_mips,
+                                              static_cast<GLenum>(m_format),
+                                              m_extents.at(0),
+                                              m_extents.at(1) ) );
 
             texture_target_gl = GL_TEXTURE_CUBE_MAP;
             break;
@@ -271,19 +315,168 @@ bool Framework::Texture::init(const bool& in_mipped)
         }
     }
 
-    glTexParameteri(texture_target_gl,
-                    GL_TEXTURE_MAG_FILTER,
-                    GL_NEAREST);
-    glTexParameteri(texture_target_gl,
-                    GL_TEXTURE_MIN_FILTER,
-                    GL_NEAREST);
-
-    result = true;
+    FRAMEWORK_GL_CHECK(glTexParameteri(texture_target_gl,
+                                       GL_TEXTURE_MAG_FILTER,
+                                       GL_NEAREST) );
+    FRAMEWORK_GL_CHECK(glTexParameteri(texture_target_gl,
+                                       GL_TEXTURE_MIN_FILTER,
+                                       GL_NEAREST) );
+
+    m_gpu_memory_id = Framework::register_gpu_memory(GPUMemoryType::TEXTURE,
+                                                     "Texture",
+                                                     get_n_bytes() );
+    m_target        = texture_target_gl;
+    result          = true;
 end:
     return result;
 }
 
+GLenum Framework::Texture::get_target() const
+{
+    return m_target;
+}
+
 Framework::TextureType Framework::Texture::get_type() const
 {
     return m_type;
+}
+
+Framework::TextureFormatInfo Framework::get_texture_format_info(const TextureFormat& in_format)
+{
+    TextureFormatInfo result{1, 1, 0};
+
+    switch (in_format)
+    {
+        case TextureFormat::R8_SINT:
+        case TextureFormat::R8_UINT:
+        case TextureFormat::R8_SNORM:
+        case TextureFormat::R8_UNORM:
+        {
+            result.n_bytes_per_block = 1;
+
+            break;
+        }
+
+        case TextureFormat::R16_SFLOAT:
+        case TextureFormat::R16_SINT:
+        case TextureFormat::R16_SNORM:
+        case TextureFormat::R16_UINT:
+        case TextureFormat::R16_UNORM:
+        case TextureFormat::R4G4B4A4_UNORM:
+        case TextureFormat::R5G5B5_A1:
+        case TextureFormat::R5G6B5_UNORM:
+        case TextureFormat::R8G8_SINT:
+        case TextureFormat::R8G8_SNORM:
+        case TextureFormat::R8G8_UINT:
+        case TextureFormat::R8G8_UNORM:
+        {
+            result.n_bytes_per_block = 2;
+
+            break;
+        }
+
+        case TextureFormat::R8G8B8_SINT:
+        case TextureFormat::R8G8B8_SNORM:
+        case TextureFormat::R8G8B8_UINT:
+        case TextureFormat::R8G8B8_UNORM:
+        case TextureFormat::SR8G8B8_UNORM:
+        {
+            result.n_bytes_per_block = 3;
+
+            break;
+        }
+
+        case TextureFormat::D32_SFLOAT:
+        case TextureFormat::R10G10B10_A2:
+        case TextureFormat::R11G11B10_SFLOAT:
+        case TextureFormat::R16G16_SFLOAT:
+        case TextureFormat::R16G16_SINT:
+        case TextureFormat::R16G16_SNORM:
+        case TextureFormat::R16G16_UINT:
+        case TextureFormat::R16G16_UNORM:
+        case TextureFormat::R32_SFLOAT:
+        case TextureFormat::R32_SINT:
+        case TextureFormat::R32_UINT:
+        case TextureFormat::R8G8B8A8_SINT:
+        case TextureFormat::R8G8B8A8_SNORM:
+        case TextureFormat::R8G8B8A8_UINT:
+        case TextureFormat::R8G8B8A8_UNORM:
+        case TextureFormat::R9G9B9E5_SFLOAT:
+        case TextureFormat::SR8G8B8_ALPHA8_UNORM:
+        {
+            result.n_bytes_per_block = 4;
+
+            break;
+        }
+
+        case TextureFormat::R16G16B16_SFLOAT:
+        case TextureFormat::R16G16B16_SINT:
+        case TextureFormat::R16G16B16_SNORM:
+        case TextureFormat::R16G16B16_UINT:
+        case TextureFormat::R16G16B16_UNORM:
+        {
+            result.n_bytes_per_block = 6;
+
+            break;
+        }
+
+        case TextureFormat::R16G16B16A16_SFLOAT:
+        case TextureFormat::R16G16B16A16_SINT:
+        case TextureFormat::R16G16B16A16_SNORM:
+        case TextureFormat::R16G16B16A16_UINT:
+        case TextureFormat::R16G16B16A16_UNORM:
+        case TextureFormat::R32G32_SFLOAT:
+        case TextureFormat::R32G32_SINT:
+        case TextureFormat::R32G32_UINT:
+        {
+            result.n_bytes_per_block = 8;
+
+            break;
+        }
+
+        case TextureFormat::R32G32B32_SFLOAT:
+        case TextureFormat::R32G32B32_SINT:
+        case TextureFormat::R32G32B32_UINT:
+        {
+            result.n_bytes_per_block = 12;
+
+            break;
+        }
+
+        case TextureFormat::R32G32B32A32_SFLOAT:
+        case TextureFormat::R32G32B32A32_SINT:
+        case TextureFormat::R32G32B32A32_UINT:
+        {
+            result.n_bytes_per_block = 16;
+
+            break;
+        }
+
+        case TextureFormat::BC1_RGB_SRGB:
+        case TextureFormat::BC1_RGBA_SRGB:
+        case TextureFormat::BC1_RGBA_UNORM:
+        {
+            result = {4, 4, 8};
+
+            break;
+        }
+
+        default:
+        {
+            result = {0, 0, 0};
+        }
+    }
+
+    return result;
+}
+
+void Framework::Texture::set_gpu_memory_tag(const GPUMemoryType& in_type,
+                                            const std::string&   in_tag)
+{
+    assert(in_type == GPUMemoryType::RENDER_TARGET ||
+           in_type == GPUMemoryType::TEXTURE);
+
+    Framework::retag_gpu_memory(m_gpu_memory_id,
+                                in_type,
+                                in_tag);
 }
\ No newline at end of file
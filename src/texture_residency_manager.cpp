@@ -0,0 +1,229 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "texture_residency_manager.h"
+#include <assert.h>
+
+Framework::TextureResidencyManager::TextureResidencyManager(const uint64_t& in_budget_n_bytes)
+    :m_budget_n_bytes (in_budget_n_bytes),
+     m_n_current_frame(0)
+{
+    /* Stub */
+}
+
+Framework::TextureResidencyManager::~TextureResidencyManager()
+{
+    /* Stub */
+}
+
+Framework::TextureResidencyManagerUniquePtr Framework::TextureResidencyManager::create(const uint64_t& in_budget_n_bytes)
+{
+    TextureResidencyManagerUniquePtr result_ptr(
+        new TextureResidencyManager(in_budget_n_bytes)
+    );
+
+    return result_ptr;
+}
+
+void Framework::TextureResidencyManager::end_frame()
+{
+    m_n_current_frame++;
+}
+
+bool Framework::TextureResidencyManager::load(Entry*          in_entry_ptr,
+                                              const uint32_t& in_n_skipped_mips)
+{
+    bool result = false;
+
+    /* Release the old texture first, so that both versions never take memory at the same time. */
+    if (in_entry_ptr->texture_ptr != nullptr)
+    {
+        release(in_entry_ptr);
+    }
+
+    in_entry_ptr->texture_ptr = in_entry_ptr->load_func_ptr(in_n_skipped_mips,
+                                                            in_entry_ptr->load_func_user_arg);
+
+    if (in_entry_ptr->texture_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    in_entry_ptr->texture_ptr->set_gpu_memory_tag(GPUMemoryType::TEXTURE,
+                                                  "TextureResidencyManager");
+
+    in_entry_ptr->n_skipped_mips = in_n_skipped_mips;
+
+    m_stats.n_loads++;
+    m_stats.n_resident_textures++;
+
+    m_stats.resident_n_bytes += in_entry_ptr->texture_ptr->get_n_bytes();
+
+    result = true;
+end:
+    return result;
+}
+
+Framework::TextureResidencyHandle Framework::TextureResidencyManager::register_texture(PFNTEXTURELOADPROC in_load_func_ptr,
+                                                                                       void*              in_user_arg,
+                                                                                       const uint32_t&    in_priority,
+                                                                                       const uint32_t&    in_n_degradable_mips)
+{
+    TextureResidencyHandle result_handle = 0;
+
+    assert(in_load_func_ptr != nullptr);
+
+    if (!m_free_handle_vec.empty() )
+    {
+        result_handle = m_free_handle_vec.back();
+
+        m_free_handle_vec.pop_back();
+    }
+    else
+    {
+        result_handle = static_cast<TextureResidencyHandle>(m_entry_vec.size() );
+
+        m_entry_vec.emplace_back();
+    }
+
+    {
+        auto& entry = m_entry_vec.at(result_handle);
+
+        entry.is_registered      = true;
+        entry.load_func_ptr      = in_load_func_ptr;
+        entry.load_func_user_arg = in_user_arg;
+        entry.n_degradable_mips  = in_n_degradable_mips;
+        entry.priority           = in_priority;
+    }
+
+    return result_handle;
+}
+
+void Framework::TextureResidencyManager::release(Entry* in_entry_ptr)
+{
+    assert(in_entry_ptr->texture_ptr != nullptr);
+
+    m_stats.n_resident_textures--;
+
+    m_stats.resident_n_bytes -= in_entry_ptr->texture_ptr->get_n_bytes();
+
+    in_entry_ptr->texture_ptr.reset();
+}
+
+void Framework::TextureResidencyManager::set_budget(const uint64_t& in_budget_n_bytes)
+{
+    m_budget_n_bytes = in_budget_n_bytes;
+
+    trim();
+}
+
+void Framework::TextureResidencyManager::trim()
+{
+    while (m_stats.resident_n_bytes > m_budget_n_bytes)
+    {
+        Entry* victim_entry_ptr = nullptr;
+
+        for (auto& current_entry : m_entry_vec)
+        {
+            if (current_entry.texture_ptr       == nullptr           ||
+                current_entry.n_frame_last_used == m_n_current_frame)
+            {
+                continue;
+            }
+
+            if ( victim_entry_ptr == nullptr                                             ||
+                 current_entry.priority          <  victim_entry_ptr->priority          ||
+                (current_entry.priority          == victim_entry_ptr->priority          &&
+                 current_entry.n_frame_last_used <  victim_entry_ptr->n_frame_last_used) )
+            {
+                victim_entry_ptr = &current_entry;
+            }
+        }
+
+        if (victim_entry_ptr == nullptr)
+        {
+            /* Everything that is left has been used during the current frame. */
+            break;
+        }
+
+        if (victim_entry_ptr->n_skipped_mips < victim_entry_ptr->n_degradable_mips)
+        {
+            if (load(victim_entry_ptr,
+                     victim_entry_ptr->n_degradable_mips) )
+            {
+                m_stats.n_degradations++;
+            }
+            else
+            {
+                /* The old texture has been released by load(). */
+                m_stats.n_evictions++;
+            }
+        }
+        else
+        {
+            release(victim_entry_ptr);
+
+            m_stats.n_evictions++;
+        }
+    }
+}
+
+void Framework::TextureResidencyManager::unregister_texture(const TextureResidencyHandle& in_handle)
+{
+    auto& entry = m_entry_vec.at(in_handle);
+
+    assert(entry.is_registered);
+
+    if (entry.texture_ptr != nullptr)
+    {
+        release(&entry);
+    }
+
+    entry = Entry();
+
+    m_free_handle_vec.push_back(in_handle);
+}
+
+const Framework::Texture* Framework::TextureResidencyManager::use(const TextureResidencyHandle& in_handle)
+{
+    auto& entry = m_entry_vec.at(in_handle);
+
+    assert(entry.is_registered);
+
+    entry.n_frame_last_used = m_n_current_frame;
+
+    if (entry.texture_ptr    == nullptr ||
+        entry.n_skipped_mips != 0)
+    {
+        if (load(&entry,
+                 0 /* in_n_skipped_mips */) )
+        {
+            /* Make room for the texture by releasing ones which have not been used during this frame. */
+            trim();
+        }
+    }
+
+    return entry.texture_ptr.get();
+}
\ No newline at end of file
@@ -0,0 +1,591 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "trace.h"
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+
+namespace
+{
+    struct TraceZone
+    {
+        uint64_t    end_ns;
+        uint64_t    n_allocated_bytes;
+        uint64_t    n_allocations;
+        const char* name_ptr;
+        uint64_t    start_ns;
+    };
+
+    /* Only ever written to by a single thread. Zones [0, n_zones) are visible to other threads once n_zones has been
+     * loaded with acquire semantics. Buffers are never released, so zones may safely be recorded while a trace is
+     * being saved. */
+    struct ThreadTraceBuffer
+    {
+        std::atomic<uint32_t>  n_dropped_zones;
+        std::atomic<uint32_t>  n_zones;
+        const char*            thread_name_ptr; /* Guarded by g_buffer_vec_mutex */
+        const uint32_t         thread_id;
+        std::vector<TraceZone> zone_vec;
+
+        ThreadTraceBuffer(const uint32_t& in_thread_id,
+                          const uint32_t& in_n_max_zones)
+            :n_dropped_zones(0),
+             n_zones        (0),
+             thread_name_ptr(nullptr),
+             thread_id      (in_thread_id),
+             zone_vec       (in_n_max_zones)
+        {
+            /* Stub */
+        }
+    };
+
+    #if !defined(__EMSCRIPTEN__)
+        struct GPUTraceZone
+        {
+            const char* name_ptr;
+            GLuint      query_id;
+            uint64_t    submit_ns;
+        };
+    #endif
+
+    /* Type defs */
+    typedef std::unique_ptr<ThreadTraceBuffer> ThreadTraceBufferUniquePtr;
+}
+
+static std::vector<ThreadTraceBufferUniquePtr>          g_buffer_ptr_vec;
+static std::mutex                                       g_buffer_vec_mutex;
+static std::atomic<uint64_t>                            g_frame_counters[static_cast<uint32_t>(Framework::FrameCounter::COUNT)];
+static ThreadTraceBuffer*                               g_gpu_buffer_ptr         = nullptr;
+static std::atomic<bool>                                g_is_tracing_enabled     (false);
+static uint32_t                                         g_n_max_zones_per_thread = 0;
+static std::atomic<uint32_t>                            g_n_thread_indices_used  (1); /* 0 is the GPU track. */
+static const std::chrono::steady_clock::time_point      g_start_time             = std::chrono::steady_clock::now();
+static void*                                            g_zone_callback_user_arg = nullptr;
+static std::atomic<Framework::PFNTRACEZONECALLBACKPROC> g_zone_callback_func_ptr (nullptr);
+static thread_local ThreadTraceBuffer*                  t_buffer_ptr             = nullptr;
+static thread_local const char*                         t_current_zone_name_ptr  = nullptr;
+static thread_local uint32_t                            t_thread_index           = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    static GPUTraceZone              g_active_gpu_zone      = {};
+    static std::vector<GLuint>       g_free_query_id_vec;
+    static uint64_t                  g_gpu_track_end_ns     = 0;
+    static bool                      g_is_gpu_zone_active   = false;
+    static std::vector<GPUTraceZone> g_pending_gpu_zone_vec;
+#endif
+
+static ThreadTraceBuffer* get_thread_trace_buffer()
+{
+    if (t_buffer_ptr == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(g_buffer_vec_mutex);
+
+        g_buffer_ptr_vec.push_back(
+            ThreadTraceBufferUniquePtr(new ThreadTraceBuffer(Framework::get_trace_thread_index(),
+                                                             g_n_max_zones_per_thread) )
+        );
+
+        t_buffer_ptr = g_buffer_ptr_vec.back().get();
+    }
+
+    return t_buffer_ptr;
+}
+
+static void push_trace_zone(ThreadTraceBuffer* in_buffer_ptr,
+                            const char*        in_name_ptr,
+                            const uint64_t&    in_start_ns,
+                            const uint64_t&    in_end_ns,
+                            const uint64_t&    in_n_allocations,
+                            const uint64_t&    in_n_allocated_bytes)
+{
+    const uint32_t n_zones = in_buffer_ptr->n_zones.load(std::memory_order_relaxed);
+
+    if (n_zones >= static_cast<uint32_t>(in_buffer_ptr->zone_vec.size() ) )
+    {
+        in_buffer_ptr->n_dropped_zones.fetch_add(1,
+                                                 std::memory_order_relaxed);
+
+        return;
+    }
+
+    in_buffer_ptr->zone_vec[n_zones].end_ns            = in_end_ns;
+    in_buffer_ptr->zone_vec[n_zones].n_allocated_bytes = in_n_allocated_bytes;
+    in_buffer_ptr->zone_vec[n_zones].n_allocations     = in_n_allocations;
+    in_buffer_ptr->zone_vec[n_zones].name_ptr          = in_name_ptr;
+    in_buffer_ptr->zone_vec[n_zones].start_ns          = in_start_ns;
+
+    in_buffer_ptr->n_zones.store(n_zones + 1,
+                                 std::memory_order_release);
+}
+
+/* Names are expected to be identifiers, but make sure they cannot break the JSON. */
+static void write_json_string(FILE*       in_file_ptr,
+                              const char* in_string_ptr)
+{
+    fputc('"',
+          in_file_ptr);
+
+    for (const char* current_char_ptr = in_string_ptr;
+                    *current_char_ptr != 0;
+                   ++current_char_ptr)
+    {
+        if (*current_char_ptr == '"' ||
+            *current_char_ptr == '\\')
+        {
+            fputc('\\',
+                  in_file_ptr);
+        }
+
+        if (static_cast<unsigned char>(*current_char_ptr) >= 0x20)
+        {
+            fputc(*current_char_ptr,
+                  in_file_ptr);
+        }
+    }
+
+    fputc('"',
+          in_file_ptr);
+}
+
+void Framework::add_to_frame_counter(const FrameCounter& in_counter,
+                                     const uint64_t&     in_delta)
+{
+    g_frame_counters[static_cast<uint32_t>(in_counter)].fetch_add(in_delta,
+                                                                  std::memory_order_relaxed);
+}
+
+void Framework::begin_gpu_trace_zone(const char* in_name_ptr)
+{
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (!is_tracing_enabled()               ||
+            !GLAD_GL_EXT_disjoint_timer_query)
+        {
+            return;
+        }
+
+        /* GL_TIME_ELAPSED_EXT queries cannot be nested. */
+        assert(!g_is_gpu_zone_active);
+
+        g_active_gpu_zone.name_ptr  = in_name_ptr;
+        g_active_gpu_zone.submit_ns = get_trace_time_ns();
+
+        if (!g_free_query_id_vec.empty() )
+        {
+            g_active_gpu_zone.query_id = g_free_query_id_vec.back();
+
+            g_free_query_id_vec.pop_back();
+        }
+        else
+        {
+            glGenQueries(1, /* n */
+                        &g_active_gpu_zone.query_id);
+        }
+
+        glBeginQuery(GL_TIME_ELAPSED_EXT,
+                     g_active_gpu_zone.query_id);
+
+        g_is_gpu_zone_active = true;
+    }
+    #endif
+}
+
+void Framework::end_gpu_trace_zone()
+{
+    #if !defined(__EMSCRIPTEN__)
+    {
+        if (!g_is_gpu_zone_active)
+        {
+            return;
+        }
+
+        glEndQuery(GL_TIME_ELAPSED_EXT);
+
+        g_pending_gpu_zone_vec.push_back(g_active_gpu_zone);
+
+        g_is_gpu_zone_active = false;
+    }
+    #endif
+}
+
+void Framework::end_trace_frame()
+{
+    #if !defined(__EMSCRIPTEN__)
+    {
+        GLint    is_disjoint    = GL_FALSE;
+        uint32_t n_zones_polled = 0;
+
+        if (g_pending_gpu_zone_vec.empty() )
+        {
+            return;
+        }
+
+        /* Queries complete in submission order, so stop at the first one whose result is not available yet. */
+        for (;
+             n_zones_polled < static_cast<uint32_t>(g_pending_gpu_zone_vec.size() );
+           ++n_zones_polled)
+        {
+            GLuint is_available = GL_FALSE;
+
+            glGetQueryObjectuiv(g_pending_gpu_zone_vec[n_zones_polled].query_id,
+                                GL_QUERY_RESULT_AVAILABLE,
+                               &is_available);
+
+            if (is_available == GL_FALSE)
+            {
+                break;
+            }
+        }
+
+        /* Results of queries which were in flight when a disjoint operation occurred are meaningless. */
+        glGetIntegerv(GL_GPU_DISJOINT_EXT,
+                     &is_disjoint);
+
+        for (uint32_t n_zone = 0;
+                      n_zone < n_zones_polled;
+                    ++n_zone)
+        {
+            const auto& current_zone = g_pending_gpu_zone_vec[n_zone];
+
+            if (is_disjoint == GL_FALSE)
+            {
+                GLuint64 duration_ns = 0;
+                uint64_t start_ns    = std::max(current_zone.submit_ns,
+                                                g_gpu_track_end_ns);
+
+                glGetQueryObjectui64vEXT(current_zone.query_id,
+                                         GL_QUERY_RESULT,
+                                        &duration_ns);
+
+                g_gpu_track_end_ns = start_ns + duration_ns;
+
+                push_trace_zone(g_gpu_buffer_ptr,
+                                current_zone.name_ptr,
+                                start_ns,
+                                g_gpu_track_end_ns,
+                                0,  /* in_n_allocations     */
+                                0); /* in_n_allocated_bytes */
+            }
+
+            g_free_query_id_vec.push_back(current_zone.query_id);
+        }
+
+        g_pending_gpu_zone_vec.erase(g_pending_gpu_zone_vec.begin(),
+                                     g_pending_gpu_zone_vec.begin() + n_zones_polled);
+    }
+    #endif
+}
+
+void Framework::fetch_and_reset_frame_counters(FrameCounterArray* out_values_ptr)
+{
+    for (uint32_t n_counter = 0;
+                  n_counter < static_cast<uint32_t>(FrameCounter::COUNT);
+                ++n_counter)
+    {
+        (*out_values_ptr)[n_counter] = g_frame_counters[n_counter].exchange(0,
+                                                                            std::memory_order_relaxed);
+    }
+}
+
+const char* Framework::get_current_trace_zone_name()
+{
+    return t_current_zone_name_ptr;
+}
+
+const char* Framework::get_frame_counter_name(const FrameCounter& in_counter)
+{
+    switch (in_counter)
+    {
+        case FrameCounter::ALLOCATED_BYTES: return "Allocated bytes";
+        case FrameCounter::N_ALLOCATIONS:   return "Allocations";
+        case FrameCounter::UPLOADED_BYTES:  return "Uploaded bytes";
+
+        default:
+        {
+            assert(false);
+        }
+    }
+
+    return "?";
+}
+
+uint32_t Framework::get_trace_thread_index()
+{
+    if (t_thread_index == 0)
+    {
+        t_thread_index = g_n_thread_indices_used.fetch_add(1,
+                                                           std::memory_order_relaxed);
+    }
+
+    return t_thread_index;
+}
+
+uint64_t Framework::get_trace_time_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_start_time).count() );
+}
+
+bool Framework::is_tracing_enabled()
+{
+    return g_is_tracing_enabled.load(std::memory_order_relaxed);
+}
+
+bool Framework::is_zone_recording_enabled()
+{
+    return g_is_tracing_enabled.load    (std::memory_order_relaxed) ||
+           g_zone_callback_func_ptr.load(std::memory_order_relaxed) != nullptr;
+}
+
+void Framework::record_trace_zone(const char*     in_name_ptr,
+                                  const uint64_t& in_start_ns,
+                                  const uint64_t& in_end_ns,
+                                  const uint64_t& in_n_allocations,
+                                  const uint64_t& in_n_allocated_bytes)
+{
+    const auto callback_func_ptr = g_zone_callback_func_ptr.load(std::memory_order_acquire);
+
+    if (callback_func_ptr != nullptr)
+    {
+        callback_func_ptr(in_name_ptr,
+                          get_trace_thread_index(),
+                          in_start_ns,
+                          in_end_ns,
+                          in_n_allocations,
+                          in_n_allocated_bytes,
+                          g_zone_callback_user_arg);
+    }
+
+    if (is_tracing_enabled() )
+    {
+        push_trace_zone(get_thread_trace_buffer(),
+                        in_name_ptr,
+                        in_start_ns,
+                        in_end_ns,
+                        in_n_allocations,
+                        in_n_allocated_bytes);
+    }
+}
+
+void Framework::release_trace_gl_objects()
+{
+    #if !defined(__EMSCRIPTEN__)
+    {
+        end_gpu_trace_zone();
+
+        if (!g_pending_gpu_zone_vec.empty() )
+        {
+            /* Harvest the last few frames, too. */
+            glFinish       ();
+            end_trace_frame();
+        }
+
+        for (const auto& current_zone : g_pending_gpu_zone_vec)
+        {
+            g_free_query_id_vec.push_back(current_zone.query_id);
+        }
+
+        if (!g_free_query_id_vec.empty() )
+        {
+            glDeleteQueries(static_cast<GLsizei>(g_free_query_id_vec.size() ),
+                            g_free_query_id_vec.data() );
+        }
+
+        g_free_query_id_vec.clear   ();
+        g_pending_gpu_zone_vec.clear();
+    }
+    #endif
+}
+
+void Framework::set_trace_zone_callback(PFNTRACEZONECALLBACKPROC in_func_ptr,
+                                        void*                    in_user_arg)
+{
+    assert(in_func_ptr                                              == nullptr ||
+           g_zone_callback_func_ptr.load(std::memory_order_relaxed) == nullptr);
+
+    if (in_func_ptr != nullptr)
+    {
+        g_zone_callback_user_arg = in_user_arg;
+    }
+
+    /* Threads which load the new function pointer are guaranteed to see the matching user arg. */
+    g_zone_callback_func_ptr.store(in_func_ptr,
+                                   std::memory_order_release);
+}
+
+const char* Framework::set_current_trace_zone_name(const char* in_name_ptr)
+{
+    const char* result_ptr = t_current_zone_name_ptr;
+
+    t_current_zone_name_ptr = in_name_ptr;
+
+    return result_ptr;
+}
+
+void Framework::set_trace_thread_name(const char* in_name_ptr)
+{
+    if (!is_tracing_enabled() )
+    {
+        return;
+    }
+
+    {
+        auto                        buffer_ptr = get_thread_trace_buffer();
+        std::lock_guard<std::mutex> lock      (g_buffer_vec_mutex);
+
+        buffer_ptr->thread_name_ptr = in_name_ptr;
+    }
+}
+
+void Framework::start_tracing(const uint32_t& in_n_max_zones_per_thread)
+{
+    /* Buffers are never released, so tracing can only be started once. */
+    assert(g_gpu_buffer_ptr == nullptr);
+
+    g_n_max_zones_per_thread = in_n_max_zones_per_thread;
+
+    {
+        std::lock_guard<std::mutex> lock(g_buffer_vec_mutex);
+
+        g_buffer_ptr_vec.push_back(
+            ThreadTraceBufferUniquePtr(new ThreadTraceBuffer(0, /* in_thread_id */
+                                                             in_n_max_zones_per_thread) )
+        );
+
+        g_gpu_buffer_ptr                  = g_buffer_ptr_vec.back().get();
+        g_gpu_buffer_ptr->thread_name_ptr = "GPU";
+    }
+
+    g_is_tracing_enabled.store(true,
+                               std::memory_order_relaxed);
+}
+
+bool Framework::stop_tracing_and_save(const std::string& in_filename)
+{
+    FILE*    file_ptr        = nullptr;
+    bool     is_first_event  = true;
+    uint32_t n_dropped_zones = 0;
+    bool     result          = false;
+
+    g_is_tracing_enabled.store(false,
+                               std::memory_order_relaxed);
+
+    file_ptr = ::fopen(in_filename.c_str(),
+                       "wb");
+
+    if (file_ptr == nullptr)
+    {
+        Framework::report_error("Failed to open [%s] for writing.",
+                                in_filename);
+
+        goto end;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[",
+          file_ptr);
+
+    {
+        std::lock_guard<std::mutex> lock(g_buffer_vec_mutex);
+
+        for (const auto& current_buffer_ptr : g_buffer_ptr_vec)
+        {
+            const uint32_t n_zones = current_buffer_ptr->n_zones.load(std::memory_order_acquire);
+
+            if (current_buffer_ptr->thread_name_ptr != nullptr)
+            {
+                fprintf(file_ptr,
+                        "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                        (is_first_event) ? "" : ",",
+                        current_buffer_ptr->thread_id);
+
+                write_json_string(file_ptr,
+                                  current_buffer_ptr->thread_name_ptr);
+
+                fputs("}}",
+                      file_ptr);
+
+                is_first_event = false;
+            }
+
+            for (uint32_t n_zone = 0;
+                          n_zone < n_zones;
+                        ++n_zone)
+            {
+                const auto& current_zone = current_buffer_ptr->zone_vec[n_zone];
+
+                fprintf(file_ptr,
+                        "%s\n{\"name\":",
+                        (is_first_event) ? "" : ",");
+
+                write_json_string(file_ptr,
+                                  current_zone.name_ptr);
+
+                fprintf(file_ptr,
+                        ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                        current_buffer_ptr->thread_id,
+                        static_cast<double>(current_zone.start_ns)                       / 1000.0,
+                        static_cast<double>(current_zone.end_ns - current_zone.start_ns) / 1000.0);
+
+                if (current_zone.n_allocations > 0)
+                {
+                    fprintf(file_ptr,
+                            ",\"args\":{\"allocations\":%llu,\"allocated_bytes\":%llu}",
+                            static_cast<unsigned long long>(current_zone.n_allocations),
+                            static_cast<unsigned long long>(current_zone.n_allocated_bytes) );
+                }
+
+                fputs("}",
+                      file_ptr);
+
+                is_first_event = false;
+            }
+
+            n_dropped_zones += current_buffer_ptr->n_dropped_zones.load(std::memory_order_relaxed);
+        }
+    }
+
+    fputs("\n]}\n",
+          file_ptr);
+
+    if (n_dropped_zones > 0)
+    {
+        printf("%u trace zone(s) were dropped because per-thread buffers were full.\n",
+               n_dropped_zones);
+
+        fflush(stdout);
+    }
+
+    result = true;
+end:
+    if (file_ptr != nullptr)
+    {
+        ::fclose(file_ptr);
+    }
+
+    return result;
+}
\ No newline at end of file
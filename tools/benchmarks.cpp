@@ -0,0 +1,676 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "allocation_tracker.h"
+#include "command_buffer.h"
+#include "draw_batcher.h"
+#include "fake_gl.h"
+#include "file_io.h"
+#include "program.h"
+#include "render_queue.h"
+#include "sampler.h"
+#include "shader.h"
+#include "texture.h"
+#include <algorithm>
+#include <functional>
+#include <stdio.h>
+
+/* Measures CPU overhead of framework hot paths against the fake GL backend (see fake_gl.h), so that no GL context
+ * is needed. Results are written as JSON to the specified file, or to stdout.
+ *
+ * Usage: framework-benchmarks [output file]
+ *
+ * The output lists benchmarks in a fixed order with fixed precision, so that results of two runs can be diffed.
+ * Each benchmark reports:
+ *
+ * - ns_per_op:              median of N_SAMPLES samples, each of which runs for at least MIN_SAMPLE_TIME_MS.
+ * - allocations_per_op:     heap allocations made by the benchmark thread, averaged over all samples. null unless
+ *                           the framework is configured with FRAMEWORK_ENABLE_ALLOCATION_TRACKING.
+ * - allocated_bytes_per_op: as above, in bytes.
+ * - gl_calls_per_op:        calls made into the fake GL backend, averaged over all samples.
+ *
+ * New benchmarks are added by appending to the vector built in main().
+ */
+
+/* Type defs */
+typedef std::function<bool(const uint32_t& in_n_ops)> PFNBENCHMARKFUNC; /* Returns false if an op has failed. */
+
+struct Benchmark
+{
+    std::string      name;
+    PFNBENCHMARKFUNC func;
+};
+
+struct BenchmarkResult
+{
+    double allocated_bytes_per_op;
+    double allocations_per_op;
+    double gl_calls_per_op;
+    double ns_per_op;
+};
+
+/* Private variables */
+static const double   MIN_SAMPLE_TIME_MS     = 20.0;
+static const uint32_t N_SAMPLES              = 5;
+static const uint32_t N_UNIFORMS_PER_PROGRAM = 64;
+
+static const uint32_t N_COMMAND_BUFFER_CAPACITY_BYTES = 8 * 1024 * 1024;
+static const uint32_t N_MAX_QUEUED_DRAWS              = 100000;
+
+#if defined(FRAMEWORK_ALLOCATION_TRACKING)
+    static const bool IS_ALLOCATION_TRACKING_ENABLED = true;
+#else
+    static const bool IS_ALLOCATION_TRACKING_ENABLED = false;
+#endif
+
+static volatile int g_sink = 0; /* Keeps results of benchmarked code from being optimized away. */
+
+/* Deterministic pseudo-random numbers, so that all runs benchmark the same data. */
+static uint32_t get_next_random(uint32_t* inout_state_ptr)
+{
+    *inout_state_ptr = *inout_state_ptr * 1664525u + 1013904223u;
+
+    return *inout_state_ptr >> 8;
+}
+
+static uint64_t get_n_fake_gl_calls()
+{
+    const auto& call_counts = Framework::get_fake_gl_call_counts();
+    uint64_t    result      = 0;
+
+    for (const auto& current_count : call_counts)
+    {
+        result += current_count;
+    }
+
+    return result;
+}
+
+static bool time_ops(const Benchmark& in_benchmark,
+                     const uint32_t&  in_n_ops,
+                     double*          out_time_ms_ptr)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    const bool result     = in_benchmark.func(in_n_ops);
+
+    *out_time_ms_ptr = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+    return result;
+}
+
+static bool run_benchmark(const Benchmark& in_benchmark,
+                          BenchmarkResult* out_result_ptr)
+{
+    uint64_t            n_allocated_bytes_start = 0;
+    uint64_t            n_allocations_start     = 0;
+    uint64_t            n_gl_calls_start        = 0;
+    uint32_t            n_ops                   = 1;
+    bool                result                  = false;
+    double              time_ms                 = 0.0;
+    std::vector<double> sample_ns_per_op_vec;
+
+    /* Also serves as a warm-up. */
+    while (true)
+    {
+        if (!time_ops(in_benchmark,
+                      n_ops,
+                     &time_ms) )
+        {
+            goto end;
+        }
+
+        if (time_ms >= MIN_SAMPLE_TIME_MS ||
+            n_ops   >= (1u << 30) )
+        {
+            break;
+        }
+
+        n_ops *= 2;
+    }
+
+    n_allocated_bytes_start = Framework::get_thread_n_allocated_bytes();
+    n_allocations_start     = Framework::get_thread_n_allocations    ();
+    n_gl_calls_start        = get_n_fake_gl_calls                    ();
+
+    for (uint32_t n_sample = 0;
+                  n_sample < N_SAMPLES;
+                ++n_sample)
+    {
+        if (!time_ops(in_benchmark,
+                      n_ops,
+                     &time_ms) )
+        {
+            goto end;
+        }
+
+        sample_ns_per_op_vec.push_back(1e6 * time_ms / static_cast<double>(n_ops) );
+    }
+
+    std::sort(sample_ns_per_op_vec.begin(),
+              sample_ns_per_op_vec.end  () );
+
+    {
+        const double n_total_ops = static_cast<double>(n_ops) * static_cast<double>(N_SAMPLES);
+
+        out_result_ptr->allocated_bytes_per_op = static_cast<double>(Framework::get_thread_n_allocated_bytes() - n_allocated_bytes_start) / n_total_ops;
+        out_result_ptr->allocations_per_op     = static_cast<double>(Framework::get_thread_n_allocations    () - n_allocations_start)     / n_total_ops;
+        out_result_ptr->gl_calls_per_op        = static_cast<double>(get_n_fake_gl_calls                    () - n_gl_calls_start)        / n_total_ops;
+        out_result_ptr->ns_per_op              = sample_ns_per_op_vec.at(N_SAMPLES / 2);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+static bool write_test_file(const std::string& in_filename,
+                            const uint32_t&    in_n_bytes)
+{
+    FILE*                file_ptr = ::fopen(in_filename.c_str(),
+                                            "wb");
+    bool                 result   = false;
+    std::vector<uint8_t> data_u8_vec(in_n_bytes);
+
+    if (file_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    for (uint32_t n_byte = 0;
+                  n_byte < in_n_bytes;
+                ++n_byte)
+    {
+        data_u8_vec.at(n_byte) = static_cast<uint8_t>(n_byte * 31);
+    }
+
+    result = (in_n_bytes == 0) || (::fwrite(data_u8_vec.data(),
+                                            in_n_bytes,
+                                            1u,
+                                            file_ptr) == 1);
+
+    ::fclose(file_ptr);
+end:
+    return result;
+}
+
+int main(int    argc,
+         char** argv)
+{
+    std::vector<Benchmark>                         benchmark_vec;
+    Framework::CommandBufferUniquePtr              command_buffer_ptr;
+    Framework::DrawBatcherUniquePtr                draw_batcher_ptr;
+    Framework::FakeGLConfig                        fake_gl_config;
+    Framework::ShaderUniquePtr                     fs_ptr;
+    FILE*                                          output_file_ptr = stdout;
+    Framework::ProgramUniquePtr                    program_ptrs[2];
+    std::vector<Framework::CommandBufferUniquePtr> recorded_command_buffer_ptr_vec;
+    Framework::RenderQueueUniquePtr                render_queue_ptr;
+    int                                            result          = 1;
+    std::vector<std::string>                       test_filename_vec;
+    std::vector<std::string>                       uniform_name_vec;
+    Framework::ShaderUniquePtr                     vs_ptr;
+
+    if (argc > 2)
+    {
+        fprintf(stderr,
+                "Usage: %s [output file]\n",
+                argv[0]);
+
+        goto end;
+    }
+
+    fake_gl_config.n_active_uniforms_per_program = N_UNIFORMS_PER_PROGRAM;
+
+    Framework::install_fake_gl(fake_gl_config);
+
+    vs_ptr = Framework::Shader::create(Framework::ShaderStage::VERTEX,
+                                       "");
+    fs_ptr = Framework::Shader::create(Framework::ShaderStage::FRAGMENT,
+                                       "");
+
+    if (vs_ptr == nullptr ||
+        fs_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    for (auto& current_program_ptr : program_ptrs)
+    {
+        current_program_ptr = Framework::Program::create(vs_ptr.get(),
+                                                         fs_ptr.get() );
+
+        if (current_program_ptr == nullptr)
+        {
+            goto end;
+        }
+    }
+
+    for (uint32_t n_uniform = 0;
+                  n_uniform < N_UNIFORMS_PER_PROGRAM;
+                ++n_uniform)
+    {
+        uniform_name_vec.push_back("uniform" + std::to_string(n_uniform) );
+    }
+
+    draw_batcher_ptr = Framework::DrawBatcher::create(4,                /* in_instance_attribute_location       */
+                                                      4 * 1024 * 1024); /* in_max_instance_data_bytes_per_frame */
+
+    command_buffer_ptr = Framework::CommandBuffer::create(N_COMMAND_BUFFER_CAPACITY_BYTES);
+    render_queue_ptr   = Framework::RenderQueue::create  (N_MAX_QUEUED_DRAWS);
+
+    if (command_buffer_ptr == nullptr ||
+        draw_batcher_ptr   == nullptr ||
+        render_queue_ptr   == nullptr)
+    {
+        goto end;
+    }
+
+    /* Uniform location lookup */
+    benchmark_vec.push_back(
+        Benchmark{"program/get_uniform_location/" + std::to_string(N_UNIFORMS_PER_PROGRAM),
+                  [&](const uint32_t& in_n_ops)
+                  {
+                      for (uint32_t n_op = 0;
+                                    n_op < in_n_ops;
+                                  ++n_op)
+                      {
+                          g_sink += program_ptrs[0]->get_uniform_location(uniform_name_vec.at(n_op % N_UNIFORMS_PER_PROGRAM) );
+                      }
+
+                      return true;
+                  }});
+
+    /* Sampler creation */
+    benchmark_vec.push_back(
+        Benchmark{"sampler/create",
+                  [](const uint32_t& in_n_ops)
+                  {
+                      for (uint32_t n_op = 0;
+                                    n_op < in_n_ops;
+                                  ++n_op)
+                      {
+                          auto sampler_ptr = Framework::Sampler::create(Framework::WrapMode::REPEAT,
+                                                                        Framework::WrapMode::REPEAT,
+                                                                        Framework::WrapMode::REPEAT,
+                                                                        Framework::MinFilter::LINEAR_MIPMAP_LINEAR,
+                                                                        Framework::MagFilter::LINEAR,
+                                                                        -1000.0f, /* in_min_lod */
+                                                                        1000.0f); /* in_max_lod */
+
+                          g_sink += static_cast<int>(sampler_ptr->get_id() );
+                      }
+
+                      return true;
+                  }});
+
+    /* Texture creation, incl. mip chain computation */
+    for (const uint32_t current_extent : {64u, 4096u})
+    {
+        benchmark_vec.push_back(
+            Benchmark{"texture/create_immutable_2d/" + std::to_string(current_extent),
+                      [current_extent](const uint32_t& in_n_ops)
+                      {
+                          for (uint32_t n_op = 0;
+                                        n_op < in_n_ops;
+                                      ++n_op)
+                          {
+                              auto texture_ptr = Framework::Texture::create_immutable_2d(false, /* in_single_mip */
+                                                                                         Framework::TextureFormat::R8G8B8A8_UNORM,
+                                                                                         {current_extent, current_extent},
+                                                                                         1);    /* in_n_layers */
+
+                              g_sink += static_cast<int>(texture_ptr->get_n_bytes() );
+                          }
+
+                          return true;
+                      }});
+    }
+
+    /* File drop ingestion */
+    for (const uint32_t current_n_bytes : {4u * 1024u, 1024u * 1024u, 16u * 1024u * 1024u})
+    {
+        const std::string filename = "framework-benchmark-" + std::to_string(current_n_bytes) + ".bin";
+
+        if (!write_test_file(filename,
+                             current_n_bytes) )
+        {
+            fprintf(stderr,
+                    "Could not write [%s].\n",
+                    filename.c_str() );
+
+            goto end;
+        }
+
+        test_filename_vec.push_back(filename);
+
+        benchmark_vec.push_back(
+            Benchmark{"file_drop/read_file/" + std::to_string(current_n_bytes),
+                      [filename](const uint32_t& in_n_ops)
+                      {
+                          for (uint32_t n_op = 0;
+                                        n_op < in_n_ops;
+                                      ++n_op)
+                          {
+                              auto data_u8_vec_ptr = Framework::read_file(filename);
+
+                              if (data_u8_vec_ptr == nullptr)
+                              {
+                                  return false;
+                              }
+
+                              g_sink += static_cast<int>(data_u8_vec_ptr->size() );
+                          }
+
+                          return true;
+                      }});
+    }
+
+    /* Draw batching. Each op submits & flushes a frame's worth of draws which alternate between two programs. */
+    for (const uint32_t current_n_draws : {16u, 1024u})
+    {
+        benchmark_vec.push_back(
+            Benchmark{"draw_batcher/submit_flush/" + std::to_string(current_n_draws),
+                      [&, current_n_draws](const uint32_t& in_n_ops)
+                      {
+                          const float instance_data[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+
+                          for (uint32_t n_op = 0;
+                                        n_op < in_n_ops;
+                                      ++n_op)
+                          {
+                              for (uint32_t n_draw = 0;
+                                            n_draw < current_n_draws;
+                                          ++n_draw)
+                              {
+                                  Framework::BatchedDraw draw;
+
+                                  draw.n_indices   = 36;
+                                  draw.program_ptr = program_ptrs[n_draw % 2].get();
+                                  draw.vao_id      = 1;
+
+                                  draw_batcher_ptr->submit(draw,
+                                                           instance_data,
+                                                           sizeof(instance_data) );
+                              }
+
+                              draw_batcher_ptr->flush();
+                          }
+
+                          return true;
+                      }});
+    }
+
+    /* Render queue. Each op enqueues a frame's worth of draws with random keys, then either only sorts them or
+     * also executes them. std_sort/ ops copy the same keys and sort them with std::sort(), as a baseline for
+     * the radix sort. */
+    for (const uint32_t current_n_draws : {1024u, 16384u, N_MAX_QUEUED_DRAWS})
+    {
+        std::vector<Framework::QueuedDraw> draw_vec(current_n_draws);
+        uint32_t                           random_state = 1;
+
+        for (auto& current_draw : draw_vec)
+        {
+            const uint32_t n_program = get_next_random(&random_state) % 2;
+
+            current_draw.index_type  = GL_UNSIGNED_SHORT;
+            current_draw.n_elements  = 36;
+            current_draw.program_ptr = program_ptrs[n_program].get();
+            current_draw.sort_key    = Framework::RenderQueue::make_sort_key(static_cast<uint8_t>(get_next_random(&random_state) % 4),
+                                                                             n_program,
+                                                                             get_next_random(&random_state) % 64,
+                                                                             static_cast<float>(get_next_random(&random_state) % 65536) / 65535.0f);
+            current_draw.vao_id      = 1 + get_next_random(&random_state) % 8;
+        }
+
+        for (const bool should_execute : {false, true})
+        {
+            benchmark_vec.push_back(
+                Benchmark{std::string( (should_execute) ? "render_queue/enqueue_execute/" : "render_queue/enqueue_sort/") + std::to_string(current_n_draws),
+                          [&render_queue_ptr, draw_vec, should_execute](const uint32_t& in_n_ops)
+                          {
+                              for (uint32_t n_op = 0;
+                                            n_op < in_n_ops;
+                                          ++n_op)
+                              {
+                                  render_queue_ptr->clear();
+
+                                  for (const auto& current_draw : draw_vec)
+                                  {
+                                      render_queue_ptr->enqueue(current_draw);
+                                  }
+
+                                  if (should_execute)
+                                  {
+                                      render_queue_ptr->execute();
+                                  }
+                                  else
+                                  {
+                                      g_sink += static_cast<int>(render_queue_ptr->sort().at(0) );
+                                  }
+                              }
+
+                              return true;
+                          }});
+        }
+
+        {
+            std::vector<std::pair<uint64_t, uint32_t> > sort_item_vec;
+
+            sort_item_vec.reserve(current_n_draws);
+
+            benchmark_vec.push_back(
+                Benchmark{std::string("std_sort/") + std::to_string(current_n_draws),
+                          [draw_vec, sort_item_vec](const uint32_t& in_n_ops) mutable
+                          {
+                              for (uint32_t n_op = 0;
+                                            n_op < in_n_ops;
+                                          ++n_op)
+                              {
+                                  sort_item_vec.clear();
+
+                                  for (uint32_t n_draw = 0;
+                                                n_draw < static_cast<uint32_t>(draw_vec.size() );
+                                              ++n_draw)
+                                  {
+                                      sort_item_vec.emplace_back(draw_vec[n_draw].sort_key,
+                                                                 n_draw);
+                                  }
+
+                                  std::sort(sort_item_vec.begin(),
+                                            sort_item_vec.end  (),
+                                            [](const std::pair<uint64_t, uint32_t>& in_a,
+                                               const std::pair<uint64_t, uint32_t>& in_b)
+                                            {
+                                                return in_a.first < in_b.first;
+                                            });
+
+                                  g_sink += static_cast<int>(sort_item_vec.at(0).second);
+                              }
+
+                              return true;
+                          }});
+        }
+    }
+
+    /* Command buffers. Each draw binds a program & a VAO, sets a vec4 uniform and issues an indexed draw. Recording
+     * & playback are measured separately. */
+    for (const uint32_t current_n_draws : {1024u, 16384u})
+    {
+        const auto record_draws = [&program_ptrs, current_n_draws](Framework::CommandBuffer* in_command_buffer_ptr)
+        {
+            const float uniform_data[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+            bool        result          = true;
+
+            in_command_buffer_ptr->reset();
+
+            for (uint32_t n_draw = 0;
+                          n_draw < current_n_draws;
+                        ++n_draw)
+            {
+                result &= in_command_buffer_ptr->record_bind_program (program_ptrs[n_draw % 2]->get_id() );
+                result &= in_command_buffer_ptr->record_bind_vao     (1 + n_draw % 8);
+                result &= in_command_buffer_ptr->record_set_uniform  (0, /* in_location */
+                                                                      Framework::UniformType::FLOAT_VEC4,
+                                                                      1, /* in_n_elements */
+                                                                      uniform_data);
+                result &= in_command_buffer_ptr->record_draw_elements(GL_TRIANGLES,
+                                                                      GL_UNSIGNED_SHORT,
+                                                                      0,   /* in_first_index */
+                                                                      36); /* in_n_indices   */
+            }
+
+            return result;
+        };
+
+        benchmark_vec.push_back(
+            Benchmark{"command_buffer/record/" + std::to_string(current_n_draws),
+                      [&command_buffer_ptr, record_draws](const uint32_t& in_n_ops)
+                      {
+                          for (uint32_t n_op = 0;
+                                        n_op < in_n_ops;
+                                      ++n_op)
+                          {
+                              if (!record_draws(command_buffer_ptr.get() ))
+                              {
+                                  return false;
+                              }
+                          }
+
+                          return true;
+                      }});
+
+        {
+            auto recorded_command_buffer_ptr = Framework::CommandBuffer::create(N_COMMAND_BUFFER_CAPACITY_BYTES);
+
+            if (recorded_command_buffer_ptr == nullptr                  ||
+                !record_draws(recorded_command_buffer_ptr.get() ))
+            {
+                goto end;
+            }
+
+            recorded_command_buffer_ptr_vec.push_back(std::move(recorded_command_buffer_ptr) );
+        }
+
+        benchmark_vec.push_back(
+            Benchmark{"command_buffer/execute/" + std::to_string(current_n_draws),
+                      [recorded_command_buffer_raw_ptr = recorded_command_buffer_ptr_vec.back().get()](const uint32_t& in_n_ops)
+                      {
+                          for (uint32_t n_op = 0;
+                                        n_op < in_n_ops;
+                                      ++n_op)
+                          {
+                              recorded_command_buffer_raw_ptr->execute();
+                          }
+
+                          return true;
+                      }});
+    }
+
+    Framework::reset_fake_gl_calls();
+
+    if (argc == 2)
+    {
+        output_file_ptr = ::fopen(argv[1],
+                                  "w");
+
+        if (output_file_ptr == nullptr)
+        {
+            fprintf(stderr,
+                    "Could not open [%s] for writing.\n",
+                    argv[1]);
+
+            goto end;
+        }
+    }
+
+    fprintf(output_file_ptr,
+            "{\n"
+            "  \"allocation_tracking\": %s,\n"
+            "  \"benchmarks\": [\n",
+            (IS_ALLOCATION_TRACKING_ENABLED) ? "true" : "false");
+
+    for (uint32_t n_benchmark = 0;
+                  n_benchmark < static_cast<uint32_t>(benchmark_vec.size() );
+                ++n_benchmark)
+    {
+        const auto&     current_benchmark                 = benchmark_vec.at(n_benchmark);
+        BenchmarkResult benchmark_result                  = {};
+        char            allocated_bytes_per_op_string[32] = "null";
+        char            allocations_per_op_string    [32] = "null";
+
+        if (!run_benchmark(current_benchmark,
+                          &benchmark_result) )
+        {
+            fprintf(stderr,
+                    "Benchmark [%s] failed.\n",
+                    current_benchmark.name.c_str() );
+
+            goto end;
+        }
+
+        if (IS_ALLOCATION_TRACKING_ENABLED)
+        {
+            snprintf(allocated_bytes_per_op_string, sizeof(allocated_bytes_per_op_string), "%.3f", benchmark_result.allocated_bytes_per_op);
+            snprintf(allocations_per_op_string,     sizeof(allocations_per_op_string),     "%.3f", benchmark_result.allocations_per_op);
+        }
+
+        fprintf(output_file_ptr,
+                "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocations_per_op\": %s, \"allocated_bytes_per_op\": %s, \"gl_calls_per_op\": %.3f}%s\n",
+                current_benchmark.name.c_str(),
+                benchmark_result.ns_per_op,
+                allocations_per_op_string,
+                allocated_bytes_per_op_string,
+                benchmark_result.gl_calls_per_op,
+                (n_benchmark + 1 < static_cast<uint32_t>(benchmark_vec.size() )) ? "," : "");
+
+        fflush(output_file_ptr);
+    }
+
+    fprintf(output_file_ptr,
+            "  ]\n"
+            "}\n");
+
+    result = 0;
+end:
+    if (output_file_ptr != stdout &&
+        output_file_ptr != nullptr)
+    {
+        ::fclose(output_file_ptr);
+    }
+
+    for (const auto& current_filename : test_filename_vec)
+    {
+        ::remove(current_filename.c_str() );
+    }
+
+    Framework::drain_log();
+
+    if (Framework::has_reported_error() )
+    {
+        result = 1;
+    }
+
+    return result;
+}
\ No newline at end of file
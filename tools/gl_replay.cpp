@@ -0,0 +1,219 @@
+/*
+
+    MIT License
+
+    Copyright (c) 2024 Dominik Witczak
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+*/
+#include "gl_replayer.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <stdio.h>
+
+/* Replays a GL capture made with the --capture-gl command line argument in an invisible window, then reports
+ * per-frame & per-function timings.
+ *
+ * Usage: gl-replay <capture file>
+ */
+
+static void print_function_stats(const Framework::GLReplayer* in_replayer_ptr)
+{
+    const auto&           function_stats = in_replayer_ptr->get_function_stats();
+    std::vector<uint32_t> function_index_vec;
+
+    for (uint32_t n_function = 0;
+                  n_function < static_cast<uint32_t>(Framework::GLFunctionID::COUNT);
+                ++n_function)
+    {
+        if (function_stats[n_function].n_calls > 0)
+        {
+            function_index_vec.push_back(n_function);
+        }
+    }
+
+    std::sort(function_index_vec.begin(),
+              function_index_vec.end  (),
+              [&function_stats](const uint32_t& in_function1,
+                                const uint32_t& in_function2)
+              {
+                  return function_stats[in_function1].total_call_time_ms > function_stats[in_function2].total_call_time_ms;
+              });
+
+    printf("\n%-32s %10s %12s %10s %10s\n",
+           "Function",
+           "Calls",
+           "Total [ms]",
+           "Avg [us]",
+           "Max [us]");
+
+    for (const auto& current_function : function_index_vec)
+    {
+        const auto& current_stats = function_stats[current_function];
+
+        printf("%-32s %10u %12.3f %10.3f %10.3f\n",
+               Framework::get_gl_function_name(static_cast<Framework::GLFunctionID>(current_function) ),
+               current_stats.n_calls,
+               current_stats.total_call_time_ms,
+               1000.0 * current_stats.total_call_time_ms / static_cast<double>(current_stats.n_calls),
+               1000.0 * current_stats.max_call_time_ms);
+    }
+}
+
+int main(int    argc,
+         char** argv)
+{
+    double                         max_frame_time_ms   = 0.0;
+    double                         min_frame_time_ms   = 0.0;
+    uint32_t                       n_frames            = 0;
+    Framework::GLReplayerUniquePtr replayer_ptr;
+    int                            result              = 1;
+    double                         total_frame_time_ms = 0.0;
+    GLFWwindow*                    window_ptr          = nullptr;
+
+    if (argc != 2)
+    {
+        fprintf(stderr,
+                "Usage: %s <capture file>\n",
+                argv[0]);
+
+        goto end;
+    }
+
+    if (!glfwInit() )
+    {
+        fprintf(stderr,
+                "Could not initialize GLFW.\n");
+
+        goto end;
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+    glfwWindowHint(GLFW_CLIENT_API,            GLFW_OPENGL_ES_API);
+    glfwWindowHint(GLFW_VISIBLE,               GLFW_FALSE);
+
+    /* The window is resized once the capture's framebuffer size is known. */
+    window_ptr = glfwCreateWindow(1,
+                                  1,
+                                  "gl-replay",
+                                  nullptr,  /* monitor */
+                                  nullptr); /* share   */
+
+    if (window_ptr == nullptr)
+    {
+        fprintf(stderr,
+                "Could not create a GLES 3.0 context.\n");
+
+        goto end;
+    }
+
+    glfwMakeContextCurrent(window_ptr);
+    glfwSwapInterval      (0);
+
+    if (gladLoadGLES2Loader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress) ) == 0)
+    {
+        fprintf(stderr,
+                "Could not load GL entry-points.\n");
+
+        goto end;
+    }
+
+    replayer_ptr = Framework::GLReplayer::create(argv[1]);
+
+    if (replayer_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    glfwSetWindowSize(window_ptr,
+                      std::max(replayer_ptr->get_framebuffer_width (), 1),
+                      std::max(replayer_ptr->get_framebuffer_height(), 1) );
+
+    printf("%-8s %10s %14s %14s\n",
+           "Frame",
+           "Calls",
+           "GL calls [ms]",
+           "Finish [ms]");
+
+    while (true)
+    {
+        Framework::GLReplayFrameStats frame_stats;
+        const auto                    frame_start_time = std::chrono::steady_clock::now();
+        double                        frame_time_ms    = 0.0;
+
+        if (!replayer_ptr->replay_frame(&frame_stats) )
+        {
+            break;
+        }
+
+        /* Includes time taken by the GPU to execute the frame. */
+        glFinish();
+
+        frame_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame_start_time).count();
+
+        printf("%-8u %10u %14.3f %14.3f\n",
+               n_frames,
+               frame_stats.n_calls,
+               frame_stats.call_time_ms,
+               frame_time_ms);
+
+        max_frame_time_ms    = (n_frames == 0) ? frame_time_ms : std::max(max_frame_time_ms, frame_time_ms);
+        min_frame_time_ms    = (n_frames == 0) ? frame_time_ms : std::min(min_frame_time_ms, frame_time_ms);
+        total_frame_time_ms += frame_time_ms;
+
+        ++n_frames;
+
+        glfwSwapBuffers(window_ptr);
+    }
+
+    if (n_frames > 0)
+    {
+        printf("\nReplayed %u frame(s): avg %.3f ms, min %.3f ms, max %.3f ms.\n",
+               n_frames,
+               total_frame_time_ms / static_cast<double>(n_frames),
+               min_frame_time_ms,
+               max_frame_time_ms);
+    }
+
+    print_function_stats(replayer_ptr.get() );
+
+    if (replayer_ptr->get_n_unknown_object_names() > 0)
+    {
+        printf("\nWARNING: %u object name(s) were used without having been created in the capture. Results may be inaccurate.\n",
+               replayer_ptr->get_n_unknown_object_names() );
+    }
+
+    result = 0;
+end:
+    replayer_ptr.reset();
+
+    if (window_ptr != nullptr)
+    {
+        glfwDestroyWindow(window_ptr);
+    }
+
+    glfwTerminate();
+
+    /* Echoes errors reported by the replayer to stderr. */
+    Framework::drain_log();
+
+    return result;
+}
\ No newline at end of file